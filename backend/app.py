@@ -3,16 +3,19 @@ Pluto Lander Backend - FastAPI Service
 Trading bot control center with Alpaca integration
 Serves both API and static dashboard
 """
-from fastapi import FastAPI, Depends, WebSocket, WebSocketDisconnect, HTTPException, status
+from fastapi import FastAPI, Depends, WebSocket, WebSocketDisconnect, HTTPException, Request, status
 from fastapi.middleware.cors import CORSMiddleware
 from fastapi.security import OAuth2PasswordRequestForm
 from fastapi.staticfiles import StaticFiles
-from fastapi.responses import FileResponse
-from typing import List, Optional
+from fastapi.responses import FileResponse, JSONResponse, Response
+from typing import Dict, List, Optional, Set
 from pydantic import BaseModel
 from pathlib import Path
 import asyncio
+import secrets
+import time
 import httpx
+import msgpack
 
 from .auth import get_current_user, create_access_token, authenticate_user
 from .models import UserPublic, SettingsUpdate, SettingsPublic, TradeSignal, TelemetryMessage
@@ -33,6 +36,21 @@ app.add_middleware(
 )
 
 telemetry_clients: List[WebSocket] = []
+# Clients that connected with ?format=msgpack receive binary frames
+msgpack_clients: Set[WebSocket] = set()
+
+# Latest ESP32 telemetry, shared by the broadcast task and the polling endpoint
+ESP32_TELEMETRY_INTERVAL = 5.0
+latest_telemetry: Optional[TelemetryMessage] = None
+latest_telemetry_time = 0.0
+
+# Recent telemetry payloads by version, so polling clients can get a delta.
+# Versions are "<epoch>:<n>" with a new epoch on every start, so a client holding
+# a version from before a restart gets a full snapshot instead of a wrong delta.
+TELEMETRY_HISTORY = 8
+TELEMETRY_EPOCH = secrets.token_hex(4)
+telemetry_version = 0
+telemetry_history: Dict[int, dict] = {}
 
 # Path to built dashboard and branding
 DASHBOARD_DIR = Path(__file__).parent.parent / "dashboard" / "dist"
@@ -202,16 +220,58 @@ async def trade_signal(signal: TradeSignal, current_user=Depends(get_current_use
 
 
 # ============== WEBSOCKET TELEMETRY ==============
+def pack_telemetry(msg: TelemetryMessage) -> bytes:
+    """Encode a telemetry message as MsgPack for the ESP32.
+
+    Unset fields are dropped and floats are sent as float32 (the display
+    stores floats anyway), so the sparkline becomes a homogeneous float32
+    array that ArduinoJson reads straight into a packed array.
+    """
+    return msgpack.packb(telemetry_payload(msg), use_single_float=True)
+
+
+def telemetry_payload(msg: TelemetryMessage) -> dict:
+    """Fields of a telemetry message that are sent to the ESP32"""
+    return msg.model_dump(exclude_none=True, exclude_defaults=True)
+
+
+def merge_diff(old: dict, new: dict) -> dict:
+    """Build the JSON Merge Patch (RFC 7396) that turns old into new.
+
+    Removed members become null; arrays and other values are replaced whole.
+    """
+    patch = {}
+    for key in old:
+        if key not in new:
+            patch[key] = None
+    for key, value in new.items():
+        before = old.get(key)
+        if isinstance(value, dict) and isinstance(before, dict):
+            nested = merge_diff(before, value)
+            if nested:
+                patch[key] = nested
+        elif key not in old or before != value:
+            patch[key] = value
+    return patch
+
+
 async def broadcast_telemetry(msg: TelemetryMessage):
     """Broadcast message to all connected WebSocket clients"""
+    # Encode once per format, not once per client
+    as_json = msg.dict()
+    as_msgpack = pack_telemetry(msg) if msgpack_clients else None
     dead = []
     for ws in telemetry_clients:
         try:
-            await ws.send_json(msg.dict())
+            if ws in msgpack_clients:
+                await ws.send_bytes(as_msgpack)
+            else:
+                await ws.send_json(as_json)
         except Exception:
             dead.append(ws)
     for ws in dead:
         telemetry_clients.remove(ws)
+        msgpack_clients.discard(ws)
 
 
 @app.websocket("/ws/telemetry")
@@ -219,6 +279,8 @@ async def telemetry_ws(ws: WebSocket):
     """WebSocket endpoint for real-time telemetry (ESP32 and other clients)"""
     await ws.accept()
     telemetry_clients.append(ws)
+    if ws.query_params.get("format") == "msgpack":
+        msgpack_clients.add(ws)
     print(f"[Pluto] 📡 WebSocket client connected. Total: {len(telemetry_clients)}")
     try:
         while True:
@@ -230,55 +292,128 @@ async def telemetry_ws(ws: WebSocket):
     except WebSocketDisconnect:
         if ws in telemetry_clients:
             telemetry_clients.remove(ws)
+        msgpack_clients.discard(ws)
         print(f"[Pluto] 📡 WebSocket client disconnected. Total: {len(telemetry_clients)}")
 
 
+async def build_esp32_telemetry() -> TelemetryMessage:
+    """Collect the values shown on the ESP32 display"""
+    # Fetch BTC price
+    try:
+        btc_resp = await httpx.AsyncClient().get("https://api.coinbase.com/v2/prices/BTC-USD/spot", timeout=5.0)
+        btc_data = btc_resp.json()
+        btc_price = float(btc_data["data"]["amount"])
+    except:
+        btc_price = 0.0
+    
+    # Get account data if available
+    try:
+        account = await alpaca_client.get_account()
+        profit_usd = float(account.get("portfolio_value", 0)) - 100000  # Mock profit
+        profit_today = float(account.get("daytrading_buying_power", 0)) * 0.01  # Mock today
+    except:
+        profit_usd = 0.0
+        profit_today = 0.0
+    
+    # Mock sparkline (last 20 prices)
+    sparkline = [btc_price + (i * 10 - 100) for i in range(20)]
+    
+    # Determine mode
+    mode = "standby"
+    if alpaca_client.is_connected():
+        mode = "live"
+    
+    telemetry_msg = {
+        "type": "telemetry",
+        "btc_price": btc_price,
+        "btc_change_24h": 2.5,  # Mock for now
+        "profit_usd": profit_usd,
+        "profit_today": profit_today,
+        "mode": mode,
+        "sparkline": sparkline
+    }
+    return TelemetryMessage(**telemetry_msg)
+
+
+async def get_esp32_telemetry() -> TelemetryMessage:
+    """Return the latest ESP32 telemetry, refreshing it when stale"""
+    global latest_telemetry, latest_telemetry_time
+    now = time.monotonic()
+    if latest_telemetry is None or now - latest_telemetry_time >= ESP32_TELEMETRY_INTERVAL:
+        latest_telemetry = await build_esp32_telemetry()
+        latest_telemetry_time = now
+        record_telemetry(latest_telemetry)
+    return latest_telemetry
+
+
+def record_telemetry(msg: TelemetryMessage):
+    """Give the payload a new version if it changed, keeping the last few"""
+    global telemetry_version
+    payload = telemetry_payload(msg)
+    if telemetry_history.get(telemetry_version) == payload:
+        return
+    telemetry_version += 1
+    telemetry_history[telemetry_version] = payload
+    telemetry_history.pop(telemetry_version - TELEMETRY_HISTORY, None)
+
+
+def telemetry_version_tag(version: int) -> str:
+    return f"{TELEMETRY_EPOCH}:{version}"
+
+
+def parse_since(since: Optional[str]) -> Optional[int]:
+    """The version number in ?since=, or None if it is from another epoch"""
+    epoch, _, version = (since or "").partition(":")
+    if epoch != TELEMETRY_EPOCH or not version.isdigit():
+        return None
+    return int(version)
+
+
 async def broadcast_esp32_telemetry():
     """Periodically broadcast telemetry data for ESP32 display"""
-    import asyncio
     while True:
         try:
             if telemetry_clients:
-                # Fetch BTC price
-                try:
-                    btc_resp = await httpx.AsyncClient().get("https://api.coinbase.com/v2/prices/BTC-USD/spot", timeout=5.0)
-                    btc_data = btc_resp.json()
-                    btc_price = float(btc_data["data"]["amount"])
-                except:
-                    btc_price = 0.0
-                
-                # Get account data if available
-                try:
-                    account = await alpaca_client.get_account()
-                    profit_usd = float(account.get("portfolio_value", 0)) - 100000  # Mock profit
-                    profit_today = float(account.get("daytrading_buying_power", 0)) * 0.01  # Mock today
-                except:
-                    profit_usd = 0.0
-                    profit_today = 0.0
-                
-                # Mock sparkline (last 20 prices)
-                sparkline = [btc_price + (i * 10 - 100) for i in range(20)]
-                
-                # Determine mode
-                mode = "standby"
-                if alpaca_client.is_connected():
-                    mode = "live"
-                
-                telemetry_msg = {
-                    "type": "telemetry",
-                    "btc_price": btc_price,
-                    "btc_change_24h": 2.5,  # Mock for now
-                    "profit_usd": profit_usd,
-                    "profit_today": profit_today,
-                    "mode": mode,
-                    "sparkline": sparkline
-                }
-                
-                await broadcast_telemetry(TelemetryMessage(**telemetry_msg))
+                await broadcast_telemetry(await get_esp32_telemetry())
         except Exception as e:
             print(f"[Pluto] Error broadcasting ESP32 telemetry: {e}")
         
-        await asyncio.sleep(5)  # Update every 5 seconds
+        await asyncio.sleep(ESP32_TELEMETRY_INTERVAL)
+
+
+@app.get("/api/telemetry/latest")
+async def telemetry_latest(request: Request):
+    """Latest ESP32 telemetry, for clients that poll instead of holding a WebSocket.
+
+    Send "Accept: application/msgpack" to get MsgPack instead of JSON.
+
+    Pass ?since=<version> (from the X-Telemetry-Version header of the previous
+    response) to get a JSON Merge Patch (RFC 7396) against that version; the
+    response then has "X-Telemetry-Patch: 1", or is a 304 if nothing changed.
+    Without it, or if the version is too old or from before a restart, the full
+    snapshot is returned.
+    """
+    msg = await get_esp32_telemetry()
+    as_msgpack = "application/msgpack" in request.headers.get("accept", "")
+    headers = {"X-Telemetry-Version": telemetry_version_tag(telemetry_version)}
+
+    since = parse_since(request.query_params.get("since"))
+    base = telemetry_history.get(since) if since is not None else None
+    if base is not None:
+        if since == telemetry_version:
+            return Response(status_code=304, headers=headers)
+        headers["X-Telemetry-Patch"] = "1"
+        patch = merge_diff(base, telemetry_history[telemetry_version])
+        if as_msgpack:
+            return Response(content=msgpack.packb(patch, use_single_float=True),
+                            media_type="application/msgpack", headers=headers)
+        return JSONResponse(content=patch, media_type="application/merge-patch+json",
+                            headers=headers)
+
+    if as_msgpack:
+        return Response(content=pack_telemetry(msg), media_type="application/msgpack",
+                        headers=headers)
+    return JSONResponse(content=msg.dict(), headers=headers)
 
 
 # ============== HEALTH CHECK ==============
@@ -61,6 +61,9 @@ class TradeSignal(BaseModel):
 
 class TelemetryMessage(BaseModel):
     """WebSocket telemetry message"""
+    # ESP32 telemetry carries its own fields (btc_price, sparkline...)
+    model_config = {"extra": "allow"}
+
     type: str
     symbol: Optional[str] = None
     side: Optional[str] = None
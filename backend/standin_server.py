@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+Stand-in telemetry server for working on the ESP32 display without Alpaca or
+internet access. It runs the real backend app with made-up market data, so the
+display gets the same JSON / MsgPack frames, versions and patches.
+
+Run from the repository root:
+
+    python -m backend.standin_server [--port 8000] [--interval 5]
+"""
+import argparse
+import json
+import math
+import random
+
+import uvicorn
+
+from . import app as backend
+from .models import TelemetryMessage
+
+
+class FakeMarket:
+    """A BTC price that wanders a little on every update"""
+
+    def __init__(self, seed: int = 1):
+        self.rng = random.Random(seed)
+        self.price = 64000.0
+        self.history = [self.price] * 20
+        self.profit = 1250.0
+
+    def step(self) -> TelemetryMessage:
+        self.price = round(self.price * (1 + self.rng.gauss(0, 0.002)), 2)
+        self.history = self.history[1:] + [self.price]
+        self.profit = round(self.profit + self.rng.gauss(0, 15), 2)
+        return TelemetryMessage(
+            type="telemetry",
+            btc_price=self.price,
+            btc_change_24h=round((self.price / 64000.0 - 1) * 100, 2),
+            profit_usd=self.profit,
+            profit_today=round(math.fmod(self.profit, 100), 2),
+            mode="standby",
+            sparkline=self.history,
+        )
+
+
+def frame_sizes(msg: TelemetryMessage) -> str:
+    as_json = len(json.dumps(msg.model_dump(), separators=(",", ":")))
+    as_msgpack = len(backend.pack_telemetry(msg))
+    return f"JSON {as_json} B, MsgPack {as_msgpack} B"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--interval", type=float, default=backend.ESP32_TELEMETRY_INTERVAL,
+                        help="seconds between price updates")
+    args = parser.parse_args()
+
+    market = FakeMarket()
+
+    async def fake_telemetry() -> TelemetryMessage:
+        return market.step()
+
+    # get_esp32_telemetry() looks this up on every refresh
+    backend.build_esp32_telemetry = fake_telemetry
+    backend.ESP32_TELEMETRY_INTERVAL = args.interval
+
+    print(f"[Pluto] 🧪 Stand-in telemetry, one frame is {frame_sizes(FakeMarket().step())}")
+    uvicorn.run(backend.app, host=args.host, port=args.port, log_level="info")
+
+
+if __name__ == "__main__":
+    main()
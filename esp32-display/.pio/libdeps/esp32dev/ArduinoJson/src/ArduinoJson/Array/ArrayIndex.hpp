@@ -0,0 +1,107 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+class CollectionData;
+
+// Remembers the slot ids of the elements of the last arrays passed to
+// ArrayData::buildIndex(), so that getElement() doesn't walk the list every
+// time. Appending keeps an entry valid, although the new elements are not in
+// it; removing an element or clearing the array drops it.
+class ArrayIndex {
+ public:
+  struct Entry {
+    const CollectionData* array;
+    SlotId head;
+    SlotCount size;
+    SlotCount capacity;
+    SlotId* ids;
+  };
+
+  ArrayIndex() : next_(0) {
+    for (auto& entry : entries_)
+      entry = Entry{nullptr, NULL_SLOT, 0, 0, nullptr};
+  }
+
+  // Returns the entry of the array, or null if it's not indexed.
+  const Entry* find(const CollectionData* array, SlotId head) const {
+    for (auto& entry : entries_) {
+      if (entry.array == array && entry.head == head)
+        return &entry;
+    }
+    return nullptr;
+  }
+
+  // Returns an empty entry for the array, recycling the oldest one if needed.
+  Entry& create(const CollectionData* array, SlotId head) {
+    for (auto& entry : entries_) {
+      if (entry.array == array && entry.head == head) {
+        entry.size = 0;
+        return entry;
+      }
+    }
+    Entry& entry = entries_[next_];
+    next_ = uint8_t((next_ + 1) % ARDUINOJSON_ARRAY_INDEX_COUNT);
+    entry.array = array;
+    entry.head = head;
+    entry.size = 0;
+    return entry;
+  }
+
+  // Adds the id of the next element; returns false if out of memory.
+  static bool append(Entry& entry, SlotId id, Allocator* allocator) {
+    if (entry.size == entry.capacity) {
+      SlotCount capacity = SlotCount(entry.capacity ? entry.capacity * 2 : 8);
+      if (capacity <= entry.capacity)
+        return false;  // SlotCount overflow
+      auto ids = reinterpret_cast<SlotId*>(
+          allocator->reallocate(entry.ids, capacity * sizeof(SlotId)));
+      if (!ids)
+        return false;
+      entry.ids = ids;
+      entry.capacity = capacity;
+    }
+    entry.ids[entry.size++] = id;
+    return true;
+  }
+
+  void invalidate(const CollectionData* array) {
+    for (auto& entry : entries_) {
+      if (entry.array == array)
+        entry.array = nullptr;
+    }
+  }
+
+  // Returns the number of bytes allocated for the ids
+  size_t size() const {
+    size_t total = 0;
+    for (auto& entry : entries_)
+      total += entry.capacity * sizeof(SlotId);
+    return total;
+  }
+
+  void clear(Allocator* allocator) {
+    for (auto& entry : entries_) {
+      if (entry.ids)
+        allocator->deallocate(entry.ids);
+      entry = Entry{nullptr, NULL_SLOT, 0, 0, nullptr};
+    }
+  }
+
+ private:
+  Entry entries_[ARDUINOJSON_ARRAY_INDEX_COUNT];
+  uint8_t next_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+#endif
@@ -60,6 +60,12 @@ class ElementProxy : public VariantRefBase<ElementProxy<TUpstream>>,
         VariantAttorney::getResourceManager(upstream_));
   }
 
+  // Reads through the array, which may be packed and have no slot to point to
+  FORCE_INLINE JsonVariantConst readVariantConst() const {
+    return JsonVariantConst(VariantAttorney::getData(upstream_),
+                            getResourceManager())[index_];
+  }
+
   VariantData* getOrCreateData() const {
     auto data = VariantAttorney::getOrCreateData(upstream_);
     if (!data)
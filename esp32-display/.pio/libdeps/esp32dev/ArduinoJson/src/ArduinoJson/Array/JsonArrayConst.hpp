@@ -24,6 +24,10 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
   // Returns an iterator to the first element of the array.
   // https://arduinojson.org/v7/api/jsonarrayconst/begin/
   iterator begin() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return iterator(packed_->asPackedArray(), 0, resources_);
+#endif
     if (!data_)
       return iterator();
     return iterator(data_->createIterator(resources_), resources_);
@@ -43,11 +47,25 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
                  const detail::ResourceManager* resources)
       : data_(data), resources_(resources) {}
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // INTERNAL USE ONLY
+  // Reads the elements where they are, without unpacking the array
+  JsonArrayConst(const detail::VariantData* packed,
+                 const detail::ResourceManager* resources)
+      : data_(nullptr), resources_(resources), packed_(packed) {
+    ARDUINOJSON_ASSERT(packed->isPackedArray());
+  }
+#endif
+
   // Returns the element at the specified index.
   // https://arduinojson.org/v7/api/jsonarrayconst/subscript/
   template <typename T,
             detail::enable_if_t<detail::is_integral<T>::value, int> = 0>
   JsonVariantConst operator[](T index) const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return JsonVariantConst(packed_, resources_)[index];
+#endif
     return JsonVariantConst(
         detail::ArrayData::getElement(data_, size_t(index), resources_),
         resources_);
@@ -71,13 +89,13 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
   // Returns true if the reference is unbound.
   // https://arduinojson.org/v7/api/jsonarrayconst/isnull/
   bool isNull() const {
-    return data_ == 0;
+    return getData() == 0;
   }
 
   // Returns true if the reference is bound.
   // https://arduinojson.org/v7/api/jsonarrayconst/isnull/
   operator bool() const {
-    return data_ != 0;
+    return getData() != 0;
   }
 
   // Returns the depth (nesting level) of the array.
@@ -89,6 +107,10 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
   // Returns the number of elements in the array.
   // https://arduinojson.org/v7/api/jsonarrayconst/size/
   size_t size() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return packed_->size(resources_);
+#endif
     return data_ ? data_->size(resources_) : 0;
   }
 
@@ -100,11 +122,18 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
 
  private:
   const detail::VariantData* getData() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return packed_;
+#endif
     return collectionToVariant(data_);
   }
 
   const detail::ArrayData* data_;
   const detail::ResourceManager* resources_;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  const detail::VariantData* packed_ = nullptr;
+#endif
 };
 
 // Compares the content of two arrays.
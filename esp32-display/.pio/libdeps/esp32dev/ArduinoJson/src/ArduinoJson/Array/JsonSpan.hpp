@@ -0,0 +1,116 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Variant/Converter.hpp>
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename T>
+struct PackedArrayTypeOf;
+
+template <>
+struct PackedArrayTypeOf<int32_t> {
+  static const PackedArrayType value = PackedArrayType::Int32;
+};
+
+template <>
+struct PackedArrayTypeOf<float> {
+  static const PackedArrayType value = PackedArrayType::Float;
+};
+
+#  if ARDUINOJSON_USE_DOUBLE
+template <>
+struct PackedArrayTypeOf<double> {
+  static const PackedArrayType value = PackedArrayType::Double;
+};
+#  endif
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A read-only view of a packed array of int32_t, float, or double.
+// variant.as<JsonSpan<float>>() returns an empty span if the variant isn't a
+// packed array of this type; assigning a span stores a packed array.
+template <typename T>
+class JsonSpan {
+ public:
+  JsonSpan() : data_(nullptr), size_(0) {}
+  JsonSpan(const T* data, size_t size) : data_(data), size_(size) {}
+
+  const T* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool isNull() const {
+    return data_ == nullptr;
+  }
+
+  const T* begin() const {
+    return data_;
+  }
+
+  const T* end() const {
+    return data_ + size_;
+  }
+
+  T operator[](size_t index) const {
+    return index < size_ ? data_[index] : T();
+  }
+
+ private:
+  const T* data_;
+  size_t size_;
+};
+
+template <typename T>
+struct Converter<JsonSpan<T>> : private detail::VariantAttorney {
+  static void toJson(JsonSpan<T> src, JsonVariant dst) {
+    auto data = getData(dst);
+    if (!data)
+      return;
+    auto resources = getResourceManager(dst);
+    data->clear(resources);
+    if (src.isNull())
+      return;
+
+    // reserve room to align the elements
+    size_t length = src.size() * sizeof(T);
+    auto node = resources->createString(length + sizeof(T) - 1);
+    if (!node)
+      return;
+    size_t padding = detail::packedArrayPadding(node->data, sizeof(T));
+    memcpy(node->data + padding, src.data(), length);
+    // the node keeps its full length, see PackedArrayBuilder::save()
+    node->data[node->length] = 0;
+    resources->saveString(node);
+    data->setPackedArray(detail::PackedArrayTypeOf<T>::value, node);
+  }
+
+  static JsonSpan<T> fromJson(JsonVariantConst src) {
+    auto data = getData(src);
+    if (!data || !data->isPackedArray())
+      return {};
+    auto array = data->asPackedArray();
+    if (array.type() != detail::PackedArrayTypeOf<T>::value)
+      return {};
+    return JsonSpan<T>(reinterpret_cast<const T*>(array.data()), array.size());
+  }
+
+  static bool checkJson(JsonVariantConst src) {
+    return !fromJson(src).isNull();
+  }
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+#endif
@@ -35,6 +35,19 @@ struct Reader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>> {
       buffer[i] = *ptr_++;
     return length;
   }
+
+  const char* position() const {
+    return ptr_;
+  }
+
+  // The size is unknown, but the input is supposed to be complete
+  size_t available() const {
+    return size_t(-1);
+  }
+
+  void skip(size_t n) {
+    ptr_ += n;
+  }
 };
 
 template <typename TSource>
@@ -44,6 +57,18 @@ struct BoundedReader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>>
   explicit BoundedReader(const void* ptr, size_t len)
       : IteratorReader<const char*>(reinterpret_cast<const char*>(ptr),
                                     reinterpret_cast<const char*>(ptr) + len) {}
+
+  const char* position() const {
+    return ptr_;
+  }
+
+  size_t available() const {
+    return size_t(end_ - ptr_);
+  }
+
+  void skip(size_t n) {
+    ptr_ += n;
+  }
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -59,9 +59,10 @@ template <
     template <typename> class TDeserializer, typename TDestination,
     typename TStream, typename... Args,
     enable_if_t<  // issue #1897
-        !is_integral<typename first_or_void<Args...>::type>::value, int> = 0>
+        !is_integral<decay_t<typename first_or_void<Args...>::type>>::value,
+        int> = 0>
 DeserializationError deserialize(TDestination&& dst, TStream&& input,
-                                 Args... args) {
+                                 Args&&... args) {
   return doDeserialize<TDeserializer>(
       dst, makeReader(detail::forward<TStream>(input)),
       makeDeserializationOptions(args...));
@@ -71,7 +72,7 @@ template <template <typename> class TDeserializer, typename TDestination,
           typename TChar, typename Size, typename... Args,
           enable_if_t<is_integral<Size>::value, int> = 0>
 DeserializationError deserialize(TDestination&& dst, TChar* input,
-                                 Size inputSize, Args... args) {
+                                 Size inputSize, Args&&... args) {
   return doDeserialize<TDeserializer>(dst, makeReader(input, size_t(inputSize)),
                                       makeDeserializationOptions(args...));
 }
@@ -24,8 +24,17 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   explicit JsonDocument(Allocator* alloc = detail::DefaultAllocator::instance())
       : resources_(alloc) {}
 
+  explicit JsonDocument(
+      PoolPolicy policy,
+      Allocator* alloc = detail::DefaultAllocator::instance())
+      : resources_(alloc) {
+    resources_.setPoolPolicy(policy);
+  }
+
   // Copy-constructor
   JsonDocument(const JsonDocument& src) : JsonDocument(src.allocator()) {
+    resources_.setPoolPolicy(src.poolPolicy());
+    serializedSizeHint_ = src.serializedSizeHint_;
     set(src);
   }
 
@@ -64,6 +73,31 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     return resources_.allocator();
   }
 
+  // Changes the size of the next variant pools.
+  void setPoolPolicy(PoolPolicy policy) {
+    resources_.setPoolPolicy(policy);
+  }
+
+  PoolPolicy poolPolicy() const {
+    return resources_.poolPolicy();
+  }
+
+  // Returns the memory allocated by the document, by category.
+  MemoryReport memoryReport() const {
+    return resources_.memoryReport();
+  }
+
+  // Returns the size of the last serialization into a JsonOutputBuffer.
+  size_t serializedSizeHint() const {
+    return serializedSizeHint_;
+  }
+
+  // Sets the expected size of the next serialization into a JsonOutputBuffer,
+  // so the buffer gets the right size from the start.
+  void setSerializedSizeHint(size_t size) {
+    serializedSizeHint_ = size;
+  }
+
   // Reduces the capacity of the memory pool to match the current usage.
   // https://arduinojson.org/v7/api/jsondocument/shrinktofit/
   void shrinkToFit() {
@@ -237,7 +271,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   // Gets a root array's member.
   // https://arduinojson.org/v7/api/jsondocument/subscript/
   JsonVariantConst operator[](size_t index) const {
-    return JsonVariantConst(data_.getElement(index, &resources_), &resources_);
+    return getVariant()[index];
   }
 
   // Gets or sets a root object's member.
@@ -336,6 +370,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   friend void swap(JsonDocument& a, JsonDocument& b) {
     swap(a.resources_, b.resources_);
     swap_(a.data_, b.data_);
+    detail::swap_(a.serializedSizeHint_, b.serializedSizeHint_);
   }
 
   // DEPRECATED: use add<JsonVariant>() instead
@@ -417,6 +452,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
 
   detail::ResourceManager resources_;
   detail::VariantData data_;
+  size_t serializedSizeHint_ = 0;
 };
 
 inline void convertToJson(const JsonDocument& src, JsonVariant dst) {
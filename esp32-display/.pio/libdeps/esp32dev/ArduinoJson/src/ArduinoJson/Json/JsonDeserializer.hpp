@@ -4,11 +4,17 @@
 
 #pragma once
 
+#include <ArduinoJson/Array/PackedArrayBuilder.hpp>
+#include <ArduinoJson/Deserialization/Schema.hpp>
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonChars.hpp>
+#include <ArduinoJson/Json/JsonHandler.hpp>
 #include <ArduinoJson/Json/Latch.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/FixedStringBuilder.hpp>
+#include <ArduinoJson/Memory/InSituStringBuilder.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
@@ -25,7 +31,9 @@ class JsonDeserializer {
       : stringBuilder_(resources),
         foundSomething_(false),
         latch_(reader),
-        resources_(resources) {}
+        resources_(resources) {
+    bindStringBuilder(stringBuilder_, reader);
+  }
 
   template <typename TFilter>
   DeserializationError parse(VariantData& variant, TFilter filter,
@@ -42,6 +50,39 @@ class JsonDeserializer {
     return err;
   }
 
+  // Fills the struct at dst; doesn't allocate anything, so resources can be
+  // null.
+  template <typename T>
+  DeserializationError parse(T& dst, const JsonSchema<T>& schema,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (current() != '{')
+      return DeserializationError::InvalidInput;
+
+    return parseSchemaObject(&dst, schema.begin(), schema.end(), nestingLimit);
+  }
+
+  // Calls the handler for each token instead of building a tree; doesn't
+  // allocate anything, so resources can be null.
+  template <typename THandler>
+  DeserializationError parseEvents(
+      THandler& handler, char* stringBuffer, size_t stringCapacity,
+      DeserializationOption::NestingLimit nestingLimit) {
+    HandlerSink<THandler> sink(handler, stringBuffer, stringCapacity);
+
+    auto err = parseEventVariant(sink, nestingLimit);
+
+    if (sink.stopped())
+      return DeserializationError::Ok;
+
+    return err;
+  }
+
  private:
   char current() {
     return latch_.current();
@@ -168,6 +209,15 @@ class JsonDeserializer {
 
     TFilter elementFilter = filter[0UL];
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (elementFilter.allowValue()) {
+      bool done = false;
+      err = parsePackedArray(array, done);
+      if (err || done)
+        return err;
+    }
+#endif
+
     // Read each value
     for (;;) {
       if (elementFilter.allow()) {
@@ -372,10 +422,15 @@ class JsonDeserializer {
 
   DeserializationError::Code parseKey() {
     stringBuilder_.startString();
+    return parseKey(stringBuilder_);
+  }
+
+  template <typename TStringBuilder>
+  DeserializationError::Code parseKey(TStringBuilder& builder) {
     if (isQuote(current())) {
-      return parseQuotedString();
+      return parseQuotedString(builder);
     } else {
-      return parseNonQuotedString();
+      return parseNonQuotedString(builder);
     }
   }
 
@@ -384,7 +439,7 @@ class JsonDeserializer {
 
     stringBuilder_.startString();
 
-    err = parseQuotedString();
+    err = parseQuotedString(stringBuilder_);
     if (err)
       return err;
 
@@ -393,7 +448,8 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code parseQuotedString() {
+  template <typename TStringBuilder>
+  DeserializationError::Code parseQuotedString(TStringBuilder& builder) {
 #if ARDUINOJSON_DECODE_UNICODE
     Utf16::Codepoint codepoint;
     DeserializationError::Code err;
@@ -424,9 +480,9 @@ class JsonDeserializer {
           if (err)
             return err;
           if (codepoint.append(codeunit))
-            Utf8::encodeCodepoint(codepoint.value(), stringBuilder_);
+            Utf8::encodeCodepoint(codepoint.value(), builder);
 #else
-          stringBuilder_.append('\\');
+          builder.append('\\');
 #endif
           continue;
         }
@@ -438,30 +494,31 @@ class JsonDeserializer {
         move();
       }
 
-      stringBuilder_.append(c);
+      builder.append(c);
     }
 
-    if (!stringBuilder_.isValid())
+    if (!builder.isValid())
       return DeserializationError::NoMemory;
 
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code parseNonQuotedString() {
+  template <typename TStringBuilder>
+  DeserializationError::Code parseNonQuotedString(TStringBuilder& builder) {
     char c = current();
     ARDUINOJSON_ASSERT(c);
 
     if (canBeInNonQuotedString(c)) {  // no quotes
       do {
         move();
-        stringBuilder_.append(c);
+        builder.append(c);
         c = current();
       } while (canBeInNonQuotedString(c));
     } else {
       return DeserializationError::InvalidInput;
     }
 
-    if (!stringBuilder_.isValid())
+    if (!builder.isValid())
       return DeserializationError::NoMemory;
 
     return DeserializationError::Ok;
@@ -504,7 +561,7 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code parseNumericValue(VariantData& result) {
+  Number parseNumberToken() {
     uint8_t n = 0;
 
     char c = current();
@@ -515,7 +572,82 @@ class JsonDeserializer {
     }
     buffer_[n] = 0;
 
-    auto number = parseNumber(buffer_);
+    return parseNumber(buffer_);
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Reads the leading numbers of the array into a PackedArrayBuilder.
+  // Sets done if the whole array is packed; otherwise, moves the numbers to
+  // regular slots and stops at the next element.
+  DeserializationError::Code parsePackedArray(ArrayData& array, bool& done) {
+    DeserializationError::Code err;
+    PackedArrayBuilder builder(resources_);
+
+    for (;;) {
+      switch (current()) {
+        case '[':
+        case '{':
+        case '\"':
+        case '\'':
+        case 't':
+        case 'f':
+        case 'n':
+          // not a number, let the regular loop parse this element
+          if (!builder.unpack(array))
+            return DeserializationError::NoMemory;
+          return DeserializationError::Ok;
+      }
+
+      auto number = parseNumberToken();
+      if (!builder.add(number)) {
+        if (!builder.unpack(array))
+          return DeserializationError::NoMemory;
+        VariantData* value = array.addElement(resources_);
+        if (!value)
+          return DeserializationError::NoMemory;
+        err = setNumericValue(*value, number);
+        if (err)
+          return err;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+        done = eat(']');
+        if (!done && !eat(','))
+          return DeserializationError::InvalidInput;
+        return DeserializationError::Ok;
+      }
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (eat(']')) {
+        done = true;
+        if (builder.size() < ARDUINOJSON_PACKED_ARRAY_MIN_SIZE) {
+          if (!builder.unpack(array))
+            return DeserializationError::NoMemory;
+        } else if (!builder.save(collectionToVariant(&array))) {
+          return DeserializationError::NoMemory;
+        }
+        return DeserializationError::Ok;
+      }
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+#endif
+
+  DeserializationError::Code parseNumericValue(VariantData& result) {
+    return setNumericValue(result, parseNumberToken());
+  }
+
+  DeserializationError::Code setNumericValue(VariantData& result,
+                                             const Number& number) {
     switch (number.type()) {
       case NumberType::UnsignedInteger:
         if (result.setInteger(number.asUnsignedInteger(), resources_))
@@ -548,6 +680,327 @@ class JsonDeserializer {
     }
   }
 
+  DeserializationError::Code parseSchemaObject(
+      void* object, const JsonSchemaField* begin, const JsonSchemaField* end,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key in the number buffer, no field has a longer name
+      FixedStringBuilder key(buffer_, sizeof(buffer_));
+      err = parseKey(key);
+      if (err == DeserializationError::NoMemory)
+        return DeserializationError::InvalidInput;  // unknown field
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      auto field = findSchemaField(begin, end, key.c_str(), key.size());
+      if (!field)
+        return DeserializationError::InvalidInput;
+
+      // Parse value
+      err = parseSchemaField(object, *field, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError::Code parseSchemaField(
+      void* object, const JsonSchemaField& field,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // null leaves the member untouched
+    if (current() == 'n')
+      return skipKeyword("null");
+
+    char* value = reinterpret_cast<char*>(object) + field.offset;
+
+    if (field.capacity == 0 || field.type == SchemaFieldType::String)
+      return parseSchemaValue(value, field);
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    if (!eat('['))
+      return DeserializationError::InvalidInput;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    size_t count = 0;
+    if (!eat(']')) {
+      for (;;) {
+        // Too many elements?
+        if (count >= field.capacity)
+          return DeserializationError::NoMemory;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        err = parseSchemaValue(value + count * field.size, field);
+        if (err)
+          return err;
+        count++;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (eat(']'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+      }
+    }
+
+    if (field.countOffset >= 0)
+      storeSchemaCount(object, field, count);
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseSchemaValue(char* value,
+                                              const JsonSchemaField& field) {
+    switch (field.type) {
+      case SchemaFieldType::String: {
+        if (!isQuote(current()))
+          return DeserializationError::InvalidInput;
+        FixedStringBuilder builder(value, field.capacity);
+        auto err = parseQuotedString(builder);
+        // the member stays null-terminated, even when parsing failed
+        builder.c_str();
+        return err;
+      }
+
+      case SchemaFieldType::Boolean:
+        if (current() == 't') {
+          *reinterpret_cast<bool*>(value) = true;
+          return skipKeyword("true");
+        }
+        if (current() == 'f') {
+          *reinterpret_cast<bool*>(value) = false;
+          return skipKeyword("false");
+        }
+        return DeserializationError::InvalidInput;
+
+      default:
+        if (!storeSchemaNumber(value, field.type, field.size,
+                               parseNumberToken()))
+          return DeserializationError::InvalidInput;
+        return DeserializationError::Ok;
+    }
+  }
+
+  template <typename TSink>
+  DeserializationError::Code parseEventVariant(
+      TSink& sink, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return parseEventArray(sink, nestingLimit);
+
+      case '{':
+        return parseEventObject(sink, nestingLimit);
+
+      case '\"':
+      case '\'':
+        sink.strings.startString();
+        err = parseQuotedString(sink.strings);
+        if (err)
+          return err;
+        return sink.string();
+
+      case 't':
+        err = skipKeyword("true");
+        if (err)
+          return err;
+        return sink.boolean(true);
+
+      case 'f':
+        err = skipKeyword("false");
+        if (err)
+          return err;
+        return sink.boolean(false);
+
+      case 'n':
+        err = skipKeyword("null");
+        if (err)
+          return err;
+        return sink.null();
+
+      default:
+        return sink.number(parseNumberToken());
+    }
+  }
+
+  template <typename TSink>
+  DeserializationError::Code parseEventArray(
+      TSink& sink, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    err = sink.startArray();
+    if (err)
+      return err;
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return sink.endArray();
+
+    // Read each value
+    for (;;) {
+      // 1 - Parse value
+      err = parseEventVariant(sink, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // 2 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - More values?
+      if (eat(']'))
+        return sink.endArray();
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename TSink>
+  DeserializationError::Code parseEventObject(
+      TSink& sink, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    err = sink.startObject();
+    if (err)
+      return err;
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return sink.endObject();
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key
+      sink.strings.startString();
+      err = parseKey(sink.strings);
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      err = sink.key();
+      if (err)
+        return err;
+
+      // Parse value
+      err = parseEventVariant(sink, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return sink.endObject();
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
   DeserializationError::Code skipNumericValue() {
     char c = current();
     while (canBeInNumber(c)) {
@@ -572,35 +1025,6 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  static inline bool isBetween(char c, char min, char max) {
-    return min <= c && c <= max;
-  }
-
-  static inline bool canBeInNumber(char c) {
-    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
-#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
-           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
-#else
-           c == 'e' || c == 'E';
-#endif
-  }
-
-  static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z');
-  }
-
-  static inline bool isQuote(char c) {
-    return c == '\'' || c == '\"';
-  }
-
-  static inline uint8_t decodeHex(char c) {
-    if (c < 'A')
-      return uint8_t(c - '0');
-    c = char(c & ~0x20);  // uppercase
-    return uint8_t(c - 'A' + 10);
-  }
-
   DeserializationError::Code skipSpacesAndComments() {
     for (;;) {
       switch (current()) {
@@ -680,7 +1104,7 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  StringBuilder stringBuilder_;
+  typename StringBuilderFor<TReader>::type stringBuilder_;
   bool foundSomething_;
   Latch<TReader> latch_;
   ResourceManager* resources_;
@@ -689,6 +1113,24 @@ class JsonDeserializer {
                      // code
 };
 
+template <typename TDestination, typename TOptions>
+DeserializationError deserializeInSitu(TDestination& dst, char* input,
+                                       const char* end, TOptions options) {
+  InSituBuffer buffer = {input, end};
+#if ARDUINOJSON_DEBUG
+  auto resources = VariantAttorney::getResourceManager(dst);
+  if (resources)  // the previous strings are about to be dropped
+    resources->unlinkBuffer();
+#endif
+  auto err = doDeserialize<JsonDeserializer>(dst, InSituReader(&buffer),
+                                             options);
+#if ARDUINOJSON_DEBUG
+  if (resources)
+    resources->linkBuffer(input, size_t(buffer.ptr - input));
+#endif
+  return err;
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
@@ -717,4 +1159,119 @@ inline DeserializationError deserializeJson(TDestination&& dst, TChar* input,
                                        input, detail::forward<Args>(args)...);
 }
 
+// Parses a JSON input from a mutable buffer, and puts the result in a
+// JsonDocument without copying the strings: they are unescaped in place and
+// the document points to them. The buffer must not be modified or destroyed
+// before the document; debug builds assert it when the document is cleared.
+template <
+    typename TDestination, typename... Args,
+    detail::enable_if_t<
+        detail::is_deserialize_destination<TDestination>::value &&
+            !detail::is_integral<detail::decay_t<
+                typename detail::first_or_void<Args...>::type>>::value,
+        int> = 0>
+inline DeserializationError deserializeJsonInSitu(TDestination&& dst,
+                                                  char* input, Args&&... args) {
+  using namespace detail;
+  return deserializeInSitu(dst, input, nullptr,
+                           makeDeserializationOptions(args...));
+}
+
+// Parses a JSON input from a mutable buffer without copying the strings.
+template <typename TDestination, typename... Args,
+          detail::enable_if_t<
+              detail::is_deserialize_destination<TDestination>::value, int> = 0>
+inline DeserializationError deserializeJsonInSitu(TDestination&& dst,
+                                                  char* input, size_t inputSize,
+                                                  Args&&... args) {
+  using namespace detail;
+  return deserializeInSitu(dst, input, input + inputSize,
+                           makeDeserializationOptions(args...));
+}
+
+// Parses a JSON object directly into a struct, as described by the schema.
+// Doesn't allocate any memory; rejects unknown members, members of the wrong
+// type, and values that don't fit.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename T, typename TInput>
+inline DeserializationError deserializeJson(
+    T& dst, TInput&& input, const JsonSchema<T>& schema,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  auto reader = makeReader(detail::forward<TInput>(input));
+  return JsonDeserializer<decltype(reader)>(nullptr, reader)
+      .parse(dst, schema, nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token, without building
+// a JsonDocument. Memory usage is constant: strings and keys longer than
+// ARDUINOJSON_EVENT_STRING_CAPACITY-1 fail with NoMemory.
+template <typename TInput, typename THandler,
+          detail::enable_if_t<
+              detail::is_base_of<JsonHandler<THandler>, THandler>::value,
+              int> = 0>
+inline DeserializationError parseJson(
+    TInput&& input, THandler& handler,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  char strings[ARDUINOJSON_EVENT_STRING_CAPACITY];
+  auto reader = makeReader(detail::forward<TInput>(input));
+  return JsonDeserializer<decltype(reader)>(nullptr, reader)
+      .parseEvents(handler, strings, sizeof(strings), nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token.
+template <typename TChar, typename THandler,
+          detail::enable_if_t<
+              detail::is_base_of<JsonHandler<THandler>, THandler>::value,
+              int> = 0>
+inline DeserializationError parseJson(
+    TChar* input, THandler& handler,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  char strings[ARDUINOJSON_EVENT_STRING_CAPACITY];
+  auto reader = makeReader(input);
+  return JsonDeserializer<decltype(reader)>(nullptr, reader)
+      .parseEvents(handler, strings, sizeof(strings), nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token.
+template <typename TChar, typename THandler,
+          detail::enable_if_t<
+              detail::is_base_of<JsonHandler<THandler>, THandler>::value,
+              int> = 0>
+inline DeserializationError parseJson(
+    TChar* input, size_t inputSize, THandler& handler,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  char strings[ARDUINOJSON_EVENT_STRING_CAPACITY];
+  auto reader = makeReader(input, inputSize);
+  return JsonDeserializer<decltype(reader)>(nullptr, reader)
+      .parseEvents(handler, strings, sizeof(strings), nestingLimit);
+}
+
+// Parses a JSON object directly into a struct, as described by the schema.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename T, typename TChar>
+inline DeserializationError deserializeJson(
+    T& dst, TChar* input, const JsonSchema<T>& schema,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  auto reader = makeReader(input);
+  return JsonDeserializer<decltype(reader)>(nullptr, reader)
+      .parse(dst, schema, nestingLimit);
+}
+
+// Parses a JSON object directly into a struct, as described by the schema.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename T, typename TChar>
+inline DeserializationError deserializeJson(
+    T& dst, TChar* input, size_t inputSize, const JsonSchema<T>& schema,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  auto reader = makeReader(input, inputSize);
+  return JsonDeserializer<decltype(reader)>(nullptr, reader)
+      .parse(dst, schema, nestingLimit);
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,171 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Memory/FixedStringBuilder.hpp>
+#include <ArduinoJson/Numbers/JsonFloat.hpp>
+#include <ArduinoJson/Numbers/JsonInteger.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/limits.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Receives the events produced by parseJson().
+// Derive from JsonHandler<YourHandler> and hide the functions you need; the
+// others accept and ignore the event. Each function returns true to continue
+// or false to stop the parsing.
+// Strings passed to key() and string() are only valid during the call.
+template <typename TDerived>
+class JsonHandler {
+ public:
+  bool startObject() {
+    return true;
+  }
+
+  bool endObject() {
+    return true;
+  }
+
+  bool startArray() {
+    return true;
+  }
+
+  bool endArray() {
+    return true;
+  }
+
+  bool key(JsonString) {
+    return true;
+  }
+
+  bool string(JsonString) {
+    return true;
+  }
+
+  // Receives floating-point numbers, and integers unless integer() and
+  // unsignedInteger() are hidden too.
+  bool number(JsonFloat) {
+    return true;
+  }
+
+  bool integer(JsonInteger value) {
+    return derived().number(JsonFloat(value));
+  }
+
+  bool unsignedInteger(JsonUInt value) {
+    if (value <= JsonUInt(detail::numeric_limits<JsonInteger>::highest()))
+      return derived().integer(JsonInteger(value));
+    return derived().number(JsonFloat(value));
+  }
+
+  bool boolean(bool) {
+    return true;
+  }
+
+  bool null() {
+    return true;
+  }
+
+ private:
+  TDerived& derived() {
+    return static_cast<TDerived&>(*this);
+  }
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Forwards the tokens found by a parser to a JsonHandler.
+// Parsers build keys and strings in `strings` before calling key() or
+// string(); all functions return a non-zero code to stop the parser.
+template <typename THandler>
+class HandlerSink {
+ public:
+  HandlerSink(THandler& handler, char* buffer, size_t capacity)
+      : strings(buffer, capacity), handler_(handler), stopped_(false) {}
+
+  // Returns true if the handler asked to stop.
+  bool stopped() const {
+    return stopped_;
+  }
+
+  // Forgets a stop and any partial string, for the next message.
+  void reset() {
+    stopped_ = false;
+    strings.startString();
+  }
+
+  DeserializationError::Code startObject() {
+    return forward(handler_.startObject());
+  }
+
+  DeserializationError::Code endObject() {
+    return forward(handler_.endObject());
+  }
+
+  DeserializationError::Code startArray() {
+    return forward(handler_.startArray());
+  }
+
+  DeserializationError::Code endArray() {
+    return forward(handler_.endArray());
+  }
+
+  DeserializationError::Code key() {
+    return forward(handler_.key(JsonString(strings.c_str(), strings.size())));
+  }
+
+  DeserializationError::Code string() {
+    return forward(
+        handler_.string(JsonString(strings.c_str(), strings.size())));
+  }
+
+  DeserializationError::Code number(const Number& number) {
+    switch (number.type()) {
+      case NumberType::UnsignedInteger:
+        return forward(handler_.unsignedInteger(number.asUnsignedInteger()));
+
+      case NumberType::SignedInteger:
+        return forward(handler_.integer(number.asSignedInteger()));
+
+      case NumberType::Float:
+        return forward(handler_.number(number.asFloat()));
+
+#if ARDUINOJSON_USE_DOUBLE
+      case NumberType::Double:
+        return forward(handler_.number(number.asDouble()));
+#endif
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code boolean(bool value) {
+    return forward(handler_.boolean(value));
+  }
+
+  DeserializationError::Code null() {
+    return forward(handler_.null());
+  }
+
+  FixedStringBuilder strings;
+
+ private:
+  DeserializationError::Code forward(bool more) {
+    if (more)
+      return DeserializationError::Ok;
+    stopped_ = true;
+    return DeserializationError::InvalidInput;  // the caller checks stopped()
+  }
+
+  THandler& handler_;
+  bool stopped_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
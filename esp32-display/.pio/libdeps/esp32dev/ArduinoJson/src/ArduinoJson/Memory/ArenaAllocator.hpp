@@ -0,0 +1,130 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+
+#include <stdint.h>  // uint8_t
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A monotonic allocator that carves blocks out of a caller-supplied buffer,
+// for example a static array or a PSRAM block.
+// deallocate() only reclaims the last block, and reallocate() grows or
+// shrinks the last block in place; call reset() to reuse the whole buffer
+// once the JsonDocument is cleared.
+class ArenaAllocator : public Allocator {
+ public:
+  ArenaAllocator(void* buffer, size_t capacity)
+      : buffer_(static_cast<uint8_t*>(buffer)), capacity_(0), size_(0) {
+    // align the beginning of the buffer
+    size_t misalignment = reinterpret_cast<size_t>(buffer_) % alignment;
+    size_t padding = misalignment ? alignment - misalignment : 0;
+    if (capacity > padding) {
+      buffer_ += padding;
+      capacity_ = capacity - padding;
+    }
+  }
+
+  void* allocate(size_t size) override {
+    if (size > capacity_)
+      return nullptr;
+    size_t blockSize = headerSize + roundUp(size);
+    if (blockSize > capacity_ - size_)
+      return nullptr;
+    uint8_t* block = buffer_ + size_;
+    memcpy(block, &blockSize, sizeof(blockSize));
+    size_ += blockSize;
+    return block + headerSize;
+  }
+
+  void deallocate(void* ptr) override {
+    if (ptr && isLast(ptr))
+      size_ = offsetOf(ptr) - headerSize;
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+    if (newSize > capacity_)
+      return nullptr;
+
+    size_t blockSize = headerSize + roundUp(newSize);
+    size_t oldBlockSize = blockSizeOf(ptr);
+
+    if (isLast(ptr)) {
+      size_t start = offsetOf(ptr) - headerSize;
+      if (blockSize > capacity_ - start)
+        return nullptr;
+      memcpy(buffer_ + start, &blockSize, sizeof(blockSize));
+      size_ = start + blockSize;
+      return ptr;
+    }
+
+    // a block in the middle can shrink, but its bytes are not reclaimed
+    if (blockSize <= oldBlockSize)
+      return ptr;
+
+    void* newPtr = allocate(newSize);
+    if (newPtr)
+      memcpy(newPtr, ptr, oldBlockSize - headerSize);
+    return newPtr;
+  }
+
+  // Returns a position to pass to reset() later.
+  size_t mark() const {
+    return size_;
+  }
+
+  // Releases every block allocated since mark().
+  // The blocks must not be in use anymore, so clear the JsonDocument first.
+  void reset(size_t mark = 0) {
+    if (mark < size_)
+      size_ = mark;
+  }
+
+  // Returns the number of bytes in use, including the headers.
+  size_t size() const {
+    return size_;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  static const size_t alignment =
+      sizeof(void*) > sizeof(double) ? sizeof(void*) : sizeof(double);
+
+  // each block starts with its size, padding included
+  static const size_t headerSize =
+      (sizeof(size_t) + alignment - 1) / alignment * alignment;
+
+  static size_t roundUp(size_t size) {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  size_t offsetOf(void* ptr) const {
+    return size_t(static_cast<uint8_t*>(ptr) - buffer_);
+  }
+
+  size_t blockSizeOf(void* ptr) const {
+    size_t blockSize;
+    memcpy(&blockSize, static_cast<uint8_t*>(ptr) - headerSize,
+           sizeof(blockSize));
+    return blockSize;
+  }
+
+  bool isLast(void* ptr) const {
+    return offsetOf(ptr) - headerSize + blockSizeOf(ptr) == size_;
+  }
+
+  uint8_t* buffer_;
+  size_t capacity_;
+  size_t size_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
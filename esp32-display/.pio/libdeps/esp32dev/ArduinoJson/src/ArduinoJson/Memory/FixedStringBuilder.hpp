@@ -0,0 +1,52 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A StringBuilder that writes in a caller-supplied buffer instead of
+// allocating a StringNode.
+class FixedStringBuilder {
+ public:
+  FixedStringBuilder(char* buffer, size_t capacity)
+      : buffer_(buffer), capacity_(capacity), size_(0) {}
+
+  void startString() {
+    size_ = 0;
+  }
+
+  void append(char c) {
+    // keep one byte for the terminator
+    if (size_ + 1 < capacity_)
+      buffer_[size_] = c;
+    size_++;
+  }
+
+  // Returns false if the string didn't fit in the buffer.
+  bool isValid() const {
+    return size_ < capacity_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Terminates the string and returns it; if it didn't fit, what did
+  const char* c_str() {
+    buffer_[size_ < capacity_ ? size_ : capacity_ - 1] = 0;
+    return buffer_;
+  }
+
+ private:
+  char* buffer_;
+  size_t capacity_;
+  size_t size_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,28 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The memory allocated by a JsonDocument, in bytes.
+// Returned by JsonDocument::memoryReport().
+struct MemoryReport {
+  size_t variants;    // slots holding a variant
+  size_t extensions;  // slots holding a 64-bit number
+  size_t strings;     // string pool
+  size_t freeSlots;   // slots released but not reused yet
+  size_t overhead;    // unused end of the pools, pool array, array and object
+                      // indexes
+
+  size_t total() const {
+    return variants + extensions + strings + freeSlots + overhead;
+  }
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
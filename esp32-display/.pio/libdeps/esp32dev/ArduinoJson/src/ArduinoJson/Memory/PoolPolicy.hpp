@@ -0,0 +1,53 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Controls the size of the variant pools of a JsonDocument.
+// Pools never exceed ARDUINOJSON_POOL_CAPACITY slots; smaller pools waste
+// less memory on small documents but reduce the maximum number of slots.
+// https://arduinojson.org/v7/api/jsondocument/
+class PoolPolicy {
+ public:
+  // Every pool has ARDUINOJSON_POOL_CAPACITY slots
+  PoolPolicy()
+      : initialCapacity_(ARDUINOJSON_POOL_CAPACITY), geometric_(false) {}
+
+  // Every pool has the specified number of slots
+  static PoolPolicy fixed(size_t capacity) {
+    return PoolPolicy(capacity, false);
+  }
+
+  // The first pool has the specified number of slots, and each new pool has
+  // twice as many as the previous one, up to ARDUINOJSON_POOL_CAPACITY
+  static PoolPolicy geometric(size_t initialCapacity) {
+    return PoolPolicy(initialCapacity, true);
+  }
+
+  // Returns the number of slots of the pool at the specified index
+  size_t poolCapacity(size_t index) const {
+    size_t capacity = initialCapacity_;
+    if (geometric_) {
+      while (index-- && capacity < ARDUINOJSON_POOL_CAPACITY)
+        capacity *= 2;
+    }
+    return capacity < ARDUINOJSON_POOL_CAPACITY ? capacity
+                                                : ARDUINOJSON_POOL_CAPACITY;
+  }
+
+ private:
+  PoolPolicy(size_t capacity, bool geometric)
+      : initialCapacity_(capacity ? capacity : 1), geometric_(geometric) {}
+
+  size_t initialCapacity_;
+  bool geometric_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
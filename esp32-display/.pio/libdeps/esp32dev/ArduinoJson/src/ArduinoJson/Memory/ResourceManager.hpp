@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <ArduinoJson/Array/ArrayIndex.hpp>
+#include <ArduinoJson/Object/ObjectIndex.hpp>
 #include <ArduinoJson/Memory/Allocator.hpp>
 #include <ArduinoJson/Memory/MemoryPoolList.hpp>
+#include <ArduinoJson/Memory/MemoryReport.hpp>
 #include <ArduinoJson/Memory/StringPool.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
@@ -32,18 +35,44 @@ class ResourceManager {
       : allocator_(allocator), overflowed_(false) {}
 
   ~ResourceManager() {
+#if ARDUINOJSON_DEBUG
+    checkLinkedBuffer();
+#endif
     stringPool_.clear(allocator_);
     variantPools_.clear(allocator_);
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+    arrayIndex_.clear(allocator_);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+    objectIndex_.clear(allocator_);
+#endif
   }
 
   ResourceManager(const ResourceManager&) = delete;
   ResourceManager& operator=(const ResourceManager& src) = delete;
 
   friend void swap(ResourceManager& a, ResourceManager& b) {
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+    // the root arrays stay in the documents, so the entries would be wrong
+    a.arrayIndex_.clear(a.allocator_);
+    b.arrayIndex_.clear(b.allocator_);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+    a.objectIndex_.clear(a.allocator_);
+    b.objectIndex_.clear(b.allocator_);
+#endif
     swap(a.stringPool_, b.stringPool_);
     swap(a.variantPools_, b.variantPools_);
     swap_(a.allocator_, b.allocator_);
     swap_(a.overflowed_, b.overflowed_);
+#if ARDUINOJSON_DEBUG
+    swap_(a.linkedBuffer_, b.linkedBuffer_);
+    swap_(a.linkedBufferSize_, b.linkedBufferSize_);
+    swap_(a.linkedBufferHash_, b.linkedBufferHash_);
+#endif
+#if ARDUINOJSON_USE_EXTENSIONS
+    swap_(a.extensionCount_, b.extensionCount_);
+#endif
   }
 
   Allocator* allocator() const {
@@ -58,6 +87,38 @@ class ResourceManager {
     return overflowed_;
   }
 
+  void setPoolPolicy(PoolPolicy policy) {
+    variantPools_.setPolicy(policy);
+  }
+
+  PoolPolicy poolPolicy() const {
+    return variantPools_.policy();
+  }
+
+  MemoryReport memoryReport() const {
+    MemoryReport report;
+    size_t slotSize = sizeof(SlotData);
+    SlotCount freeSlots = variantPools_.freeSlots();
+    size_t liveSlots = variantPools_.usage() - freeSlots;
+#if ARDUINOJSON_USE_EXTENSIONS
+    report.extensions = extensionCount_ * slotSize;
+    liveSlots -= extensionCount_;
+#else
+    report.extensions = 0;
+#endif
+    report.variants = liveSlots * slotSize;
+    report.strings = stringPool_.size();
+    report.freeSlots = freeSlots * slotSize;
+    report.overhead = variantPools_.overhead();
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+    report.overhead += arrayIndex_.size();
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+    report.overhead += objectIndex_.size();
+#endif
+    return report;
+  }
+
   Slot<VariantData> allocVariant();
   void freeVariant(Slot<VariantData> slot);
   VariantData* getVariant(SlotId id) const;
@@ -112,20 +173,89 @@ class ResourceManager {
   }
 
   void clear() {
+#if ARDUINOJSON_DEBUG
+    checkLinkedBuffer();
+    unlinkBuffer();
+#endif
     variantPools_.clear(allocator_);
     overflowed_ = false;
+#if ARDUINOJSON_USE_EXTENSIONS
+    extensionCount_ = 0;
+#endif
     stringPool_.clear(allocator_);
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+    arrayIndex_.clear(allocator_);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+    objectIndex_.clear(allocator_);
+#endif
   }
 
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  ArrayIndex& arrayIndex() {
+    return arrayIndex_;
+  }
+
+  const ArrayIndex& arrayIndex() const {
+    return arrayIndex_;
+  }
+#endif
+
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+  ObjectIndex& objectIndex() {
+    return objectIndex_;
+  }
+
+  const ObjectIndex& objectIndex() const {
+    return objectIndex_;
+  }
+#endif
+
   void shrinkToFit() {
     variantPools_.shrinkToFit(allocator_);
   }
 
+#if ARDUINOJSON_DEBUG
+  // Remembers the buffer of deserializeJsonInSitu(), to detect when it's
+  // modified while the linked strings still point to it.
+  void linkBuffer(const char* data, size_t size) {
+    linkedBuffer_ = data;
+    linkedBufferSize_ = size;
+    linkedBufferHash_ = hashBytes(data, size);
+  }
+
+  void unlinkBuffer() {
+    linkedBuffer_ = nullptr;
+  }
+#endif
+
  private:
+#if ARDUINOJSON_DEBUG
+  void checkLinkedBuffer() const {
+    ARDUINOJSON_ASSERT(!linkedBuffer_ ||
+                       hashBytes(linkedBuffer_, linkedBufferSize_) ==
+                           linkedBufferHash_);  // buffer modified too early
+  }
+#endif
+
   Allocator* allocator_;
   bool overflowed_;
   StringPool stringPool_;
   MemoryPoolList<SlotData> variantPools_;
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  ArrayIndex arrayIndex_;
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+  ObjectIndex objectIndex_;
+#endif
+#if ARDUINOJSON_USE_EXTENSIONS
+  SlotCount extensionCount_ = 0;
+#endif
+#if ARDUINOJSON_DEBUG
+  const char* linkedBuffer_ = nullptr;
+  size_t linkedBufferSize_ = 0;
+  uint32_t linkedBufferHash_ = 0;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
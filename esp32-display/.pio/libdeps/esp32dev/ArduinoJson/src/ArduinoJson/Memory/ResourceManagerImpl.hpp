@@ -36,10 +36,13 @@ inline Slot<VariantExtension> ResourceManager::allocExtension() {
     overflowed_ = true;
     return {};
   }
+  extensionCount_++;
   return {&p->extension, p.id()};
 }
 
 inline void ResourceManager::freeExtension(SlotId id) {
+  ARDUINOJSON_ASSERT(extensionCount_ > 0);
+  extensionCount_--;
   auto p = getExtension(id);
   variantPools_.freeSlot({reinterpret_cast<SlotData*>(p), id});
 }
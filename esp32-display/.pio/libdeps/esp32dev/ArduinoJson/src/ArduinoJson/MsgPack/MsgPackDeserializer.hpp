@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Array/PackedArrayBuilder.hpp>
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Memory/StringBuffer.hpp>
@@ -36,14 +37,21 @@ class MsgPackDeserializer {
   DeserializationError::Code parseVariant(
       VariantData* variant, TFilter filter,
       DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
-
-    uint8_t header[5];
-    err = readBytes(header, 1);
+    uint8_t code;
+    auto err = readByte(code);
     if (err)
       return err;
+    return parseVariant(variant, code, filter, nestingLimit);
+  }
 
-    const uint8_t& code = header[0];
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      VariantData* variant, uint8_t code, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t header[5];
+    header[0] = code;
 
     foundSomething_ = true;
 
@@ -349,6 +357,14 @@ class MsgPackDeserializer {
 
     bool allowArray = filter.allowArray();
 
+    TFilter elementFilter = filter[0U];
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (allowArray && elementFilter.allowValue() &&
+        n >= ARDUINOJSON_PACKED_ARRAY_MIN_SIZE)
+      return readPackedArray(variant, n, elementFilter, nestingLimit);
+#endif
+
     ArrayData* array;
     if (allowArray) {
       ARDUINOJSON_ASSERT(variant != 0);
@@ -357,8 +373,6 @@ class MsgPackDeserializer {
       array = 0;
     }
 
-    TFilter elementFilter = filter[0U];
-
     for (; n; --n) {
       VariantData* value;
 
@@ -379,6 +393,298 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Reads an array of integers, float 32, or float 64 directly into a packed
+  // array; falls back to regular slots at the first element that doesn't fit.
+  template <typename TFilter>
+  DeserializationError::Code readPackedArray(
+      VariantData* variant, size_t n, TFilter elementFilter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    ARDUINOJSON_ASSERT(variant != 0);
+    PackedArrayBuilder builder(resources_);
+    size_t i = 0;
+    bool overflow = false;
+    uint32_t overflowValue = 0;
+
+    uint8_t code;
+    auto err = readByte(code);
+    if (err)
+      return err;
+
+    PackedArrayType type;
+    if (packedArrayTypeOf(code, type) &&
+        builder.reserve(type, n,
+                        packedCapacity(n, IsContiguousReader<TReader>()))) {
+      for (;;) {
+        PackedArrayType elementType;
+        if (!packedArrayTypeOf(code, elementType) || elementType != type)
+          break;
+
+        err = readPackedElement(builder, code, overflowValue, overflow);
+        if (err)
+          return err;
+        if (overflow)
+          break;
+        i++;
+
+        // copy the following elements with the same code in one go
+        i += readPackedRun(builder, code, n - i, IsContiguousReader<TReader>());
+
+        if (i == n) {
+          if (!builder.save(variant))
+            return DeserializationError::NoMemory;
+          return DeserializationError::Ok;
+        }
+
+        err = readByte(code);
+        if (err)
+          return err;
+      }
+    }
+
+    ArrayData& array = variant->toArray();
+    if (!builder.unpack(array))
+      return DeserializationError::NoMemory;
+
+    if (overflow) {
+      VariantData* value = array.addElement(resources_);
+      if (!value)
+        return DeserializationError::NoMemory;
+      value->setInteger(overflowValue, resources_);
+      if (++i == n)
+        return DeserializationError::Ok;
+      err = readByte(code);
+      if (err)
+        return err;
+    }
+
+    for (;;) {
+      VariantData* value = array.addElement(resources_);
+      if (!value)
+        return DeserializationError::NoMemory;
+
+      err = parseVariant(value, code, elementFilter, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      if (++i == n)
+        return DeserializationError::Ok;
+
+      err = readByte(code);
+      if (err)
+        return err;
+    }
+  }
+
+  static bool isFixInt(uint8_t code) {
+    return code <= 0x7f || code >= 0xe0;
+  }
+
+  // Tells which packed array can hold a value with this code.
+  // A uint 32 may still be too big for an int32_t.
+  static bool packedArrayTypeOf(uint8_t code, PackedArrayType& type) {
+    if (isFixInt(code)) {
+      type = PackedArrayType::Int32;
+      return true;
+    }
+    switch (code) {
+      case 0xcc:
+      case 0xcd:
+      case 0xce:
+      case 0xd0:
+      case 0xd1:
+      case 0xd2:
+        type = PackedArrayType::Int32;
+        return true;
+
+      case 0xca:
+        type = PackedArrayType::Float;
+        return true;
+
+      case 0xcb:
+        if (sizeof(double) != 8)  // see readDouble()
+          return false;
+#  if ARDUINOJSON_USE_DOUBLE
+        type = PackedArrayType::Double;
+#  else
+        type = PackedArrayType::Float;
+#  endif
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  // Reads the value that follows the code and adds it to the packed array.
+  // Sets `overflow` instead if it's a uint 32 that doesn't fit in an int32_t.
+  DeserializationError::Code readPackedElement(PackedArrayBuilder& builder,
+                                               uint8_t code,
+                                               uint32_t& overflowValue,
+                                               bool& overflow) {
+    if (isFixInt(code)) {
+      if (!builder.add(int32_t(int8_t(code))))
+        return DeserializationError::NoMemory;
+      return DeserializationError::Ok;
+    }
+    switch (code) {
+      case 0xcc:
+        return readPackedElement<uint8_t, int32_t>(builder);
+      case 0xcd:
+        return readPackedElement<uint16_t, int32_t>(builder);
+      case 0xce: {
+        auto err = readBytes(overflowValue);
+        if (err)
+          return err;
+        fixEndianness(overflowValue);
+        if (overflowValue > 0x7fffffff)
+          overflow = true;
+        else if (!builder.add(int32_t(overflowValue)))
+          return DeserializationError::NoMemory;
+        return DeserializationError::Ok;
+      }
+      case 0xd0:
+        return readPackedElement<int8_t, int32_t>(builder);
+      case 0xd1:
+        return readPackedElement<int16_t, int32_t>(builder);
+      case 0xd2:
+        return readPackedElement<int32_t, int32_t>(builder);
+      case 0xca:
+        return readPackedElement<float, float>(builder);
+      default:
+#  if ARDUINOJSON_USE_DOUBLE
+        return readPackedElement<double, double>(builder);
+#  else
+        return readPackedElement<double, float>(builder);
+#  endif
+    }
+  }
+
+  template <typename TValue, typename TPacked>
+  DeserializationError::Code readPackedElement(PackedArrayBuilder& builder) {
+    TValue value;
+    auto err = readBytes(value);
+    if (err)
+      return err;
+    fixEndianness(value);
+    if (!builder.add(TPacked(value)))
+      return DeserializationError::NoMemory;
+    return DeserializationError::Ok;
+  }
+
+  // The count in the header comes from the input, so it isn't trusted: every
+  // element takes at least one byte, which bounds the room worth reserving.
+  size_t packedCapacity(size_t n, true_type) {
+    if (!knowsSize())
+      return packedCapacity(n, false_type());
+    size_t left = reader_.available() + 1;  // the first code is already read
+    return n < left ? n : left;
+  }
+
+  // A bare pointer reads like a buffer, but doesn't know where the input ends
+  bool knowsSize() const {
+    return reader_.available() != size_t(-1);
+  }
+
+  // A stream doesn't tell how much is left: start small and let the array
+  // grow as the elements arrive
+  size_t packedCapacity(size_t n, false_type) {
+    return n < PackedArrayBuilder::initialCapacity
+               ? n
+               : PackedArrayBuilder::initialCapacity;
+  }
+
+  // Readers that can't look ahead get the elements one by one
+  size_t readPackedRun(PackedArrayBuilder&, uint8_t, size_t, false_type) {
+    return 0;
+  }
+
+  // Copies the longest run of elements with the specified code (at most
+  // maxCount) to the packed array, and returns its length.
+  // The run is located with a scan of the input, so the conversion is a
+  // simple loop over contiguous bytes.
+  size_t readPackedRun(PackedArrayBuilder& builder, uint8_t code,
+                       size_t maxCount, true_type) {
+    if (isFixInt(code))
+      return readFixIntRun(builder, maxCount);
+    switch (code) {
+      case 0xcc:
+        return readPackedRun<uint8_t, int32_t>(builder, code, maxCount);
+      case 0xcd:
+        return readPackedRun<uint16_t, int32_t>(builder, code, maxCount);
+      case 0xce:
+        return readPackedRun<uint32_t, int32_t>(builder, code, maxCount);
+      case 0xd0:
+        return readPackedRun<int8_t, int32_t>(builder, code, maxCount);
+      case 0xd1:
+        return readPackedRun<int16_t, int32_t>(builder, code, maxCount);
+      case 0xd2:
+        return readPackedRun<int32_t, int32_t>(builder, code, maxCount);
+      case 0xca:
+        return readPackedRun<float, float>(builder, code, maxCount);
+      default:
+#  if ARDUINOJSON_USE_DOUBLE
+        return readPackedRun<double, double>(builder, code, maxCount);
+#  else
+        return readPackedRun<double, float>(builder, code, maxCount);
+#  endif
+    }
+  }
+
+  size_t readFixIntRun(PackedArrayBuilder& builder, size_t maxCount) {
+    auto src = reinterpret_cast<const uint8_t*>(reader_.position());
+    size_t available = reader_.available();
+    size_t count = 0;
+    while (count < maxCount && count < available && isFixInt(src[count]))
+      count++;
+
+    char* dst = builder.extend(count);
+    if (!dst)  // the elements come one by one and report the error
+      return 0;
+    for (size_t i = 0; i < count; i++) {
+      int32_t value = int8_t(src[i]);
+      memcpy(dst + i * sizeof(value), &value, sizeof(value));
+    }
+
+    reader_.skip(count);
+    return count;
+  }
+
+  template <typename TValue, typename TPacked>
+  size_t readPackedRun(PackedArrayBuilder& builder, uint8_t code,
+                       size_t maxCount) {
+    using bits_t = uint_t<sizeof(TValue) * 8>;
+    const size_t stride = 1 + sizeof(TValue);
+    // a uint 32 must fit in an int32_t
+    const bool checkSign = is_unsigned<TValue>::value &&
+                           sizeof(TValue) == sizeof(TPacked);
+
+    auto src = reinterpret_cast<const uint8_t*>(reader_.position());
+    size_t available = reader_.available() / stride;
+    size_t count = 0;
+    while (count < maxCount && count < available &&
+           src[count * stride] == code &&
+           !(checkSign && (src[count * stride + 1] & 0x80)))
+      count++;
+
+    char* dst = builder.extend(count);
+    if (!dst)
+      return 0;
+    for (size_t i = 0; i < count; i++) {
+      bits_t bits;
+      memcpy(&bits, src + i * stride + 1, sizeof(bits));
+      bits = fromBigEndian(bits);
+      TValue value;
+      memcpy(&value, &bits, sizeof(value));
+      TPacked packed = TPacked(value);
+      memcpy(dst + i * sizeof(packed), &packed, sizeof(packed));
+    }
+
+    reader_.skip(count * stride);
+    return count;
+  }
+#endif
+
   template <typename TFilter>
   DeserializationError::Code readObject(
       VariantData* variant, size_t n, TFilter filter,
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Polyfills/integer.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
@@ -43,4 +44,30 @@ template <typename T>
 inline void fixEndianness(T&) {}
 #endif
 
+// Same as fixEndianness() but on integers, so that compilers can turn loops
+// into vector instructions
+inline uint8_t fromBigEndian(uint8_t value) {
+  return value;
+}
+
+#if ARDUINOJSON_LITTLE_ENDIAN && defined(__GNUC__)
+inline uint16_t fromBigEndian(uint16_t value) {
+  return __builtin_bswap16(value);
+}
+
+inline uint32_t fromBigEndian(uint32_t value) {
+  return __builtin_bswap32(value);
+}
+
+inline uint64_t fromBigEndian(uint64_t value) {
+  return __builtin_bswap64(value);
+}
+#else
+template <typename T>
+inline T fromBigEndian(T value) {
+  fixEndianness(value);
+  return value;
+}
+#endif
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
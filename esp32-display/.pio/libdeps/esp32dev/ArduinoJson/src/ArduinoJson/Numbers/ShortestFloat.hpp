@@ -0,0 +1,318 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+#include <ArduinoJson/Polyfills/pgmspace_generic.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The shortest sequence of decimal digits that reads back as the original
+// value: value = 0.digits * 10^(length + exponent) = digits * 10^exponent
+struct ShortestFloat {
+  char digits[18];
+  int8_t length;
+  int16_t exponent;
+};
+
+// Grisu2 by Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers" (PLDI 2010).
+// The output always round-trips; it is the shortest in 99.9% of the cases and
+// at most one digit longer otherwise.
+namespace grisu {
+
+// A "do-it-yourself" floating-point number: f * 2^e
+struct DiyFloat {
+  uint64_t f;
+  int16_t e;
+};
+
+inline DiyFloat subtract(DiyFloat x, DiyFloat y) {
+  ARDUINOJSON_ASSERT(x.e == y.e);
+  ARDUINOJSON_ASSERT(x.f >= y.f);
+  return {x.f - y.f, x.e};
+}
+
+// Returns the upper 64 bits of the 128-bit product, rounded
+inline DiyFloat multiply(DiyFloat x, DiyFloat y) {
+  uint64_t xLo = x.f & 0xFFFFFFFF, xHi = x.f >> 32;
+  uint64_t yLo = y.f & 0xFFFFFFFF, yHi = y.f >> 32;
+
+  uint64_t p0 = xLo * yLo;
+  uint64_t p1 = xLo * yHi;
+  uint64_t p2 = xHi * yLo;
+  uint64_t p3 = xHi * yHi;
+
+  uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+  middle += uint64_t(1) << 31;  // round
+
+  uint64_t high = p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+  return {high, int16_t(x.e + y.e + 64)};
+}
+
+inline DiyFloat normalizeDiy(DiyFloat x) {
+  while ((x.f >> 63) == 0) {
+    x.f <<= 1;
+    x.e--;
+  }
+  return x;
+}
+
+inline DiyFloat normalizeTo(DiyFloat x, int16_t e) {
+  ARDUINOJSON_ASSERT(x.e >= e);
+  return {x.f << (x.e - e), e};
+}
+
+struct Boundaries {
+  DiyFloat value;
+  DiyFloat minus;
+  DiyFloat plus;
+};
+
+// Computes the value and the boundaries m- and m+ of the rounding interval;
+// m- is scaled to the exponent of m+, which is also the one of value.
+template <typename T>
+inline Boundaries computeBoundaries(T value) {
+  using traits = FloatTraits<T>;
+  using bits_type = typename traits::mantissa_type;
+  const int16_t bias = int16_t(
+      (1 << (sizeof(T) * 8 - traits::mantissa_bits - 2)) - 1 +
+      traits::mantissa_bits);
+  const uint64_t hiddenBit = uint64_t(1) << traits::mantissa_bits;
+
+  bits_type bits = alias_cast<bits_type>(value);
+  uint64_t fraction = bits & traits::mantissa_max;
+  int16_t exponent = int16_t(
+      (bits >> traits::mantissa_bits) &
+      ((1 << (sizeof(T) * 8 - traits::mantissa_bits - 1)) - 1));
+
+  DiyFloat v;
+  if (exponent == 0)  // subnormal
+    v = {fraction, int16_t(1 - bias)};
+  else
+    v = {fraction + hiddenBit, int16_t(exponent - bias)};
+
+  // the lower boundary is closer when the fraction is a power of two
+  bool lowerIsCloser = fraction == 0 && exponent > 1;
+
+  DiyFloat plus = normalizeDiy({2 * v.f + 1, int16_t(v.e - 1)});
+  DiyFloat minus = lowerIsCloser ? DiyFloat{4 * v.f - 1, int16_t(v.e - 2)}
+                                 : DiyFloat{2 * v.f - 1, int16_t(v.e - 1)};
+
+  return {normalizeDiy(v), normalizeTo(minus, plus.e), plus};
+}
+
+struct CachedPower {
+  DiyFloat c;
+  int16_t k;
+};
+
+// Returns c = 10^k such that the binary exponent of c * 2^e lies in [-60, -32]
+inline CachedPower getCachedPower(int16_t e) {
+  ARDUINOJSON_DEFINE_PROGMEM_ARRAY(
+      uint64_t, significands,
+      {
+          0xAB70FE17C79AC6CA,  // 1e-300
+          0xFF77B1FCBEBCDC4F,  // 1e-292
+          0xBE5691EF416BD60C,  // 1e-284
+          0x8DD01FAD907FFC3C,  // 1e-276
+          0xD3515C2831559A83,  // 1e-268
+          0x9D71AC8FADA6C9B5,  // 1e-260
+          0xEA9C227723EE8BCB,  // 1e-252
+          0xAECC49914078536D,  // 1e-244
+          0x823C12795DB6CE57,  // 1e-236
+          0xC21094364DFB5637,  // 1e-228
+          0x9096EA6F3848984F,  // 1e-220
+          0xD77485CB25823AC7,  // 1e-212
+          0xA086CFCD97BF97F4,  // 1e-204
+          0xEF340A98172AACE5,  // 1e-196
+          0xB23867FB2A35B28E,  // 1e-188
+          0x84C8D4DFD2C63F3B,  // 1e-180
+          0xC5DD44271AD3CDBA,  // 1e-172
+          0x936B9FCEBB25C996,  // 1e-164
+          0xDBAC6C247D62A584,  // 1e-156
+          0xA3AB66580D5FDAF6,  // 1e-148
+          0xF3E2F893DEC3F126,  // 1e-140
+          0xB5B5ADA8AAFF80B8,  // 1e-132
+          0x87625F056C7C4A8B,  // 1e-124
+          0xC9BCFF6034C13053,  // 1e-116
+          0x964E858C91BA2655,  // 1e-108
+          0xDFF9772470297EBD,  // 1e-100
+          0xA6DFBD9FB8E5B88F,  // 1e-92
+          0xF8A95FCF88747D94,  // 1e-84
+          0xB94470938FA89BCF,  // 1e-76
+          0x8A08F0F8BF0F156B,  // 1e-68
+          0xCDB02555653131B6,  // 1e-60
+          0x993FE2C6D07B7FAC,  // 1e-52
+          0xE45C10C42A2B3B06,  // 1e-44
+          0xAA242499697392D3,  // 1e-36
+          0xFD87B5F28300CA0E,  // 1e-28
+          0xBCE5086492111AEB,  // 1e-20
+          0x8CBCCC096F5088CC,  // 1e-12
+          0xD1B71758E219652C,  // 1e-4
+          0x9C40000000000000,  // 1e4
+          0xE8D4A51000000000,  // 1e12
+          0xAD78EBC5AC620000,  // 1e20
+          0x813F3978F8940984,  // 1e28
+          0xC097CE7BC90715B3,  // 1e36
+          0x8F7E32CE7BEA5C70,  // 1e44
+          0xD5D238A4ABE98068,  // 1e52
+          0x9F4F2726179A2245,  // 1e60
+          0xED63A231D4C4FB27,  // 1e68
+          0xB0DE65388CC8ADA8,  // 1e76
+          0x83C7088E1AAB65DB,  // 1e84
+          0xC45D1DF942711D9A,  // 1e92
+          0x924D692CA61BE758,  // 1e100
+          0xDA01EE641A708DEA,  // 1e108
+          0xA26DA3999AEF774A,  // 1e116
+          0xF209787BB47D6B85,  // 1e124
+          0xB454E4A179DD1877,  // 1e132
+          0x865B86925B9BC5C2,  // 1e140
+          0xC83553C5C8965D3D,  // 1e148
+          0x952AB45CFA97A0B3,  // 1e156
+          0xDE469FBD99A05FE3,  // 1e164
+          0xA59BC234DB398C25,  // 1e172
+          0xF6C69A72A3989F5C,  // 1e180
+          0xB7DCBF5354E9BECE,  // 1e188
+          0x88FCF317F22241E2,  // 1e196
+          0xCC20CE9BD35C78A5,  // 1e204
+          0x98165AF37B2153DF,  // 1e212
+          0xE2A0B5DC971F303A,  // 1e220
+          0xA8D9D1535CE3B396,  // 1e228
+          0xFB9B7CD9A4A7443C,  // 1e236
+          0xBB764C4CA7A44410,  // 1e244
+          0x8BAB8EEFB6409C1A,  // 1e252
+          0xD01FEF10A657842C,  // 1e260
+          0x9B10A4E5E9913129,  // 1e268
+          0xE7109BFBA19C0C9D,  // 1e276
+          0xAC2820D9623BF429,  // 1e284
+          0x80444B5E7AA7CF85,  // 1e292
+          0xBF21E44003ACDD2D,  // 1e300
+          0x8E679C2F5E44FF8F,  // 1e308
+          0xD433179D9C8CB841,  // 1e316
+          0x9E19DB92B4E31BA9,  // 1e324
+      });
+  ARDUINOJSON_DEFINE_PROGMEM_ARRAY(
+      int16_t, exponents,
+      {
+          -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+          -794, -768, -741, -715, -688, -661, -635, -608, -582, -555,
+          -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+          -263, -236, -210, -183, -157, -130, -103, -77, -50, -24,
+          3, 30, 56, 83, 109, 136, 162, 189, 216, 242,
+          269, 295, 322, 348, 375, 402, 428, 455, 481, 508,
+          534, 561, 588, 614, 641, 667, 694, 720, 747, 774,
+          800, 827, 853, 880, 907, 933, 960, 986, 1013
+      });
+  const int minDecimalExponent = -300;
+  const int decimalExponentStep = 8;
+  const int alpha = -60;
+
+  // k = ceil((alpha - e - 1) * log10(2))
+  int f = alpha - e - 1;
+  int k = (f * 78913) / (1 << 18) + (f > 0);
+  int index = (-minDecimalExponent + k + (decimalExponentStep - 1)) /
+              decimalExponentStep;
+  ARDUINOJSON_ASSERT(index >= 0 && index < 79);
+
+  pgm_ptr<uint64_t> significandsPtr(significands);
+  pgm_ptr<int16_t> exponentsPtr(exponents);
+  return {{significandsPtr[index], exponentsPtr[index]},
+          int16_t(minDecimalExponent + index * decimalExponentStep)};
+}
+
+// Returns the number of digits of n and sets pow10 to 10^(digits-1)
+inline int8_t largestPowerOf10(uint32_t n, uint32_t& pow10) {
+  int8_t digits = 1;
+  pow10 = 1;
+  while (digits < 10 && n / pow10 >= 10) {
+    pow10 *= 10;
+    digits++;
+  }
+  return digits;
+}
+
+// Moves the last digit closer to w while staying in the rounding interval
+inline void roundWeed(char* digits, int8_t length, uint64_t dist,
+                      uint64_t delta, uint64_t rest, uint64_t tenK) {
+  while (rest < dist && delta - rest >= tenK &&
+         (rest + tenK < dist || dist - rest > rest + tenK - dist)) {
+    digits[length - 1]--;
+    rest += tenK;
+  }
+}
+
+// Generates the digits of M+ until the value lies within [M-, M+]
+inline void generateDigits(ShortestFloat& result, DiyFloat mMinus, DiyFloat w,
+                           DiyFloat mPlus) {
+  uint64_t delta = subtract(mPlus, mMinus).f;
+  uint64_t dist = subtract(mPlus, w).f;
+
+  const int8_t shift = int8_t(-mPlus.e);
+  const uint64_t one = uint64_t(1) << shift;
+
+  uint32_t p1 = uint32_t(mPlus.f >> shift);  // integral part
+  uint64_t p2 = mPlus.f & (one - 1);          // fractional part
+
+  uint32_t pow10;
+  int8_t n = largestPowerOf10(p1, pow10);
+
+  while (n > 0) {
+    result.digits[result.length++] = char('0' + p1 / pow10);
+    p1 %= pow10;
+    n--;
+
+    uint64_t rest = (uint64_t(p1) << shift) + p2;
+    if (rest <= delta) {
+      result.exponent = int16_t(result.exponent + n);
+      roundWeed(result.digits, result.length, dist, delta, rest,
+                uint64_t(pow10) << shift);
+      return;
+    }
+    pow10 /= 10;
+  }
+
+  for (;;) {
+    p2 *= 10;
+    result.digits[result.length++] = char('0' + (p2 >> shift));
+    p2 &= one - 1;
+    result.exponent--;
+    delta *= 10;
+    dist *= 10;
+    if (p2 <= delta)
+      break;
+  }
+  roundWeed(result.digits, result.length, dist, delta, p2, one);
+}
+
+}  // namespace grisu
+
+// Converts a finite, strictly positive value to its shortest decimal form
+template <typename T>
+inline ShortestFloat decomposeFloatShortest(T value) {
+  using namespace grisu;
+  ARDUINOJSON_ASSERT(value > 0);
+
+  Boundaries b = computeBoundaries(value);
+  CachedPower cached = getCachedPower(b.plus.e);
+
+  DiyFloat w = multiply(b.value, cached.c);
+  DiyFloat wMinus = multiply(b.minus, cached.c);
+  DiyFloat wPlus = multiply(b.plus, cached.c);
+
+  // shrink the interval by one ulp to account for the imprecision of the
+  // cached power
+  wMinus.f++;
+  wPlus.f--;
+
+  ShortestFloat result;
+  result.length = 0;
+  result.exponent = int16_t(-cached.k);
+  generateDigits(result, wMinus, w, wPlus);
+  return result;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
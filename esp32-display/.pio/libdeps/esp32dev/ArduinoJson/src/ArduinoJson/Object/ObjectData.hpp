@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Collection/CollectionData.hpp>
+#include <ArduinoJson/Strings/Adapters/HashedString.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -62,9 +63,23 @@ class ObjectData : public CollectionData {
     return obj->size(resources);
   }
 
+  // Records the hashes of the keys, so that lookups with a JsonKey compare
+  // characters only when the hashes match. Returns false if out of memory.
+  bool buildIndex(ResourceManager* resources) const;
+
+  static bool buildIndex(const ObjectData* obj, ResourceManager* resources) {
+    if (!obj)
+      return false;
+    return obj->buildIndex(resources);
+  }
+
  private:
   template <typename TAdaptedString>
   iterator findKey(TAdaptedString key, const ResourceManager* resources) const;
+
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+  iterator findKey(HashedString key, const ResourceManager* resources) const;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -43,6 +43,59 @@ inline ObjectData::iterator ObjectData::findKey(
   return iterator();
 }
 
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+inline ObjectData::iterator ObjectData::findKey(
+    HashedString key, const ResourceManager* resources) const {
+  auto entry = resources->objectIndex().find(this, head());
+  if (!entry)
+    return findKey<RamString>(key, resources);
+
+  // compare the hashes of the members in the index
+  for (SlotCount i = 0; i < entry->size; i++) {
+    if (entry->members[i].hash != key.hash())
+      continue;
+    auto slot = resources->getVariant(entry->members[i].key);
+    if (stringEquals(key, adaptString(slot->asString())))
+      return iteratorAt(slot, entry->members[i].key);
+  }
+
+  // then the members added since
+  SlotId id = head();
+  if (entry->size) {
+    auto lastKey = resources->getVariant(entry->members[entry->size - 1].key);
+    id = resources->getVariant(lastKey->next())->next();
+  }
+  while (id != NULL_SLOT) {
+    auto slot = resources->getVariant(id);
+    if (stringEquals(key, adaptString(slot->asString())))
+      return iteratorAt(slot, id);
+    id = resources->getVariant(slot->next())->next();
+  }
+  return iterator();
+}
+#endif
+
+inline bool ObjectData::buildIndex(ResourceManager* resources) const {
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+  auto& index = resources->objectIndex();
+  auto& entry = index.create(this, head());
+  for (SlotId id = head(); id != NULL_SLOT;) {
+    auto slot = resources->getVariant(id);
+    auto name = slot->asString();
+    if (!ObjectIndex::append(entry, hashBytes(name.c_str(), name.size()), id,
+                             resources->allocator())) {
+      index.invalidate(this);
+      return false;
+    }
+    id = resources->getVariant(slot->next())->next();
+  }
+  return true;
+#else
+  (void)resources;
+  return false;
+#endif
+}
+
 template <typename TAdaptedString>
 inline void ObjectData::removeMember(TAdaptedString key,
                                      ResourceManager* resources) {
@@ -37,6 +37,18 @@ inline float pgm_read(const float* p) {
   return pgm_read_float(p);
 }
 
+inline uint64_t pgm_read(const uint64_t* p) {
+  uint64_t value;
+  memcpy_P(&value, p, sizeof(value));
+  return value;
+}
+
+inline int16_t pgm_read(const int16_t* p) {
+  int16_t value;
+  memcpy_P(&value, p, sizeof(value));
+  return value;
+}
+
 #else
 
 #  ifndef ARDUINOJSON_DEFINE_PROGMEM_ARRAY
@@ -0,0 +1,251 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // offsetof
+#include <stdint.h>  // uint8_t
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An output buffer made of a list of blocks, so it never moves what's already
+// written. Unlike String, growing it doesn't copy, and it keeps its memory
+// between serializations.
+// The blocks can be sent with writeTo() or with writev() via toIovec().
+class JsonOutputBuffer {
+  struct Block {
+    Block* next;
+    size_t capacity;
+    size_t size;
+    char data[1];
+
+    static size_t sizeForCapacity(size_t n) {
+      return offsetof(Block, data) + n;
+    }
+  };
+
+ public:
+  explicit JsonOutputBuffer(
+      size_t blockSize = ARDUINOJSON_OUTPUT_BLOCK_SIZE,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator),
+        head_(nullptr),
+        current_(nullptr),
+        blockSize_(blockSize ? blockSize : 1),
+        overflowed_(false) {}
+
+  JsonOutputBuffer(const JsonOutputBuffer&) = delete;
+  JsonOutputBuffer& operator=(const JsonOutputBuffer&) = delete;
+
+  ~JsonOutputBuffer() {
+    release();
+  }
+
+  // Returns the number of bytes written
+  size_t size() const {
+    size_t n = 0;
+    for (auto block = head_; block; block = block->next) {
+      n += block->size;
+      if (block == current_)
+        break;
+    }
+    return n;
+  }
+
+  // Returns the number of blocks that hold data
+  size_t blockCount() const {
+    size_t n = 0;
+    for (auto block = head_; block && block->size; block = block->next) {
+      n++;
+      if (block == current_)
+        break;
+    }
+    return n;
+  }
+
+  // Returns the number of bytes that can be written without allocating
+  size_t capacity() const {
+    size_t n = 0;
+    for (auto block = head_; block; block = block->next)
+      n += block->capacity;
+    return n;
+  }
+
+  // Returns true if a write was cut short because a block couldn't be
+  // allocated, since the last clear()
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+  // Empties the buffer but keeps the blocks for the next serialization
+  void clear() {
+    for (auto block = head_; block; block = block->next)
+      block->size = 0;
+    current_ = head_;
+    overflowed_ = false;
+  }
+
+  // Empties the buffer and makes sure the first block can hold n bytes, so
+  // that a serialization of this size needs a single allocation (or none if
+  // the buffer is already big enough). A new block gets `slack` more bytes.
+  bool reserve(size_t n, size_t slack = 0) {
+    clear();
+    if (head_ && head_->capacity >= n)
+      return true;
+    release();
+    head_ = current_ = createBlock(n + slack < n ? n : n + slack);
+    return head_ != nullptr;
+  }
+
+  // Frees all the blocks
+  void release() {
+    while (head_) {
+      auto next = head_->next;
+      allocator_->deallocate(head_);
+      head_ = next;
+    }
+    current_ = nullptr;
+  }
+
+  size_t write(uint8_t c) {
+    if (!current_ || current_->size == current_->capacity) {
+      if (!nextBlock())
+        return 0;
+    }
+    current_->data[current_->size++] = static_cast<char>(c);
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    size_t written = 0;
+    while (written < n) {
+      if (!current_ || current_->size == current_->capacity) {
+        if (!nextBlock())
+          break;
+      }
+      size_t chunk = current_->capacity - current_->size;
+      if (chunk > n - written)
+        chunk = n - written;
+      memcpy(current_->data + current_->size, s + written, chunk);
+      current_->size += chunk;
+      written += chunk;
+    }
+    return written;
+  }
+
+  // Calls destination.write(data, size) once per block, like Print or
+  // Client do. Returns the number of bytes written.
+  template <typename TDestination>
+  size_t writeTo(TDestination& destination) const {
+    size_t n = 0;
+    for (auto block = head_; block && block->size; block = block->next) {
+      size_t written = destination.write(
+          reinterpret_cast<const uint8_t*>(block->data), block->size);
+      n += written;
+      if (written != block->size || block == current_)
+        break;
+    }
+    return n;
+  }
+
+  // Fills an array of struct iovec (or anything with iov_base and iov_len)
+  // for a scatter-gather write. Returns the number of entries filled.
+  template <typename TIovec>
+  size_t toIovec(TIovec* iov, size_t maxCount) const {
+    size_t n = 0;
+    for (auto block = head_; block && block->size && n < maxCount;
+         block = block->next) {
+      iov[n].iov_base = block->data;
+      iov[n].iov_len = block->size;
+      n++;
+      if (block == current_)
+        break;
+    }
+    return n;
+  }
+
+  // Copies the content to a contiguous buffer, and adds a null-terminator if
+  // there is room. Returns the number of bytes copied.
+  size_t copyTo(char* destination, size_t capacity) const {
+    size_t n = 0;
+    for (auto block = head_; block && block->size; block = block->next) {
+      size_t chunk = block->size < capacity - n ? block->size : capacity - n;
+      memcpy(destination + n, block->data, chunk);
+      n += chunk;
+      if (block == current_)
+        break;
+    }
+    if (n < capacity)
+      destination[n] = 0;
+    return n;
+  }
+
+ private:
+  Block* createBlock(size_t capacity) {
+    auto size = Block::sizeForCapacity(capacity);
+    if (size < capacity)  // integer overflow
+      return nullptr;
+    auto block = reinterpret_cast<Block*>(allocator_->allocate(size));
+    if (block) {
+      block->next = nullptr;
+      block->capacity = capacity;
+      block->size = 0;
+    }
+    return block;
+  }
+
+  // Moves to the next block, reusing the ones kept by clear()
+  bool nextBlock() {
+    if (current_ && current_->next) {
+      current_ = current_->next;
+      return true;
+    }
+    auto block = createBlock(blockSize_);
+    if (!block) {
+      overflowed_ = true;
+      return false;
+    }
+    if (current_)
+      current_->next = block;
+    else
+      head_ = block;
+    current_ = block;
+    return true;
+  }
+
+  Allocator* allocator_;
+  Block* head_;
+  Block* current_;  // the block being written
+  size_t blockSize_;
+  bool overflowed_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <>
+class Writer<JsonOutputBuffer, void> {
+ public:
+  explicit Writer(JsonOutputBuffer& output) : output_(&output) {
+    output.clear();
+  }
+
+  size_t write(uint8_t c) {
+    return output_->write(c);
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    return output_->write(s, n);
+  }
+
+ private:
+  JsonOutputBuffer* output_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Document/JsonDocument.hpp>
 #include <ArduinoJson/Serialization/Writer.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
@@ -41,6 +42,22 @@ enable_if_t<TSerializer<StaticStringWriter>::producesText, size_t> serialize(
   return n;
 }
 
+// Serializes the document in a single pass. The output buffer is pre-sized
+// from the previous serialization, with some slack for changing values; it's
+// only replaced when that size no longer fits. A serialization cut short by a
+// failed allocation keeps the previous hint.
+template <template <typename> class TSerializer>
+size_t serialize(JsonDocument& doc, JsonOutputBuffer& output) {
+  size_t hint = doc.serializedSizeHint();
+  if (hint)
+    output.reserve(hint, hint / 8);
+  Writer<JsonOutputBuffer> writer(output);
+  size_t n = doSerialize<TSerializer>(doc, writer);
+  if (!output.overflowed())
+    doc.setSerializedSizeHint(n);
+  return n;
+}
+
 template <template <typename> class TSerializer, typename TChar, size_t N>
 enable_if_t<IsChar<TChar>::value, size_t> serialize(
     ArduinoJson::JsonVariantConst source, TChar (&buffer)[N]) {
@@ -0,0 +1,35 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Strings/Adapters/RamString.hpp>
+#include <ArduinoJson/Strings/JsonKey.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A string that comes with its hash (see JsonKey)
+class HashedString : public RamString {
+ public:
+  HashedString(const char* str, size_t sz, uint32_t hash)
+      : RamString(str, sz), hash_(hash) {}
+
+  uint32_t hash() const {
+    return hash_;
+  }
+
+ private:
+  uint32_t hash_;
+};
+
+template <>
+struct StringAdapter<JsonKey> {
+  using AdaptedString = HashedString;
+
+  static AdaptedString adapt(const JsonKey& key) {
+    return HashedString(key.c_str(), key.size(), key.hash());
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,259 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Array/JsonArray.hpp>
+#include <ArduinoJson/Array/JsonSpan.hpp>
+#include <ArduinoJson/Object/JsonObject.hpp>
+#include <ArduinoJson/Variant/JsonVariant.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The JSON Pointer (RFC 6901) of the value being patched
+class PatchPath {
+ public:
+  PatchPath() : length_(0) {
+    buffer_[0] = 0;
+  }
+
+  const char* c_str() const {
+    return buffer_;
+  }
+
+  size_t size() const {
+    return length_;
+  }
+
+  // Appends "/key", escaping '~' and '/'.
+  // Returns false, and leaves the path unchanged, if it doesn't fit.
+  bool push(JsonString key) {
+    size_t n = length_;
+    bool ok = append(n, '/');
+    for (size_t i = 0; ok && i < key.size(); i++) {
+      char c = key.c_str()[i];
+      if (c == '~')
+        ok = append(n, '~') && append(n, '0');
+      else if (c == '/')
+        ok = append(n, '~') && append(n, '1');
+      else
+        ok = append(n, c);
+    }
+    if (ok)
+      length_ = n;
+    buffer_[length_] = 0;
+    return ok;
+  }
+
+  void truncate(size_t length) {
+    ARDUINOJSON_ASSERT(length <= length_);
+    length_ = length;
+    buffer_[length_] = 0;
+  }
+
+ private:
+  bool append(size_t& n, char c) {
+    if (n + 1 >= sizeof(buffer_))
+      return false;
+    buffer_[n++] = c;
+    return true;
+  }
+
+  char buffer_[ARDUINOJSON_PATCH_PATH_SIZE];
+  size_t length_;
+};
+
+struct NoPatchCallback {
+  void operator()(const char*) const {}
+};
+
+// Applies a merge patch in place: members that don't change are left alone,
+// and the others reuse their slot.
+template <typename TCallback>
+class MergePatcher {
+ public:
+  MergePatcher(TCallback& onChange) : onChange_(onChange), ok_(true) {}
+
+  bool ok() const {
+    return ok_;
+  }
+
+  // Returns true if the target changed.
+  // Changes are reported only if `report` is true; otherwise, an ancestor has
+  // already been reported.
+  bool merge(JsonVariant target, JsonVariantConst patch, bool report) {
+    JsonObjectConst members = patch.as<JsonObjectConst>();
+    if (!members)
+      return replace(target, patch, report);
+
+    bool changed = false;
+    JsonObject object = target.as<JsonObject>();
+    if (!object) {
+      object = target.to<JsonObject>();
+      if (!object) {
+        ok_ = false;
+        return false;
+      }
+      notify(report);
+      report = false;
+      changed = true;
+    }
+
+    // a change deeper than ARDUINOJSON_PATCH_PATH_SIZE is reported here
+    bool truncated = false;
+
+    for (JsonPairConst member : members) {
+      size_t length = path_.size();
+      bool fits = path_.push(member.key());
+      if (mergeMember(object, member, report && fits)) {
+        changed = true;
+        truncated |= !fits;
+      }
+      path_.truncate(length);
+    }
+
+    if (truncated)
+      notify(report);
+    return changed;
+  }
+
+ private:
+  bool mergeMember(JsonObject object, JsonPairConst member, bool report) {
+    JsonString key = member.key();
+    JsonVariantConst value = member.value();
+    JsonVariant child = object[key];
+
+    if (value.isNull()) {
+      if (child.isUnbound())
+        return false;
+      object.remove(key);
+      notify(report);
+      return true;
+    }
+
+    if (child.isUnbound()) {
+      // copy the key since the patch usually doesn't outlive the target
+      child = object[JsonString(key.c_str(), key.size())].to<JsonVariant>();
+      if (child.isUnbound()) {
+        ok_ = false;
+        return false;
+      }
+    }
+
+    return merge(child, value, report);
+  }
+
+  bool replace(JsonVariant target, JsonVariantConst value, bool report) {
+    if (equals(target, value))
+      return false;
+    if (!copy(target, value))
+      ok_ = false;
+    notify(report);
+    return true;
+  }
+
+  static bool equals(JsonVariantConst a, JsonVariantConst b) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    // compare packed arrays without unpacking them
+    auto x = VariantAttorney::getData(a);
+    auto y = VariantAttorney::getData(b);
+    bool xPacked = x && x->isPackedArray();
+    bool yPacked = y && y->isPackedArray();
+    if (xPacked || yPacked) {
+      if (!xPacked || !yPacked)
+        return false;
+      PackedArrayData p = x->asPackedArray();
+      PackedArrayData q = y->asPackedArray();
+      return p.type() == q.type() && p.size() == q.size() &&
+             memcmp(p.data(), q.data(),
+                    p.size() * packedElementSize(p.type())) == 0;
+    }
+#endif
+    return a == b;
+  }
+
+  // Unlike JsonVariant::set(), never links to the strings of the source
+  static bool copy(JsonVariant dst, JsonVariantConst src) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (src.is<JsonSpan<float>>())
+      return dst.set(src.as<JsonSpan<float>>());
+    if (src.is<JsonSpan<int32_t>>())
+      return dst.set(src.as<JsonSpan<int32_t>>());
+#  if ARDUINOJSON_USE_DOUBLE
+    if (src.is<JsonSpan<double>>())
+      return dst.set(src.as<JsonSpan<double>>());
+#  endif
+#endif
+
+    JsonObjectConst object = src.as<JsonObjectConst>();
+    if (object) {
+      JsonObject dstObject = dst.to<JsonObject>();
+      if (!dstObject)
+        return false;
+      for (JsonPairConst member : object) {
+        JsonString key = member.key();
+        JsonVariant dstMember =
+            dstObject[JsonString(key.c_str(), key.size())].to<JsonVariant>();
+        if (!copy(dstMember, member.value()))
+          return false;
+      }
+      return true;
+    }
+
+    JsonArrayConst array = src.as<JsonArrayConst>();
+    if (array) {
+      JsonArray dstArray = dst.to<JsonArray>();
+      if (!dstArray)
+        return false;
+      for (JsonVariantConst element : array) {
+        if (!copy(dstArray.add<JsonVariant>(), element))
+          return false;
+      }
+      return true;
+    }
+
+    if (src.is<JsonString>()) {
+      JsonString str = src.as<JsonString>();
+      return dst.set(JsonString(str.c_str(), str.size()));
+    }
+
+    return dst.set(src);
+  }
+
+  void notify(bool report) {
+    if (report)
+      onChange_(path_.c_str());
+  }
+
+  TCallback& onChange_;
+  PatchPath path_;
+  bool ok_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Applies a JSON Merge Patch (RFC 7396) to a variant, in place.
+// Calls onChange(const char* path) with the JSON Pointer (RFC 6901) of each
+// value that changed; members of a new or replaced value aren't reported.
+// Returns false if there isn't enough memory; the target is then partially
+// patched.
+template <typename TCallback>
+inline bool mergePatch(JsonVariant target, JsonVariantConst patch,
+                       TCallback onChange) {
+  if (target.isUnbound())
+    return false;
+  detail::MergePatcher<TCallback> patcher(onChange);
+  patcher.merge(target, patch, true);
+  return patcher.ok();
+}
+
+// Applies a JSON Merge Patch (RFC 7396) to a variant, in place.
+// Returns false if there isn't enough memory.
+inline bool mergePatch(JsonVariant target, JsonVariantConst patch) {
+  return mergePatch(target, patch, detail::NoPatchCallback());
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -80,6 +80,63 @@ struct Comparer<nullptr_t, void> : NullComparer {
   explicit Comparer(nullptr_t) : NullComparer() {}
 };
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+// Compares a value with an element of a packed array, which has no slot
+struct PackedElementComparer : ComparerBase {
+  PackedArrayData array_;
+  size_t index_;
+
+  PackedElementComparer(const PackedArrayData& array, size_t index)
+      : array_(array), index_(index) {}
+
+  template <typename T>
+  enable_if_t<is_floating_point<T>::value || is_integral<T>::value,
+              CompareResult>
+  visit(const T& lhs) {
+    Comparer<T> comparer(lhs);
+    return array_.visitElement(index_, comparer);
+  }
+
+  template <typename T>
+  enable_if_t<!is_floating_point<T>::value && !is_integral<T>::value,
+              CompareResult>
+  visit(const T& lhs) {
+    return ComparerBase::visit(lhs);
+  }
+};
+
+struct PackedArrayComparer : ComparerBase {
+  PackedArrayData rhs_;
+
+  explicit PackedArrayComparer(const PackedArrayData& rhs) : rhs_(rhs) {}
+
+  CompareResult visit(JsonArrayConst lhs) {
+    if (lhs.size() != rhs_.size())
+      return COMPARE_RESULT_DIFFER;
+    size_t i = 0;
+    for (JsonVariantConst element : lhs) {
+      PackedElementComparer comparer(rhs_, i++);
+      if (accept(element, comparer) != COMPARE_RESULT_EQUAL)
+        return COMPARE_RESULT_DIFFER;
+    }
+    return COMPARE_RESULT_EQUAL;
+  }
+
+  CompareResult visit(const PackedArrayData& lhs) {
+    if (lhs.size() != rhs_.size())
+      return COMPARE_RESULT_DIFFER;
+    for (size_t i = 0; i < lhs.size(); i++) {
+      PackedElementComparer comparer(rhs_, i);
+      if (lhs.visitElement(i, comparer) != COMPARE_RESULT_EQUAL)
+        return COMPARE_RESULT_DIFFER;
+    }
+    return COMPARE_RESULT_EQUAL;
+  }
+
+  using ComparerBase::visit;
+};
+#endif
+
 struct ArrayComparer : ComparerBase {
   JsonArrayConst rhs_;
 
@@ -92,6 +149,13 @@ struct ArrayComparer : ComparerBase {
       return COMPARE_RESULT_DIFFER;
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  CompareResult visit(const PackedArrayData& lhs) {
+    PackedArrayComparer comparer(lhs);
+    return comparer.visit(rhs_);
+  }
+#endif
+
   using ComparerBase::visit;
 };
 
@@ -144,6 +208,13 @@ struct VariantComparer : ComparerBase {
     return reverseResult(comparer);
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  CompareResult visit(const PackedArrayData& lhs) {
+    PackedArrayComparer comparer(lhs);
+    return reverseResult(comparer);
+  }
+#endif
+
   CompareResult visit(JsonFloat lhs) {
     Comparer<JsonFloat> comparer(lhs);
     return reverseResult(comparer);
@@ -35,12 +35,12 @@ class VariantRefBase : public VariantTag {
   // Returns true if the value is null or the reference is unbound.
   // https://arduinojson.org/v7/api/jsonvariant/isnull/
   bool isNull() const {
-    return VariantData::isNull(getData());
+    return getVariantConst().isNull();
   }
 
   // Returns true if the reference is unbound.
   bool isUnbound() const {
-    return !getData();
+    return getVariantConst().isUnbound();
   }
 
   // Casts the value to the specified type.
@@ -277,7 +277,12 @@ class VariantRefBase : public VariantTag {
 
   FORCE_INLINE ArduinoJson::JsonVariant getVariant() const;
 
+  // ElementProxy has its own, for elements of a packed array
   FORCE_INLINE ArduinoJson::JsonVariantConst getVariantConst() const {
+    return derived().readVariantConst();
+  }
+
+  FORCE_INLINE ArduinoJson::JsonVariantConst readVariantConst() const {
     return ArduinoJson::JsonVariantConst(getData(), getResourceManager());
   }
 
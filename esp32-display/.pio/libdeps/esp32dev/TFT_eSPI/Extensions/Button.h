@@ -8,6 +8,8 @@
 
 class TFT_eSPI_Button
 {
+  friend class TFT_eSPI_Gesture; // Hit tests and redraws buttons
+
  public:
   TFT_eSPI_Button(void);
   // "Classic" initButton() uses centre & size
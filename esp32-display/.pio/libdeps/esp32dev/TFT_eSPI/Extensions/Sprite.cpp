@@ -703,6 +703,31 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp)
 }
 
 
+/***************************************************************************************
+** Function name:           pushSpriteDMA
+** Description:             Push the sprite to the TFT at x, y using DMA
+***************************************************************************************/
+void TFT_eSprite::pushSpriteDMA(int32_t x, int32_t y)
+{
+  if (!_created) return;
+
+#if defined (ESP32_DMA) || defined (RP2040_DMA) || (defined (STM32_DMA) && !defined (TFT_PARALLEL_8_BIT))
+  if (_tft->DMA_Enabled && _bpp != 1)
+  {
+    bool oldSwapBytes = _tft->getSwapBytes();
+    _tft->setSwapBytes(false); // 16 bpp sprites are stored in TFT byte order
+    if (_bpp == 16)     _tft->pushStripsDMA(x, y, _dwidth, _dheight, (uint8_t*)_img, 16, nullptr);
+    else if (_bpp == 8) _tft->pushStripsDMA(x, y, _dwidth, _dheight, _img8, 8, nullptr);
+    else                _tft->pushStripsDMA(x, y, _dwidth, _dheight, _img4, 4, _colorMap);
+    _tft->setSwapBytes(oldSwapBytes);
+    return;
+  }
+#endif
+
+  pushSprite(x, y);
+}
+
+
 /***************************************************************************************
 ** Function name:           pushToSprite
 ** Description:             Push the sprite to another sprite at x, y
@@ -1411,6 +1436,105 @@ void TFT_eSprite::setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint
 }
 
 
+/***************************************************************************************
+** Function name:           bitsAt
+** Description:             8 bits of a line starting at bit p, bytes outside lo-hi read as 0
+***************************************************************************************/
+static inline uint8_t bitsAt(const uint8_t* line, int32_t p, int32_t lo, int32_t hi)
+{
+  int32_t i = p >> 3;   // Arithmetic shift, p may be negative
+  uint8_t s = p & 0x07;
+  uint16_t v = 0;
+  if (i >= lo && i <= hi)             v  = line[i] << 8;
+  if (s && i + 1 >= lo && i + 1 <= hi) v |= line[i + 1];
+  return (uint8_t)(v >> (8 - s));
+}
+
+
+/***************************************************************************************
+** Function name:           moveBits
+** Description:             Move n bits from bit fb of line from to bit tb of line to
+***************************************************************************************/
+// Bits are numbered from the MSB of the first byte, as 1 and 4 bpp sprite pixels are.
+// The lines may be the same line, the bits around the destination are left unchanged.
+static void moveBits(uint8_t* to, uint32_t tb, const uint8_t* from, uint32_t fb, uint32_t n)
+{
+  if (n == 0 || (to == from && tb == fb)) return;
+
+  int32_t first = tb >> 3;             // First and last destination bytes
+  int32_t last  = (tb + n - 1) >> 3;
+  uint8_t headMask = 0xFF >> (tb & 0x07);
+  uint8_t tailMask = 0xFF << (7 - ((tb + n - 1) & 0x07));
+
+  if (((tb ^ fb) & 0x07) == 0)
+  { // Same bit position within a byte, the whole bytes can be moved with memmove
+    const uint8_t* src = from + (fb >> 3);
+    if (first == last) {
+      headMask &= tailMask;
+      to[first] = (to[first] & ~headMask) | (src[0] & headMask);
+      return;
+    }
+    uint8_t head = src[0];
+    uint8_t tail = src[last - first];
+    memmove(to + first + 1, src + 1, last - first - 1);
+    to[first] = (to[first] & ~headMask) | (head & headMask);
+    to[last]  = (to[last]  & ~tailMask) | (tail & tailMask);
+    return;
+  }
+
+  // Otherwise each destination byte is made of two source bytes, shifted
+  int32_t d  = (int32_t)fb - (int32_t)tb; // Offset to the source bit
+  int32_t lo = fb >> 3;                   // Source bytes that can be read
+  int32_t hi = (fb + n - 1) >> 3;
+  uint8_t s  = d & 0x07;                  // Same shift for every byte
+
+  if (first == last) {
+    headMask &= tailMask;
+    to[first] = (to[first] & ~headMask) | (bitsAt(from, 8 * first + d, lo, hi) & headMask);
+    return;
+  }
+
+  // In the same line, copy in the direction that reads each byte before it is overwritten
+  if (to != from || d > 0)
+  { // Left to right
+    uint8_t head = bitsAt(from, 8 * first + d, lo, hi);
+    to[first] = (to[first] & ~headMask) | (head & headMask);
+
+    // Shift-and-carry over the whole bytes, every source byte is read once
+    const uint8_t* src = from + ((8 * (first + 1) + d) >> 3);
+    uint8_t  carry = *src++;
+    uint8_t* dst   = to + first + 1;
+    uint8_t* end   = to + last;
+    while (dst < end) {
+      uint8_t next = *src++;
+      *dst++ = (uint8_t)(carry << s | next >> (8 - s));
+      carry  = next;
+    }
+
+    uint8_t tail = bitsAt(from, 8 * last + d, lo, hi);
+    to[last] = (to[last] & ~tailMask) | (tail & tailMask);
+  }
+  else
+  { // Right to left
+    uint8_t tail = bitsAt(from, 8 * last + d, lo, hi);
+    to[last] = (to[last] & ~tailMask) | (tail & tailMask);
+
+    const uint8_t* src = from + ((8 * (last - 1) + d) >> 3);
+    uint8_t  carry = src[1];
+    uint8_t* dst   = to + last - 1;
+    uint8_t* end   = to + first;
+    while (dst > end) {
+      uint8_t prev = *src--;
+      *dst-- = (uint8_t)(prev << s | carry >> (8 - s));
+      carry  = prev;
+    }
+
+    uint8_t head = bitsAt(from, 8 * first + d, lo, hi);
+    to[first] = (to[first] & ~headMask) | (head & headMask);
+  }
+}
+
+
 /***************************************************************************************
 ** Function name:           scroll
 ** Description:             Scroll dx,dy pixels, positive right,down, negative left,up
@@ -1470,24 +1594,24 @@ void TFT_eSprite::scroll(int16_t dx, int16_t dy)
       fyp += iw;
     }
   }
-  else if (_bpp == 4)
+  else if (_bpp == 4 || (_bpp == 1 && rotation == 0))
   {
-    // could optimize for scrolling by even # pixels using memove (later)
-    if (dx >  0) { tx += w; fx += w; } // Start from right edge
+    // Pixels are packed MSB first, so each line is moved as a bit field
+    int32_t  stride = (_bpp == 4) ? _iwidth >> 1 : _bitwidth >> 3; // Bytes per line
+    uint8_t* img    = (_bpp == 4) ? _img4 : _img8;
+    uint8_t* to     = img + ty * stride;
+    uint8_t* from   = img + fy * stride;
+    if (dy > 0) stride = -stride;
     while (h--)
-    { // move pixels one by one
-      for (uint16_t xp = 0; xp < w; xp++)
-      {
-        if (dx <= 0) drawPixel(tx + xp, ty, readPixelValue(fx + xp, fy));
-        if (dx >  0) drawPixel(tx - xp, ty, readPixelValue(fx - xp, fy));
-      }
-      if (dy <= 0)  { ty++; fy++; }
-      else  { ty--; fy--; }
+    {
+      moveBits(to, tx * _bpp, from, fx * _bpp, w * _bpp);
+      to   += stride;
+      from += stride;
     }
   }
-  else if (_bpp == 1 )
-  {
-    if (dx >  0) { tx += w; fx += w; } // Start from right edge
+  else if (_bpp == 1)
+  { // Rotated 1 bpp sprite, lines are not contiguous in RAM
+    if (dx >  0) { tx += w - 1; fx += w - 1; } // Start from right edge
     while (h--)
     { // move pixels one by one
       for (uint16_t xp = 0; xp < w; xp++)
@@ -2448,7 +2572,10 @@ void TFT_eSprite::drawGlyph(uint16_t code)
   uint16_t gNum = 0;
   bool found = getUnicodeIndex(code, &gNum);
 
-  if (found)
+  // For a font file, this reads the whole bitmap
+  const uint8_t* gPtr = found ? getGlyphBitmap(gNum) : nullptr;
+
+  if (gPtr)
   {
 
     bool newSprite = !_created;
@@ -2475,16 +2602,6 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       if ( cursor_x == 0) cursor_x -= gdX[gNum];
     }
 
-    uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
-
-#ifdef FONT_FS_AVAILABLE
-    if (fs_font) {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
-    }
-#endif
-
     int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
     int16_t cx = cursor_x + gdX[gNum];
 
@@ -2527,19 +2644,9 @@ void TFT_eSprite::drawGlyph(uint16_t code)
 
     for (int32_t y = 0; y < gHeight[gNum]; y++)
     {
-#ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
-        fontFile.read(pbuffer, gWidth[gNum]);
-      }
-#endif
-
       for (int32_t x = 0; x < gWidth[gNum]; x++)
       {
-#ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
-#endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
 
         if (pixel)
         {
@@ -2583,7 +2690,6 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       }
     }
 
-    if (pbuffer) free(pbuffer);
     cursor_x += gxAdvance[gNum];
 
     if (newSprite)
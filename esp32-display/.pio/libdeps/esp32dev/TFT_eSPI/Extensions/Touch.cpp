@@ -15,6 +15,15 @@
   #define Z_THRESHOLD 350 // Touch pressure threshold for validating touches
 #endif
 
+// Minimum time between two samples taken by serviceTouch()
+#ifndef TOUCH_SAMPLE_INTERVAL
+  #define TOUCH_SAMPLE_INTERVAL 5 // ms
+#endif
+
+#ifndef IRAM_ATTR
+  #define IRAM_ATTR
+#endif
+
 /***************************************************************************************
 ** Function name:           begin_touch_read_write - was spi_begin_touch
 ** Description:             Start transaction and select touch controller
@@ -168,6 +177,19 @@ uint8_t TFT_eSPI::validTouch(uint16_t *x, uint16_t *y, uint16_t threshold){
 ***************************************************************************************/
 uint8_t TFT_eSPI::getTouch(uint16_t *x, uint16_t *y, uint16_t threshold){
   uint16_t x_tmp, y_tmp;
+
+  // Latest filtered position if beginTouchSampling() has been called
+  if (_touchSampling) {
+    serviceTouch();
+    if (!touchSampler.getPosition(&x_tmp, &y_tmp)) return false;
+    convertRawXY(&x_tmp, &y_tmp);
+    if (x_tmp >= _width || y_tmp >= _height) return false;
+    _pressX = x_tmp;
+    _pressY = y_tmp;
+    *x = _pressX;
+    *y = _pressY;
+    return true;
+  }
   
   if (threshold<20) threshold = 20;
   if (_pressTime > millis()) threshold=20;
@@ -194,6 +216,94 @@ uint8_t TFT_eSPI::getTouch(uint16_t *x, uint16_t *y, uint16_t threshold){
   return valid;
 }
 
+/***************************************************************************************
+** Function name:           beginTouchSampling
+** Description:             start non-blocking touch sampling by serviceTouch()
+***************************************************************************************/
+void TFT_eSPI::beginTouchSampling(uint16_t threshold){
+  touchSampler.setThreshold(threshold);
+  touchSampler.reset();
+  _touchSampleTime = millis() - TOUCH_SAMPLE_INTERVAL;
+
+#ifdef TOUCH_IRQ
+  // PENIRQ is low while the screen is touched
+  pinMode(TOUCH_IRQ, INPUT);
+  _touchIrq = false;
+  attachInterrupt(digitalPinToInterrupt(TOUCH_IRQ), touchIrqHandler, FALLING);
+#endif
+
+  _touchSampling = true;
+}
+
+/***************************************************************************************
+** Function name:           endTouchSampling
+** Description:             stop non-blocking touch sampling
+***************************************************************************************/
+void TFT_eSPI::endTouchSampling(void){
+#ifdef TOUCH_IRQ
+  detachInterrupt(digitalPinToInterrupt(TOUCH_IRQ));
+#endif
+  touchSampler.reset();
+  _touchSampling = false;
+}
+
+#ifdef TOUCH_IRQ
+volatile bool TFT_eSPI::_touchIrq = false;
+
+/***************************************************************************************
+** Function name:           touchIrqHandler
+** Description:             pen interrupt, makes the next serviceTouch() take a sample
+***************************************************************************************/
+void IRAM_ATTR TFT_eSPI::touchIrqHandler(void){
+  _touchIrq = true;
+}
+#endif
+
+/***************************************************************************************
+** Function name:           serviceTouch
+** Description:             take a raw sample if one is due, never waits
+***************************************************************************************/
+bool TFT_eSPI::serviceTouch(void){
+  if (!_touchSampling) return false;
+
+#ifdef TOUCH_IRQ
+  // Nothing is read from the controller while the screen is not touched
+  if (!_touchIrq && !touchSampler.isActive() && digitalRead(TOUCH_IRQ)) return false;
+#endif
+
+  uint32_t now = millis();
+  if (now - _touchSampleTime < TOUCH_SAMPLE_INTERVAL) return false;
+  _touchSampleTime = now;
+
+#ifdef TOUCH_IRQ
+  _touchIrq = false;
+#endif
+
+  // The touch controller shares the TFT SPI bus, so it is sampled here between
+  // TFT transactions rather than from an interrupt or another task. A touch that
+  // starts and ends between two calls is missed; a controller on a bus of its own
+  // can be sampled from a task woken by PENIRQ instead
+  uint16_t x = 0, y = 0;
+  uint16_t z = getTouchRawZ();
+  if (z) getTouchRaw(&x, &y);
+
+  return touchSampler.addSample(x, y, z, now);
+}
+
+/***************************************************************************************
+** Function name:           getTouchEvent
+** Description:             get the next touch event in screen coordinates
+***************************************************************************************/
+bool TFT_eSPI::getTouchEvent(touch_event_t *event){
+  if (!touchSampler.getEvent(event)) return false;
+
+  // Up events must not be lost, so off screen positions are clipped rather than ignored
+  convertRawXY(&event->x, &event->y);
+  if (event->x >= _width)  event->x = (event->x & 0x8000) ? 0 : _width  - 1;
+  if (event->y >= _height) event->y = (event->y & 0x8000) ? 0 : _height - 1;
+  return true;
+}
+
 /***************************************************************************************
 ** Function name:           convertRawXY
 ** Description:             convert raw touch x,y values to screen coordinates 
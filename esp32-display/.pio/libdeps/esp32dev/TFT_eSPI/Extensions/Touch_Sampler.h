@@ -0,0 +1,88 @@
+ // This is part of the TFT_eSPI library and is associated with the Touch Screen handlers
+ // See license in root directory.
+
+/***************************************************************************************
+// The touch sampler filters a stream of raw XPT2046 samples (x, y, z) and turns it into
+// a filtered touch state plus a queue of time stamped down/move/up events. It does no
+// SPI access itself so the caller decides when and where samples are taken, and it can
+// be fed synthetic samples for testing.
+***************************************************************************************/
+
+// Size of the touch event queue, must be a power of 2
+#ifndef TOUCH_EVENT_QUEUE
+  #define TOUCH_EVENT_QUEUE 16
+#endif
+static_assert(TOUCH_EVENT_QUEUE >= 2 && (TOUCH_EVENT_QUEUE & (TOUCH_EVENT_QUEUE - 1)) == 0,
+              "TOUCH_EVENT_QUEUE must be a power of 2");
+
+// Samples ignored after the pressure rises above the threshold, to let the pressure settle
+#ifndef TOUCH_SETTLE_SAMPLES
+  #define TOUCH_SETTLE_SAMPLES 2
+#endif
+
+// Consecutive samples below half the threshold that end a touch
+#ifndef TOUCH_RELEASE_SAMPLES
+  #define TOUCH_RELEASE_SAMPLES 2
+#endif
+
+// IIR filter weight of a new sample is 1/(2^TOUCH_IIR_SHIFT), 0 disables the filter
+#ifndef TOUCH_IIR_SHIFT
+  #define TOUCH_IIR_SHIFT 2
+#endif
+
+// Minimum change in filtered raw position that generates a move event
+#ifndef TOUCH_MOVE_DEADBAND
+  #define TOUCH_MOVE_DEADBAND 8
+#endif
+
+#define TOUCH_EVENT_DOWN 1
+#define TOUCH_EVENT_MOVE 2
+#define TOUCH_EVENT_UP   3
+
+typedef struct {
+  uint8_t  type;     // TOUCH_EVENT_DOWN, TOUCH_EVENT_MOVE or TOUCH_EVENT_UP
+  uint16_t x, y;     // Raw position, or screen position once returned by getTouchEvent()
+  uint32_t time;     // millis() time stamp of the sample
+} touch_event_t;
+
+class TFT_eSPI_TouchSampler
+{
+ public:
+  TFT_eSPI_TouchSampler(void);
+
+           // Pressure threshold of a touch, a touch ends below half of this value
+  void     setThreshold(uint16_t threshold);
+
+           // Process one raw sample, returns true if the touch state changed
+  bool     addSample(uint16_t x, uint16_t y, uint16_t z, uint32_t time);
+           // Forget the current touch without generating an up event, queued events are kept
+  void     reset(void);
+
+           // Latest filtered raw position, returns false if the screen is not touched
+  bool     getPosition(uint16_t *x, uint16_t *y);
+  bool     isPressed(void) { return _pressed; }
+           // True while a touch is in progress or is being validated
+  bool     isActive(void)  { return _pressed || _count; }
+
+           // Pop the oldest event, returns false if the queue is empty
+           // Events are dropped if the queue is full, see overruns()
+  bool     getEvent(touch_event_t *event);
+  uint16_t eventsAvailable(void);
+  uint16_t overruns(void) { return _overruns; }
+
+ private:
+  void     pushEvent(uint8_t type, uint32_t time);
+  uint16_t median(const uint16_t *v);
+
+  uint16_t _threshold;
+  bool     _pressed;
+  uint8_t  _count;                 // Samples taken since the pressure crossed the threshold
+  uint8_t  _released;              // Consecutive samples below the release threshold
+  uint16_t _rawX[3], _rawY[3];     // Median window
+  uint32_t _filterX, _filterY;     // IIR filtered position, with TOUCH_IIR_SHIFT fraction bits
+  uint16_t _reportX, _reportY;     // Position of the last event
+
+  touch_event_t    _events[TOUCH_EVENT_QUEUE];
+  volatile uint16_t _head, _tail;  // Written by the producer and the consumer only
+  uint16_t         _overruns;
+};
@@ -13,6 +13,7 @@
 // Include processor specific header
 #include "soc/spi_reg.h"
 #include "driver/spi_master.h"
+#include "esp_heap_caps.h"
 #include "hal/gpio_ll.h"
 
 #if !defined(CONFIG_IDF_TARGET_ESP32S3) && !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32)
@@ -153,6 +154,11 @@ SPI3_HOST = 2
   #include <FS.h>
   #include "SPIFFS.h" // ESP32 only
   #define FONT_FS_AVAILABLE
+
+  // Fonts packed in a data partition can be memory mapped, see Tools/Pack_Smooth_Fonts
+  #include "esp_idf_version.h"
+  #include "esp_partition.h"
+  #define FONT_PARTITION_AVAILABLE
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////
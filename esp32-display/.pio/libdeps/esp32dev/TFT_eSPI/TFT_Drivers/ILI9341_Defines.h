@@ -53,6 +53,11 @@
 #define TFT_RAMRD   0x2E
 #define TFT_IDXRD   0xDD // ILI9341 only, indexed control register read
 
+// Hardware vertical scrolling, the areas add up to TFT_VSCR_LINES frame memory lines
+#define TFT_VSCRDEF    0x33
+#define TFT_VSCRSADD   0x37
+#define TFT_VSCR_LINES 320
+
 #define TFT_MADCTL  0x36
 #define TFT_MAD_MY  0x80
 #define TFT_MAD_MX  0x40
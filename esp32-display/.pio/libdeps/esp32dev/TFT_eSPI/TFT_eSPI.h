@@ -145,6 +145,12 @@
   #define SPI_BUSY_CHECK
 #endif
 
+// Size in pixels of each of the two bounce buffers used to push 4 and 8 bpp images with DMA,
+// a strip of the image holds DMA_BOUNCE_PIXELS / width lines (at least one line)
+#ifndef DMA_BOUNCE_PIXELS
+  #define DMA_BOUNCE_PIXELS 2048
+#endif
+
 // If half duplex SDA mode is defined then MISO pin should be -1
 #ifdef TFT_SDA_READ
   #ifdef TFT_MISO
@@ -167,6 +173,14 @@
   #endif
 #endif
 
+// Number of glyph bitmaps a smooth font loaded from a file keeps in RAM, the least
+// recently used one being replaced. 0 reads the bitmap from the file for every glyph
+#ifdef SMOOTH_FONT
+  #ifndef SMOOTH_FONT_CACHE_GLYPHS
+    #define SMOOTH_FONT_CACHE_GLYPHS 0
+  #endif
+#endif
+
 // Only load the fonts defined in User_Setup.h (to save space)
 // Set flag so RLE rendering code is optionally compiled
 #ifdef LOAD_GLCD
@@ -423,6 +437,10 @@ int16_t tch_spi_freq;// Touch controller read/write SPI frequency
 // Callback prototype for smooth font pixel colour read
 typedef uint16_t (*getColorCallback)(uint16_t x, uint16_t y);
 
+// Load the touch sampler class, used by the Touch extension and able to filter samples
+// from a touch controller on another bus
+#include "Extensions/Touch_Sampler.h"
+
 // Class functions and variables
 class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has access to protected members
 
@@ -471,6 +489,14 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   void     invertDisplay(bool i);  // Tell TFT to invert all displayed colours
 
+#ifdef TFT_VSCRDEF
+  // Hardware vertical scrolling. Lines are counted from the top in rotation 0; the
+  // fixed areas stay put and the lines between them scroll up, wrapping round
+  void     setScrollArea(uint16_t tfa, uint16_t bfa); // Fixed lines at the top and bottom
+  void     scrollTo(uint16_t offset);                 // Scroll the area up by offset lines
+  void     resetScrollArea(void);                     // Whole screen fixed again
+#endif
+
 
   // The TFT_eSprite class inherits the following functions (not all are useful to Sprite class
   void     setAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h); // Note: start coordinates + width and height
@@ -791,6 +817,13 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Push a block of pixels into a window set up using setAddrWindow()
   void     pushPixelsDMA(uint16_t* image, uint32_t len);
 
+           // Push a 4 bpp (bpp8 false, colour map cmap) or 8 bpp (bpp8 true, RGB332 or colour map cmap)
+           // image using DMA. Each strip of the image is expanded to 16 bits in one of two bounce buffers
+           // while the previous strip is sent, so the image is not modified and can be drawn into again
+           // as soon as the function returns. The bounce buffers are allocated on first use.
+           // If called inside startWrite()/endWrite() the last strip is still being sent on return.
+  void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* data, bool bpp8, uint16_t* cmap = nullptr);
+
            // Check if the DMA is complete - use while(tft.dmaBusy); for a blocking wait
   bool     dmaBusy(void); // returns true if DMA is still in progress
   void     dmaWait(void); // wait until DMA is complete
@@ -876,6 +909,15 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Smooth graphics helper
   uint8_t  sqrt_fraction(uint32_t num);
 
+           // Push a 4, 8 or 16 bpp image with DMA through the bounce buffers, see pushImageDMA()
+  void     pushStripsDMA(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t* data, uint8_t bpp, uint16_t* cmap);
+  uint16_t* _dmaBounce = nullptr; // Two bounce buffers of _dmaBounceSize pixels
+  uint32_t _dmaBounceSize = 0;
+  uint8_t  _dmaBounceNext = 0;    // Buffer for the next strip, the other one may still be in use
+
+  uint16_t _scrollTop = 0;        // Hardware scroll area start and number of lines
+  uint16_t _scrollLines = 0;
+
            // Helper function: calculate distance of a point from a finite length line between two points
   float    wedgeLineDistance(float pax, float pay, float bax, float bay, float dr);
 
@@ -1005,6 +1047,9 @@ fastBlend(A alpha, F fgc, B bgc)
 // Load the Button Class
 #include "Extensions/Button.h"
 
+// Load the touch Gesture Class
+#include "Extensions/Gesture.h"
+
 // Load the Sprite Class
 #include "Extensions/Sprite.h"
 
@@ -42,6 +42,16 @@ class ArrayData : public CollectionData {
 
   void removeElement(size_t index, ResourceManager* resources);
 
+  // Records where the elements are, so that getElement() finds them without
+  // walking the list. Returns false if out of memory.
+  bool buildIndex(ResourceManager* resources) const;
+
+  static bool buildIndex(const ArrayData* array, ResourceManager* resources) {
+    if (!array)
+      return false;
+    return array->buildIndex(resources);
+  }
+
   static void removeElement(ArrayData* array, size_t index,
                             ResourceManager* resources) {
     if (!array)
@@ -61,6 +71,11 @@ class ArrayData : public CollectionData {
 
  private:
   iterator at(size_t index, const ResourceManager* resources) const;
+
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  VariantData* getIndexedElement(size_t index,
+                                 const ResourceManager* resources) const;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
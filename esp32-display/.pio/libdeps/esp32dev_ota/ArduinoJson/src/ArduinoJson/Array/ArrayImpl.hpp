@@ -49,9 +49,52 @@ inline VariantData* ArrayData::getOrAddElement(size_t index,
 
 inline VariantData* ArrayData::getElement(
     size_t index, const ResourceManager* resources) const {
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  if (index > 0)  // the first element is already at hand
+    return getIndexedElement(index, resources);
+#endif
   return at(index, resources).data();
 }
 
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+inline VariantData* ArrayData::getIndexedElement(
+    size_t index, const ResourceManager* resources) const {
+  auto entry = resources->arrayIndex().find(this, head());
+  if (!entry || !entry->size)
+    return at(index, resources).data();
+  if (index < entry->size)
+    return resources->getVariant(entry->ids[index]);
+
+  // elements appended since the index was built
+  SlotId id = resources->getVariant(entry->ids[entry->size - 1])->next();
+  for (size_t i = entry->size; id != NULL_SLOT; i++) {
+    VariantData* element = resources->getVariant(id);
+    if (i == index)
+      return element;
+    id = element->next();
+  }
+  return nullptr;
+}
+#endif
+
+inline bool ArrayData::buildIndex(ResourceManager* resources) const {
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  auto& index = resources->arrayIndex();
+  auto& entry = index.create(this, head());
+  for (SlotId id = head(); id != NULL_SLOT;
+       id = resources->getVariant(id)->next()) {
+    if (!ArrayIndex::append(entry, id, resources->allocator())) {
+      index.invalidate(this);
+      return false;
+    }
+  }
+  return true;
+#else
+  (void)resources;
+  return false;
+#endif
+}
+
 inline void ArrayData::removeElement(size_t index, ResourceManager* resources) {
   remove(at(index, resources), resources);
 }
@@ -130,6 +130,13 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
     detail::ArrayData::clear(data_, resources_);
   }
 
+  // Makes arr[i] as fast as an iterator, until an element is removed or the
+  // array is cleared. Only the last ARDUINOJSON_ARRAY_INDEX_COUNT arrays are
+  // indexed; returns false if out of memory or if indexing is disabled.
+  bool buildIndex() const {
+    return detail::ArrayData::buildIndex(data_, resources_);
+  }
+
   // Gets or sets the element at the specified index.
   // https://arduinojson.org/v7/api/jsonarray/subscript/
   template <typename T,
@@ -68,7 +68,18 @@ class JsonArrayConstIterator {
                                   const detail::ResourceManager* resources)
       : iterator_(iterator), resources_(resources) {}
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // INTERNAL USE ONLY
+  JsonArrayConstIterator(const detail::PackedArrayData& packed, size_t index,
+                         const detail::ResourceManager* resources)
+      : resources_(resources), packed_(packed), index_(index) {}
+#endif
+
   JsonVariantConst operator*() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (index_ < packed_.size())
+      return JsonVariantConst(packed_, index_, resources_);
+#endif
     return JsonVariantConst(iterator_.data(), resources_);
   }
   Ptr<JsonVariantConst> operator->() {
@@ -76,14 +87,25 @@ class JsonArrayConstIterator {
   }
 
   bool operator==(const JsonArrayConstIterator& other) const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    // The end of a packed array is the end iterator: no slot, no element left
+    if (index_ < packed_.size() || other.index_ < other.packed_.size())
+      return packed_.data() == other.packed_.data() && index_ == other.index_;
+#endif
     return iterator_ == other.iterator_;
   }
 
   bool operator!=(const JsonArrayConstIterator& other) const {
-    return iterator_ != other.iterator_;
+    return !operator==(other);
   }
 
   JsonArrayConstIterator& operator++() {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (index_ < packed_.size()) {
+      index_++;
+      return *this;
+    }
+#endif
     iterator_.next(resources_);
     return *this;
   }
@@ -91,6 +113,10 @@ class JsonArrayConstIterator {
  private:
   detail::ArrayData::iterator iterator_;
   const detail::ResourceManager* resources_;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  detail::PackedArrayData packed_;  // empty unless iterating a packed array
+  size_t index_ = 0;
+#endif
 };
 
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,274 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Array/PackedArrayData.hpp>
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memcpy, memmove
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Accumulates the elements of an array of numbers while it's being parsed.
+// The array is packed only if all the elements have the same type as they
+// would have in a slot: int32_t, float, or double.
+class PackedArrayBuilder {
+ public:
+  static const size_t initialCapacity = 8;
+
+  PackedArrayBuilder(ResourceManager* resources)
+      : resources_(resources),
+        node_(nullptr),
+        size_(0),
+        capacity_(0),
+        type_(PackedArrayType::Int32) {}
+
+  ~PackedArrayBuilder() {
+    if (node_)
+      resources_->destroyString(node_);
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns false if the value can't be packed with the previous ones, or if
+  // there isn't enough memory.
+  bool add(const Number& value) {
+    switch (value.type()) {
+      case NumberType::SignedInteger:
+      case NumberType::UnsignedInteger: {
+        if (size_ && type_ != PackedArrayType::Int32)
+          return false;
+        if (!value.canConvertTo<int32_t>())
+          return false;
+        type_ = PackedArrayType::Int32;
+        int32_t element = value.convertTo<int32_t>();
+        return append(&element);
+      }
+
+      case NumberType::Float: {
+        if (size_ && type_ == PackedArrayType::Int32)
+          return false;
+#  if ARDUINOJSON_USE_DOUBLE
+        if (size_ && type_ == PackedArrayType::Double) {
+          double element = value.asFloat();
+          return append(&element);
+        }
+#  endif
+        type_ = PackedArrayType::Float;
+        float element = value.asFloat();
+        return append(&element);
+      }
+
+#  if ARDUINOJSON_USE_DOUBLE
+      case NumberType::Double: {
+        if (size_ && type_ == PackedArrayType::Int32)
+          return false;
+        if (type_ != PackedArrayType::Double && !widen())
+          return false;
+        double element = value.asDouble();
+        return append(&element);
+      }
+#  endif
+
+      default:
+        return false;
+    }
+  }
+
+  // Allocates room for the first `capacity` elements of an array of n elements
+  // of the specified type; it grows if more come. Returns false if n elements
+  // are too many to be packed.
+  bool reserve(PackedArrayType type, size_t n, size_t capacity) {
+    ARDUINOJSON_ASSERT(size_ == 0);
+    ARDUINOJSON_ASSERT(capacity <= n);
+    type_ = type;
+    size_t elementSize = packedElementSize(type);
+    return n <= maxCapacity(elementSize) && grow(capacity, elementSize);
+  }
+
+  // The following functions return false if there isn't enough room (see
+  // reserve()) or if the previous elements have a different type.
+
+  bool add(int32_t value) {
+    if (size_ && type_ != PackedArrayType::Int32)
+      return false;
+    type_ = PackedArrayType::Int32;
+    return append(&value);
+  }
+
+  bool add(float value) {
+    if (size_ && type_ != PackedArrayType::Float)
+      return false;
+    type_ = PackedArrayType::Float;
+    return append(&value);
+  }
+
+#  if ARDUINOJSON_USE_DOUBLE
+  bool add(double value) {
+    if (size_ && type_ != PackedArrayType::Double)
+      return false;
+    type_ = PackedArrayType::Double;
+    return append(&value);
+  }
+#  endif
+
+  // Returns the storage for the next `count` elements, so the caller can write
+  // them in bulk; grows past the room reserved with reserve() if needed.
+  // Returns null if there isn't enough memory, or if that many elements are
+  // too many to be packed.
+  char* extend(size_t count) {
+    size_t elementSize = packedElementSize(type_);
+    if (count > capacity_ - size_) {
+      if (count > maxCapacity(elementSize) - size_ ||
+          !grow(size_ + count, elementSize))
+        return nullptr;
+    }
+    char* p = node_->data + size_ * elementSize;
+    size_ += count;
+    return p;
+  }
+
+  // Turns the (empty) array into a packed array.
+  // Returns false if there isn't enough memory.
+  bool save(VariantData* variant) {
+    ARDUINOJSON_ASSERT(variant != nullptr);
+    ARDUINOJSON_ASSERT(node_ != nullptr);
+
+    // reserve room to align the elements, since the node may move
+    size_t elementSize = packedElementSize(type_);
+    size_t length = size_ * elementSize;
+    node_ = resources_->resizeString(node_, length + elementSize - 1);
+    if (!node_)
+      return false;
+
+    size_t padding = packedArrayPadding(node_->data, elementSize);
+    memmove(node_->data + padding, node_->data, length);
+    // the node keeps its full length, so that the string pool counts what was
+    // allocated; PackedArrayData rounds the size down to whole elements
+    node_->data[node_->length] = 0;
+
+    resources_->saveString(node_);
+    variant->clear(resources_);
+    variant->setPackedArray(type_, node_);
+    node_ = nullptr;
+    return true;
+  }
+
+  // Adds the elements to a regular array.
+  // Returns false if there isn't enough memory.
+  bool unpack(ArrayData& array) {
+    for (size_t i = 0; i < size_; i++) {
+      auto element = array.addElement(resources_);
+      if (!element)
+        return false;
+      const char* p = node_->data + i * packedElementSize(type_);
+      switch (type_) {
+        case PackedArrayType::Int32: {
+          int32_t value;
+          memcpy(&value, p, sizeof(value));
+          element->setInteger(value, resources_);
+          break;
+        }
+
+#  if ARDUINOJSON_USE_DOUBLE
+        case PackedArrayType::Double: {
+          double value;
+          memcpy(&value, p, sizeof(value));
+          if (!element->setFloat(value, resources_))
+            return false;
+          break;
+        }
+#  endif
+
+        default: {
+          float value;
+          memcpy(&value, p, sizeof(value));
+          element->setFloat(value, resources_);
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+ private:
+  bool append(const void* element) {
+    size_t elementSize = packedElementSize(type_);
+    if (size_ == capacity_) {
+      size_t capacity = capacity_ ? capacity_ * 2 : initialCapacity;
+      if (capacity > maxCapacity(elementSize))
+        capacity = maxCapacity(elementSize);
+      if (capacity == capacity_ || !grow(capacity, elementSize))
+        return false;
+    }
+    memcpy(node_->data + size_ * elementSize, element, elementSize);
+    size_++;
+    return true;
+  }
+
+  // The most elements a packed array can hold, with room for the padding
+  static size_t maxCapacity(size_t elementSize) {
+    return (StringNode::maxLength - (elementSize - 1)) / elementSize;
+  }
+
+  // Unlike resizeString(), keeps the elements if the allocation fails
+  bool grow(size_t capacity, size_t elementSize) {
+    // keep enough room for the padding
+    if (capacity * elementSize + elementSize - 1 > StringNode::maxLength)
+      return false;
+    auto node = resources_->createString(capacity * elementSize);
+    if (!node)
+      return false;
+    if (node_) {
+      memcpy(node->data, node_->data, size_ * elementSize);
+      resources_->destroyString(node_);
+    }
+    node_ = node;
+    capacity_ = capacity;
+    return true;
+  }
+
+#  if ARDUINOJSON_USE_DOUBLE
+  // Converts the floats to doubles
+  bool widen() {
+    if (size_) {
+      if (capacity_ * sizeof(double) + sizeof(double) - 1 >
+          StringNode::maxLength)
+        return false;
+      auto node = resources_->createString(capacity_ * sizeof(double));
+      if (!node)
+        return false;
+      for (size_t i = 0; i < size_; i++) {
+        float value;
+        memcpy(&value, node_->data + i * sizeof(float), sizeof(value));
+        double wide = value;
+        memcpy(node->data + i * sizeof(double), &wide, sizeof(wide));
+      }
+      resources_->destroyString(node_);
+      node_ = node;
+    } else {
+      capacity_ = 0;  // the buffer holds floats
+    }
+    type_ = PackedArrayType::Double;
+    return true;
+  }
+#  endif
+
+  ResourceManager* resources_;
+  StringNode* node_;
+  size_t size_;
+  size_t capacity_;
+  PackedArrayType type_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+#endif
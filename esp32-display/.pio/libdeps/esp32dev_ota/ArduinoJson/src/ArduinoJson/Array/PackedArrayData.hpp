@@ -0,0 +1,103 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/StringNode.hpp>
+#include <ArduinoJson/Numbers/JsonInteger.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+enum class PackedArrayType : uint8_t {
+  Int32,
+  Float,
+#if ARDUINOJSON_USE_DOUBLE
+  Double,
+#endif
+};
+
+inline size_t packedElementSize(PackedArrayType type) {
+#if ARDUINOJSON_USE_DOUBLE
+  if (type == PackedArrayType::Double)
+    return sizeof(double);
+#else
+  (void)type;
+#endif
+  return 4;
+}
+
+// Number of bytes to skip at the beginning of a StringNode's data so that the
+// elements are aligned
+inline size_t packedArrayPadding(const char* data, size_t elementSize) {
+  size_t misalignment = reinterpret_cast<size_t>(data) & (elementSize - 1);
+  return misalignment ? elementSize - misalignment : 0;
+}
+
+// A homogeneous array of numbers stored contiguously in a StringNode, instead
+// of one slot per element.
+class PackedArrayData {
+ public:
+  PackedArrayData() : type_(PackedArrayType::Int32), data_(nullptr), size_(0) {}
+
+  PackedArrayData(PackedArrayType type, const StringNode* node)
+      : type_(type), data_(nullptr), size_(0) {
+    size_t elementSize = packedElementSize(type);
+    size_t padding = packedArrayPadding(node->data, elementSize);
+    data_ = node->data + padding;
+    size_ = (node->length - padding) / elementSize;
+  }
+
+  PackedArrayType type() const {
+    return type_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  const void* data() const {
+    return data_;
+  }
+
+  // Passes the element to the visitor with the type a slot would have.
+  template <typename TVisitor>
+  typename TVisitor::result_type visitElement(size_t index,
+                                              TVisitor& visit) const {
+    switch (type_) {
+      case PackedArrayType::Int32:
+        return visit.visit(static_cast<JsonInteger>(get<int32_t>(index)));
+
+#if ARDUINOJSON_USE_DOUBLE
+      case PackedArrayType::Double:
+        return visit.visit(get<double>(index));
+#endif
+
+      default:
+        return visit.visit(get<float>(index));
+    }
+  }
+
+  template <typename T>
+  T get(size_t index) const {
+    ARDUINOJSON_ASSERT(index < size_);
+    ARDUINOJSON_ASSERT(sizeof(T) == packedElementSize(type_));
+    T value;
+    memcpy(&value, data_ + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+ private:
+  PackedArrayType type_;
+  const char* data_;
+  size_t size_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+#endif
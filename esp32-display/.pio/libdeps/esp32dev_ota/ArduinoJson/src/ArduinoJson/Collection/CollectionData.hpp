@@ -104,6 +104,10 @@ class CollectionData {
   void removeOne(iterator it, ResourceManager* resources);
   void removePair(iterator it, ResourceManager* resources);
 
+  static iterator iteratorAt(VariantData* slot, SlotId id) {
+    return iterator(slot, id);
+  }
+
  private:
   Slot<VariantData> getPreviousSlot(VariantData*, const ResourceManager*) const;
 };
@@ -58,6 +58,12 @@ inline void CollectionData::appendPair(Slot<VariantData> key,
 }
 
 inline void CollectionData::clear(ResourceManager* resources) {
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  resources->arrayIndex().invalidate(this);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+  resources->objectIndex().invalidate(this);
+#endif
   auto next = head_;
   while (next != NULL_SLOT) {
     auto currId = next;
@@ -87,6 +93,12 @@ inline Slot<VariantData> CollectionData::getPreviousSlot(
 inline void CollectionData::removeOne(iterator it, ResourceManager* resources) {
   if (it.done())
     return;
+#if ARDUINOJSON_ARRAY_INDEX_COUNT
+  resources->arrayIndex().invalidate(this);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+  resources->objectIndex().invalidate(this);
+#endif
   auto curr = it.slot_;
   auto prev = getPreviousSlot(curr, resources);
   auto next = curr->next();
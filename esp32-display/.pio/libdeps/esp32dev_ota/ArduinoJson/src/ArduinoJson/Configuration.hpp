@@ -124,6 +124,39 @@
 #  define ARDUINOJSON_INITIAL_POOL_COUNT 4
 #endif
 
+// Number of arrays whose elements are indexed for O(1) random access (0 to
+// walk the list on each access)
+#ifndef ARDUINOJSON_ARRAY_INDEX_COUNT
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ARRAY_INDEX_COUNT 0
+#  else
+#    define ARDUINOJSON_ARRAY_INDEX_COUNT 2
+#  endif
+#endif
+
+// Number of objects whose key hashes are kept for lookups with JsonKey, see
+// JsonObject::buildIndex() (0 to compare the keys one by one)
+#ifndef ARDUINOJSON_OBJECT_INDEX_COUNT
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_OBJECT_INDEX_COUNT 0
+#  else
+#    define ARDUINOJSON_OBJECT_INDEX_COUNT 2
+#  endif
+#endif
+
+// Store the arrays of numbers parsed by deserializeJson() as a contiguous block
+// of int32_t, float, or double instead of one slot per element.
+// Such an array is converted to regular slots the first time it's accessed
+// through JsonArray; use JsonSpan<T> to read it in place.
+#ifndef ARDUINOJSON_ENABLE_PACKED_ARRAYS
+#  define ARDUINOJSON_ENABLE_PACKED_ARRAYS 0
+#endif
+
+// Minimum number of elements for an array to be packed
+#ifndef ARDUINOJSON_PACKED_ARRAY_MIN_SIZE
+#  define ARDUINOJSON_PACKED_ARRAY_MIN_SIZE 4
+#endif
+
 // Automatically call shrinkToFit() from deserializeXxx()
 // Disabled by default on 8-bit platforms because it's not worth the increase in
 // code size
@@ -238,6 +271,12 @@
 #  define ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD 1e-5
 #endif
 
+// Serialize floating-point values with the shortest representation that
+// round-trips (1) instead of a fixed number of decimal places (0)
+#ifndef ARDUINOJSON_SHORTEST_FLOAT
+#  define ARDUINOJSON_SHORTEST_FLOAT 0
+#endif
+
 #ifndef ARDUINOJSON_LITTLE_ENDIAN
 #  if defined(_MSC_VER) ||                           \
       (defined(__BYTE_ORDER__) &&                    \
@@ -265,6 +304,21 @@
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Size of the blocks that JsonOutputBuffer adds when it runs out of room
+#ifndef ARDUINOJSON_OUTPUT_BLOCK_SIZE
+#  define ARDUINOJSON_OUTPUT_BLOCK_SIZE 256
+#endif
+
+// Size of the buffer holding the path that mergePatch() passes to its callback
+#ifndef ARDUINOJSON_PATCH_PATH_SIZE
+#  define ARDUINOJSON_PATCH_PATH_SIZE 64
+#endif
+
+// Longest string or key that parseJson() can pass to a JsonHandler
+#ifndef ARDUINOJSON_EVENT_STRING_CAPACITY
+#  define ARDUINOJSON_EVENT_STRING_CAPACITY 128
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #  ifdef __PLATFORMIO_BUILD_DEBUG__
 #    define ARDUINOJSON_DEBUG 1
@@ -0,0 +1,267 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Array/JsonArrayConst.hpp>
+#include <ArduinoJson/Object/JsonObjectConst.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+#include <ArduinoJson/Variant/VariantContent.hpp>
+
+#include <string.h>  // memcmp, memcpy, strlen
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+enum class FilterNodeKind : uint8_t {
+  Deny,      // false, null
+  Keep,      // other scalars: keep the member, but not its value
+  AllowAll,  // true
+  Array,
+  Object,
+};
+
+// One node of a compiled filter.
+// The members of an object are consecutive nodes, each one holding its key.
+struct FilterNode {
+  FilterNodeKind kind;
+  char firstChar;      // first byte of the key, 0 if empty
+  uint16_t keyLength;  // length of the key
+  union {
+    const char* key;  // points in the filter document
+    // a tiny key lives in its slot, which moves when the pools shrink
+    char shortKey[tinyStringMaxLength];
+  };
+  uint16_t child;       // Array: the element; Object: the first member
+  uint16_t childCount;  // Object: number of members, excluding "*"
+  uint16_t wildcard;    // Object: the "*" member, 0 if none
+  uint32_t lengthMask;  // Object: one bit per key length (modulo 32)
+  uint32_t charMask;    // Object: one bit per first byte (modulo 32)
+
+  const char* keyData() const {
+    return keyLength <= tinyStringMaxLength ? shortKey : key;
+  }
+
+  void setKey(JsonString k) {
+    keyLength = uint16_t(k.size());
+    firstChar = k.size() ? k.c_str()[0] : 0;
+    if (keyLength <= tinyStringMaxLength)
+      memcpy(shortKey, k.c_str(), keyLength);
+    else
+      key = k.c_str();
+  }
+};
+
+inline uint32_t filterMaskBit(size_t value) {
+  return uint32_t(1) << (value & 31);
+}
+
+// The filter passed to the deserializers when using a CompiledFilter.
+// Node 0 is shared by all the members that the filter denies.
+class FilterMatcher {
+ public:
+  FilterMatcher(const FilterNode* nodes, uint16_t index)
+      : nodes_(nodes), index_(index) {}
+
+  bool allow() const {
+    return node().kind != FilterNodeKind::Deny;
+  }
+
+  bool allowArray() const {
+    return node().kind == FilterNodeKind::AllowAll ||
+           node().kind == FilterNodeKind::Array;
+  }
+
+  bool allowObject() const {
+    return node().kind == FilterNodeKind::AllowAll ||
+           node().kind == FilterNodeKind::Object;
+  }
+
+  bool allowValue() const {
+    return node().kind == FilterNodeKind::AllowAll;
+  }
+
+  template <typename TIndex, enable_if_t<is_integral<TIndex>::value, int> = 0>
+  FilterMatcher operator[](TIndex) const {
+    switch (node().kind) {
+      case FilterNodeKind::AllowAll:
+        return *this;
+      case FilterNodeKind::Array:
+        return FilterMatcher(nodes_, node().child);
+      default:
+        return FilterMatcher(nodes_, 0);
+    }
+  }
+
+  FilterMatcher operator[](const char* key) const {
+    return member(key, strlen(key));
+  }
+
+  FilterMatcher operator[](JsonString key) const {
+    return member(key.c_str(), key.size());
+  }
+
+ private:
+  const FilterNode& node() const {
+    return nodes_[index_];
+  }
+
+  FilterMatcher member(const char* key, size_t length) const {
+    const FilterNode& object = node();
+    if (object.kind == FilterNodeKind::AllowAll)
+      return *this;
+    if (object.kind != FilterNodeKind::Object)
+      return FilterMatcher(nodes_, 0);
+
+    // reject most keys on length and first byte, without touching the members
+    char firstChar = length ? key[0] : 0;
+    if ((object.lengthMask & filterMaskBit(length)) &&
+        (object.charMask & filterMaskBit(uint8_t(firstChar)))) {
+      uint16_t end = uint16_t(object.child + object.childCount);
+      for (uint16_t i = object.child; i < end; i++) {
+        const FilterNode& m = nodes_[i];
+        if (m.keyLength == length && m.firstChar == firstChar &&
+            memcmp(m.keyData(), key, length) == 0)
+          return FilterMatcher(nodes_, i);
+      }
+    }
+    return FilterMatcher(nodes_, object.wildcard);
+  }
+
+  const FilterNode* nodes_;
+  uint16_t index_;
+};
+
+// Turns a filter document into FilterNodes
+class FilterCompiler {
+ public:
+  FilterCompiler(FilterNode* nodes, size_t capacity)
+      : nodes_(nodes), capacity_(capacity), size_(0), overflowed_(false) {}
+
+  // Returns the index of the root node, or 0 if the nodes don't fit.
+  uint16_t compile(JsonVariantConst filter) {
+    nodes_[allocate(1)] = FilterNode();  // denies everything
+    uint16_t root = allocate(1);
+    compileValue(filter, root);
+    return overflowed_ ? 0 : root;
+  }
+
+ private:
+  uint16_t allocate(size_t n) {
+    if (size_ + n > capacity_) {
+      overflowed_ = true;
+      return 0;
+    }
+    uint16_t index = uint16_t(size_);
+    size_ += n;
+    return index;
+  }
+
+  void compileValue(JsonVariantConst filter, uint16_t index) {
+    FilterNode& node = nodes_[index];
+    node.child = 0;
+    node.childCount = 0;
+    node.wildcard = 0;
+    node.lengthMask = 0;
+    node.charMask = 0;
+
+    if (filter == true) {
+      node.kind = FilterNodeKind::AllowAll;
+    } else if (filter.is<JsonObjectConst>()) {
+      node.kind = FilterNodeKind::Object;
+      compileObject(filter.as<JsonObjectConst>(), index);
+    } else if (filter.is<JsonArrayConst>()) {
+      node.kind = FilterNodeKind::Array;
+      uint16_t element = allocate(1);
+      if (overflowed_)
+        return;
+      nodes_[index].child = element;
+      compileValue(filter[0], element);
+    } else {
+      node.kind = filter.as<bool>() ? FilterNodeKind::Keep
+                                    : FilterNodeKind::Deny;
+    }
+  }
+
+  // A member set to null is left out, so that the key falls back to "*", as
+  // it does with Filter.
+  void compileObject(JsonObjectConst object, uint16_t index) {
+    uint16_t count = 0;
+    bool hasWildcard = false;
+    for (JsonPairConst pair : object) {
+      if (pair.key() == "*")
+        hasWildcard = true;
+      else if (!pair.value().isNull())
+        count++;
+    }
+
+    // members first, so they are consecutive
+    uint16_t first = allocate(count);
+    uint16_t wildcard = hasWildcard ? allocate(1) : 0;
+    if (overflowed_)
+      return;
+    nodes_[index].child = first;
+    nodes_[index].childCount = count;
+    nodes_[index].wildcard = wildcard;
+
+    uint16_t i = first;
+    for (JsonPairConst pair : object) {
+      JsonString key = pair.key();
+      if (key == "*") {
+        compileValue(pair.value(), wildcard);
+      } else if (!pair.value().isNull()) {
+        compileValue(pair.value(), i);
+        FilterNode& member = nodes_[i++];
+        member.setKey(key);
+        nodes_[index].lengthMask |= filterMaskBit(key.size());
+        nodes_[index].charMask |= filterMaskBit(uint8_t(member.firstChar));
+      }
+      if (overflowed_)
+        return;
+    }
+  }
+
+  FilterNode* nodes_;
+  size_t capacity_;
+  size_t size_;
+  bool overflowed_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// A Filter converted into a table of up to N nodes (one per member, plus one
+// per array and two for the root), so that each key of the input costs at
+// most one scan of the matching object instead of two lookups in the filter.
+// The filter document must outlive the CompiledFilter.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <size_t N>
+class CompiledFilter {
+  static_assert(N >= 2 && N <= 0xFFFF, "N must be between 2 and 65535");
+
+ public:
+  explicit CompiledFilter(JsonVariantConst filter) {
+    detail::FilterCompiler compiler(nodes_, N);
+    root_ = compiler.compile(filter);
+  }
+
+  // Returns true if the filter needs more than N nodes; such a filter denies
+  // everything.
+  bool overflowed() const {
+    return root_ == 0;
+  }
+
+  detail::FilterMatcher matcher() const {
+    return detail::FilterMatcher(nodes_, root_);
+  }
+
+ private:
+  detail::FilterNode nodes_[N];
+  uint16_t root_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
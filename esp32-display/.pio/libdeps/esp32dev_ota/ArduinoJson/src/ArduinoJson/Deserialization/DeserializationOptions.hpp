@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/CompiledFilter.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
 
@@ -27,6 +28,20 @@ inline DeserializationOptions<TFilter> makeDeserializationOptions(
   return {filter, nestingLimit};
 }
 
+template <size_t N>
+inline DeserializationOptions<FilterMatcher> makeDeserializationOptions(
+    const DeserializationOption::CompiledFilter<N>& filter,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {filter.matcher(), nestingLimit};
+}
+
+template <size_t N>
+inline DeserializationOptions<FilterMatcher> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit,
+    const DeserializationOption::CompiledFilter<N>& filter) {
+  return {filter.matcher(), nestingLimit};
+}
+
 inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
     DeserializationOption::NestingLimit nestingLimit = {}) {
   return {{}, nestingLimit};
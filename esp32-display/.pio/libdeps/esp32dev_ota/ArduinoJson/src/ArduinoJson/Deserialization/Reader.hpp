@@ -5,6 +5,8 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Polyfills/type_traits/declval.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
 #include <stdlib.h>  // for size_t
@@ -37,6 +39,16 @@ struct BoundedReader {
   // constructor
 };
 
+// Readers of a memory buffer also have position(), available(), and skip(),
+// so the deserializers can scan the input and consume runs of bytes in place.
+template <typename TReader, typename Enable = void>
+struct IsContiguousReader : false_type {};
+
+template <typename TReader>
+struct IsContiguousReader<TReader,
+                          void_t<decltype(declval<TReader&>().skip(0))>>
+    : true_type {};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 #include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
@@ -0,0 +1,44 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A mutable input buffer, shared by InSituReader and InSituStringBuilder
+struct InSituBuffer {
+  char* ptr;        // next character to read
+  const char* end;  // nullptr if the input is null-terminated
+};
+
+class InSituReader {
+ public:
+  explicit InSituReader(InSituBuffer* buffer) : buffer_(buffer) {}
+
+  int read() {
+    if (buffer_->ptr == buffer_->end)
+      return -1;
+    return static_cast<unsigned char>(*buffer_->ptr++);
+  }
+
+  size_t readBytes(char* dst, size_t length) {
+    size_t i = 0;
+    while (i < length && buffer_->ptr != buffer_->end)
+      dst[i++] = *buffer_->ptr++;
+    return i;
+  }
+
+  InSituBuffer* buffer() const {
+    return buffer_;
+  }
+
+ private:
+  InSituBuffer* buffer_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
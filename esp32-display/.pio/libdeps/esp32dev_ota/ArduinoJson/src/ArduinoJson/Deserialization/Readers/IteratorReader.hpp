@@ -10,6 +10,7 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename TIterator>
 class IteratorReader {
+ protected:
   TIterator ptr_, end_;
 
  public:
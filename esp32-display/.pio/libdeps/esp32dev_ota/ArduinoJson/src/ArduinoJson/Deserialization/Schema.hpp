@@ -0,0 +1,250 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <stddef.h>  // offsetof
+#include <string.h>  // memcpy, memcmp
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+enum class SchemaFieldType : uint8_t {
+  Boolean,
+  SignedInteger,
+  UnsignedInteger,
+  Float,
+  String,  // char[N], always null-terminated
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Describes how one JSON member maps to a member of a struct.
+// Don't fill it by hand, use ARDUINOJSON_FIELD() and friends.
+struct JsonSchemaField {
+  const char* key;
+  uint8_t keyLength;
+  detail::SchemaFieldType type;
+  uint8_t size;         // size of the value (or of one element)
+  uint16_t offset;      // offset of the member in the struct
+  uint16_t capacity;    // 0 for scalars, N for T[N] and char[N]
+  int16_t countOffset;  // offset of the element count, -1 if none
+  uint8_t countSize;    // size of the element count
+};
+
+// Maps the members of a JSON object to the members of T, so that
+// deserializeJson() can fill T without a JsonDocument.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename T>
+class JsonSchema {
+ public:
+  template <size_t N>
+  JsonSchema(const JsonSchemaField (&fields)[N])
+      : fields_(fields), size_(N) {}
+
+  const JsonSchemaField* begin() const {
+    return fields_;
+  }
+
+  const JsonSchemaField* end() const {
+    return fields_ + size_;
+  }
+
+ private:
+  const JsonSchemaField* fields_;
+  size_t size_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename T, typename Enable = void>
+struct SchemaFieldTraits {
+  // Error here? The type of this member is not supported by JsonSchema.
+  // Use bool, an integer, a float, char[N], or an array of these scalars.
+};
+
+template <>
+struct SchemaFieldTraits<bool> {
+  static constexpr SchemaFieldType type = SchemaFieldType::Boolean;
+  static constexpr uint16_t capacity = 0;
+  static constexpr uint8_t size = sizeof(bool);
+};
+
+template <typename T>
+struct SchemaFieldTraits<
+    T, enable_if_t<is_integral<T>::value && !is_same<T, bool>::value>> {
+  static_assert(sizeof(T) <= sizeof(JsonInteger),
+                "integer too large, set ARDUINOJSON_USE_LONG_LONG to 1");
+  static constexpr SchemaFieldType type =
+      is_signed<T>::value ? SchemaFieldType::SignedInteger
+                          : SchemaFieldType::UnsignedInteger;
+  static constexpr uint16_t capacity = 0;
+  static constexpr uint8_t size = sizeof(T);
+};
+
+template <typename T>
+struct SchemaFieldTraits<T, enable_if_t<is_floating_point<T>::value>> {
+  static constexpr SchemaFieldType type = SchemaFieldType::Float;
+  static constexpr uint16_t capacity = 0;
+  static constexpr uint8_t size = sizeof(T);
+};
+
+template <size_t N>
+struct SchemaFieldTraits<char[N]> {
+  static constexpr SchemaFieldType type = SchemaFieldType::String;
+  static constexpr uint16_t capacity = N;
+  static constexpr uint8_t size = 1;
+};
+
+template <typename T, size_t N>
+struct SchemaFieldTraits<T[N], enable_if_t<!is_same<T, char>::value>> {
+  static_assert(SchemaFieldTraits<T>::capacity == 0,
+                "JsonSchema only supports arrays of scalars");
+  static constexpr SchemaFieldType type = SchemaFieldTraits<T>::type;
+  static constexpr uint16_t capacity = N;
+  static constexpr uint8_t size = sizeof(T);
+};
+
+template <typename TMember>
+constexpr JsonSchemaField makeSchemaField(const char* key, size_t keyLength,
+                                          size_t offset) {
+  return {key,
+          uint8_t(keyLength),
+          SchemaFieldTraits<TMember>::type,
+          SchemaFieldTraits<TMember>::size,
+          uint16_t(offset),
+          SchemaFieldTraits<TMember>::capacity,
+          -1,
+          0};
+}
+
+template <typename TMember, typename TCount>
+constexpr JsonSchemaField makeSchemaField(const char* key, size_t keyLength,
+                                          size_t offset, size_t countOffset) {
+  static_assert(is_array<TMember>::value, "the field must be an array");
+  static_assert(is_integral<TCount>::value && !is_same<TCount, bool>::value &&
+                    (sizeof(TCount) == 1 || sizeof(TCount) == 2 ||
+                     sizeof(TCount) == 4),
+                "the count must be an 8, 16, or 32-bit integer");
+  return {key,
+          uint8_t(keyLength),
+          SchemaFieldTraits<TMember>::type,
+          SchemaFieldTraits<TMember>::size,
+          uint16_t(offset),
+          SchemaFieldTraits<TMember>::capacity,
+          int16_t(countOffset),
+          uint8_t(sizeof(TCount))};
+}
+
+inline const JsonSchemaField* findSchemaField(const JsonSchemaField* begin,
+                                              const JsonSchemaField* end,
+                                              const char* key, size_t length) {
+  for (auto field = begin; field != end; ++field) {
+    // reject quickly on length and first byte before comparing
+    if (field->keyLength == length && field->key[0] == key[0] &&
+        memcmp(field->key, key, length) == 0)
+      return field;
+  }
+  return nullptr;
+}
+
+template <typename T>
+inline bool storeSchemaNumber(void* dst, const Number& number) {
+  if (!number.canConvertTo<T>())
+    return false;
+  T value = number.convertTo<T>();
+  memcpy(dst, &value, sizeof(T));
+  return true;
+}
+
+// Writes a parsed number in a field of the given type and size.
+// Returns false if the number doesn't fit or is not an integer when it should.
+inline bool storeSchemaNumber(void* dst, SchemaFieldType type, uint8_t size,
+                              const Number& number) {
+  switch (type) {
+    case SchemaFieldType::Float:
+      if (size == sizeof(double))
+        return storeSchemaNumber<double>(dst, number);
+      return storeSchemaNumber<float>(dst, number);
+
+    case SchemaFieldType::SignedInteger:
+    case SchemaFieldType::UnsignedInteger:
+      if (number.type() != NumberType::SignedInteger &&
+          number.type() != NumberType::UnsignedInteger)
+        return false;
+      if (type == SchemaFieldType::SignedInteger) {
+        switch (size) {
+          case 1:
+            return storeSchemaNumber<int8_t>(dst, number);
+          case 2:
+            return storeSchemaNumber<int16_t>(dst, number);
+          case 4:
+            return storeSchemaNumber<int32_t>(dst, number);
+          default:
+            return storeSchemaNumber<JsonInteger>(dst, number);
+        }
+      } else {
+        switch (size) {
+          case 1:
+            return storeSchemaNumber<uint8_t>(dst, number);
+          case 2:
+            return storeSchemaNumber<uint16_t>(dst, number);
+          case 4:
+            return storeSchemaNumber<uint32_t>(dst, number);
+          default:
+            return storeSchemaNumber<JsonUInt>(dst, number);
+        }
+      }
+
+    default:
+      return false;
+  }
+}
+
+inline void storeSchemaCount(void* object, const JsonSchemaField& field,
+                             size_t count) {
+  char* dst = reinterpret_cast<char*>(object) + field.countOffset;
+  switch (field.countSize) {
+    case 1: {
+      uint8_t value = uint8_t(count);
+      memcpy(dst, &value, 1);
+      break;
+    }
+    case 2: {
+      uint16_t value = uint16_t(count);
+      memcpy(dst, &value, 2);
+      break;
+    }
+    default: {
+      uint32_t value = uint32_t(count);
+      memcpy(dst, &value, 4);
+      break;
+    }
+  }
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+// Maps the member MEMBER of STRUCT to the JSON key of the same name.
+#define ARDUINOJSON_FIELD(STRUCT, MEMBER) \
+  ARDUINOJSON_NAMED_FIELD(STRUCT, MEMBER, #MEMBER)
+
+// Maps the member MEMBER of STRUCT to the JSON key KEY (a string literal).
+#define ARDUINOJSON_NAMED_FIELD(STRUCT, MEMBER, KEY)                \
+  ::ArduinoJson::detail::makeSchemaField<decltype(STRUCT::MEMBER)>( \
+      KEY, sizeof(KEY) - 1, offsetof(STRUCT, MEMBER))
+
+// Maps the array MEMBER of STRUCT to the JSON key of the same name, and stores
+// the number of elements in the integer member COUNT.
+#define ARDUINOJSON_ARRAY_FIELD(STRUCT, MEMBER, COUNT)             \
+  ::ArduinoJson::detail::makeSchemaField<decltype(STRUCT::MEMBER), \
+                                         decltype(STRUCT::COUNT)>( \
+      #MEMBER, sizeof(#MEMBER) - 1, offsetof(STRUCT, MEMBER),     \
+      offsetof(STRUCT, COUNT))
@@ -39,6 +39,19 @@ class JsonSerializer : public VariantDataVisitor<size_t> {
     return bytesWritten();
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  size_t visit(const PackedArrayData& array) {
+    write('[');
+    for (size_t i = 0; i < array.size(); i++) {
+      if (i)
+        write(',');
+      array.visitElement(i, *this);
+    }
+    write(']');
+    return bytesWritten();
+  }
+#endif
+
   size_t visit(const ObjectData& object) {
     write('{');
 
@@ -145,6 +158,13 @@ inline size_t serializeJson(JsonVariantConst source, void* buffer,
   return serialize<JsonSerializer>(source, buffer, bufferSize);
 }
 
+// Produces a minified JSON document in a single pass, into a buffer sized
+// from the previous call.
+inline size_t serializeJson(JsonDocument& doc, JsonOutputBuffer& output) {
+  using namespace detail;
+  return serialize<JsonSerializer>(doc, output);
+}
+
 // Computes the length of the document that serializeJson() produces.
 // https://arduinojson.org/v7/api/json/measurejson/
 inline size_t measureJson(JsonVariantConst source) {
@@ -0,0 +1,618 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/DeserializationOptions.hpp>
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonChars.hpp>
+#include <ArduinoJson/Json/JsonHandler.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The deepest nesting supported by JsonStreamParser
+const uint8_t maxStreamDepth = 32;
+
+// Builds a variant from the tokens found by a parser; see HandlerSink.
+class VariantSink {
+ public:
+  VariantSink(VariantData* root, ResourceManager* resources)
+      : strings(resources), root_(root), resources_(resources) {
+    reset();
+  }
+
+  void reset() {
+    depth_ = 0;
+    member_ = root_;
+  }
+
+  bool stopped() const {
+    return false;
+  }
+
+  DeserializationError::Code startObject() {
+    return push(nextValue(), &VariantData::toObject);
+  }
+
+  DeserializationError::Code endObject() {
+    depth_--;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code startArray() {
+    return push(nextValue(), &VariantData::toArray);
+  }
+
+  DeserializationError::Code endArray() {
+    depth_--;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code key() {
+    ObjectData* object = stack_[depth_ - 1]->asObject();
+    ARDUINOJSON_ASSERT(object != nullptr);
+
+    member_ = object->getMember(adaptString(strings.str()), resources_);
+    if (!member_) {
+      auto keyVariant = object->addPair(&member_, resources_);
+      if (!keyVariant)
+        return DeserializationError::NoMemory;
+      strings.save(keyVariant);
+    } else {
+      member_->clear(resources_);
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code string() {
+    VariantData* value = nextValue();
+    if (!value)
+      return DeserializationError::NoMemory;
+    strings.save(value);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code number(const Number& number) {
+    VariantData* value = nextValue();
+    if (!value)
+      return DeserializationError::NoMemory;
+
+    bool ok;
+    switch (number.type()) {
+      case NumberType::UnsignedInteger:
+        ok = value->setInteger(number.asUnsignedInteger(), resources_);
+        break;
+
+      case NumberType::SignedInteger:
+        ok = value->setInteger(number.asSignedInteger(), resources_);
+        break;
+
+      case NumberType::Float:
+        ok = value->setFloat(number.asFloat(), resources_);
+        break;
+
+#if ARDUINOJSON_USE_DOUBLE
+      case NumberType::Double:
+        ok = value->setFloat(number.asDouble(), resources_);
+        break;
+#endif
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+    return ok ? DeserializationError::Ok : DeserializationError::NoMemory;
+  }
+
+  DeserializationError::Code boolean(bool value) {
+    VariantData* variant = nextValue();
+    if (!variant)
+      return DeserializationError::NoMemory;
+    variant->setBoolean(value);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code null() {
+    return nextValue() ? DeserializationError::Ok
+                       : DeserializationError::NoMemory;
+  }
+
+  StringBuilder strings;
+
+ private:
+  // Returns the variant that receives the next value: the root, the member
+  // selected by key(), or a new element of the current array.
+  VariantData* nextValue() {
+    if (depth_ > 0 && stack_[depth_ - 1]->isArray())
+      return stack_[depth_ - 1]->asArray()->addElement(resources_);
+    return member_;
+  }
+
+  template <typename TCollection>
+  DeserializationError::Code push(VariantData* variant,
+                                  TCollection& (VariantData::*convert)()) {
+    if (!variant)
+      return DeserializationError::NoMemory;
+    ARDUINOJSON_ASSERT(depth_ < maxStreamDepth);
+    (variant->*convert)();
+    stack_[depth_++] = variant;
+    return DeserializationError::Ok;
+  }
+
+  VariantData* root_;
+  VariantData* member_;
+  VariantData* stack_[maxStreamDepth];
+  uint8_t depth_;
+  ResourceManager* resources_;
+};
+
+// A JSON parser that consumes its input in chunks and keeps its state
+// between calls, instead of pulling characters from a Reader.
+// Comments are not supported.
+template <typename TSink>
+class IncrementalJsonParser {
+ public:
+  explicit IncrementalJsonParser(DeserializationOption::NestingLimit limit)
+      : consumed_(0) {
+    for (maxDepth_ = 0; maxDepth_ < maxStreamDepth && !limit.reached();
+         maxDepth_++)
+      limit = limit.decrement();
+    reset();
+  }
+
+  void reset() {
+    state_ = State::Start;
+    error_ = DeserializationError::Ok;
+    depth_ = 0;
+    objects_ = 0;
+  }
+
+  // Returns IncompleteInput until the value is complete, then Ok.
+  DeserializationError::Code feed(TSink& sink, const char* data, size_t n) {
+    consumed_ = 0;
+    while (consumed_ < n && state_ != State::Done && state_ != State::Failed) {
+      bool consumed = true;
+      auto err = step(sink, data[consumed_], consumed);
+      if (err)
+        return fail(sink, err);
+      if (consumed)
+        consumed_++;
+    }
+    return status();
+  }
+
+  // Returns the number of bytes that the last call to feed() used.
+  size_t consumed() const {
+    return consumed_;
+  }
+
+  // Tells that the input is over; completes a number at the root.
+  DeserializationError::Code end(TSink& sink) {
+    if (state_ == State::Number && depth_ == 0) {
+      auto err = emitNumber(sink);
+      if (err)
+        return fail(sink, err);
+    }
+    if (state_ == State::Start)
+      return DeserializationError::EmptyInput;
+    return status();
+  }
+
+ private:
+  enum class State : uint8_t {
+    Start,       // before the root value
+    Value,       // before a value
+    ValueOrEnd,  // after '['
+    KeyOrEnd,    // after '{'
+    Key,         // after ',' in an object
+    Colon,       // after a key
+    NextOrEnd,   // after a value in an array or an object
+    String,
+    Escape,
+    Unicode,
+    UnquotedKey,
+    Number,
+    Keyword,
+    Done,
+    Failed,
+  };
+
+  DeserializationError::Code status() const {
+    switch (state_) {
+      case State::Done:
+        return DeserializationError::Ok;
+      case State::Failed:
+        return error_;
+      default:
+        return DeserializationError::IncompleteInput;
+    }
+  }
+
+  DeserializationError::Code fail(TSink& sink,
+                                  DeserializationError::Code err) {
+    if (sink.stopped()) {
+      state_ = State::Done;
+      return DeserializationError::Ok;
+    }
+    state_ = State::Failed;
+    error_ = err;
+    return err;
+  }
+
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  bool inObject() const {
+    return (objects_ >> (depth_ - 1)) & 1;
+  }
+
+  DeserializationError::Code push(bool object) {
+    if (depth_ >= maxDepth_)
+      return DeserializationError::TooDeep;
+    if (object)
+      objects_ |= uint32_t(1) << depth_;
+    else
+      objects_ &= ~(uint32_t(1) << depth_);
+    depth_++;
+    return DeserializationError::Ok;
+  }
+
+  void valueDone() {
+    state_ = depth_ == 0 ? State::Done : State::NextOrEnd;
+  }
+
+  DeserializationError::Code emitNumber(TSink& sink) {
+    number_[numberLength_] = 0;
+    valueDone();
+    return sink.number(parseNumber(number_));
+  }
+
+  DeserializationError::Code emitKeyword(TSink& sink) {
+    valueDone();
+    switch (keyword_[0]) {
+      case 't':
+        return sink.boolean(true);
+      case 'f':
+        return sink.boolean(false);
+      default:
+        return sink.null();
+    }
+  }
+
+  // Processes one character; clears `consumed` to see it again in the new
+  // state.
+  DeserializationError::Code step(TSink& sink, char c, bool& consumed) {
+    switch (state_) {
+      case State::Start:
+      case State::Value:
+        if (isSpace(c))
+          return DeserializationError::Ok;
+        state_ = State::Value;
+        switch (c) {
+          case '[':
+            state_ = State::ValueOrEnd;
+            if (auto err = push(false))
+              return err;
+            return sink.startArray();
+
+          case '{':
+            state_ = State::KeyOrEnd;
+            if (auto err = push(true))
+              return err;
+            return sink.startObject();
+
+          case '\"':
+          case '\'':
+            stopChar_ = c;
+            isKey_ = false;
+            return startString(sink);
+
+          case 't':
+            return startKeyword("true");
+
+          case 'f':
+            return startKeyword("false");
+
+          case 'n':
+            return startKeyword("null");
+
+          default:
+            if (!canBeInNumber(c))
+              return DeserializationError::InvalidInput;
+            numberLength_ = 0;
+            state_ = State::Number;
+            consumed = false;
+            return DeserializationError::Ok;
+        }
+
+      case State::ValueOrEnd:
+        if (isSpace(c))
+          return DeserializationError::Ok;
+        if (c == ']')
+          return endCollection(sink, false);
+        state_ = State::Value;
+        consumed = false;
+        return DeserializationError::Ok;
+
+      case State::KeyOrEnd:
+        if (isSpace(c))
+          return DeserializationError::Ok;
+        if (c == '}')
+          return endCollection(sink, true);
+        state_ = State::Key;
+        consumed = false;
+        return DeserializationError::Ok;
+
+      case State::Key:
+        if (isSpace(c))
+          return DeserializationError::Ok;
+        isKey_ = true;
+        if (isQuote(c)) {
+          stopChar_ = c;
+          return startString(sink);
+        }
+        if (!canBeInNonQuotedString(c))
+          return DeserializationError::InvalidInput;
+        state_ = State::UnquotedKey;
+        sink.strings.startString();
+        consumed = false;
+        return DeserializationError::Ok;
+
+      case State::UnquotedKey:
+        if (canBeInNonQuotedString(c)) {
+          sink.strings.append(c);
+          return DeserializationError::Ok;
+        }
+        consumed = false;
+        return endString(sink);
+
+      case State::Colon:
+        if (isSpace(c))
+          return DeserializationError::Ok;
+        if (c != ':')
+          return DeserializationError::InvalidInput;
+        state_ = State::Value;
+        return sink.key();
+
+      case State::NextOrEnd:
+        if (isSpace(c))
+          return DeserializationError::Ok;
+        if (c == ',') {
+          state_ = inObject() ? State::Key : State::Value;
+          return DeserializationError::Ok;
+        }
+        if (c == (inObject() ? '}' : ']'))
+          return endCollection(sink, inObject());
+        return DeserializationError::InvalidInput;
+
+      case State::String:
+        if (c == stopChar_)
+          return endString(sink);
+        if (c == '\\')
+          state_ = State::Escape;
+        else
+          sink.strings.append(c);
+        return DeserializationError::Ok;
+
+      case State::Escape:
+        state_ = State::String;
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          state_ = State::Unicode;
+          codeunit_ = 0;
+          hexDigits_ = 0;
+#else
+          sink.strings.append('\\');
+          consumed = false;
+#endif
+          return DeserializationError::Ok;
+        }
+        c = EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        sink.strings.append(c);
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_DECODE_UNICODE
+      case State::Unicode: {
+        uint8_t digit = decodeHex(c);
+        if (digit > 0xF)
+          return DeserializationError::InvalidInput;
+        codeunit_ = uint16_t((codeunit_ << 4) | digit);
+        if (++hexDigits_ < 4)
+          return DeserializationError::Ok;
+        if (codepoint_.append(codeunit_))
+          Utf8::encodeCodepoint(codepoint_.value(), sink.strings);
+        state_ = State::String;
+        return DeserializationError::Ok;
+      }
+#endif
+
+      case State::Number:
+        if (canBeInNumber(c)) {
+          if (numberLength_ >= sizeof(number_) - 1)
+            return DeserializationError::InvalidInput;
+          number_[numberLength_++] = c;
+          return DeserializationError::Ok;
+        }
+        consumed = false;
+        return emitNumber(sink);
+
+      case State::Keyword:
+        if (c != keyword_[keywordIndex_])
+          return DeserializationError::InvalidInput;
+        if (keyword_[++keywordIndex_] == '\0')
+          return emitKeyword(sink);
+        return DeserializationError::Ok;
+
+      default:
+        return DeserializationError::Ok;
+    }
+  }
+
+  DeserializationError::Code startString(TSink& sink) {
+    state_ = State::String;
+#if ARDUINOJSON_DECODE_UNICODE
+    codepoint_ = Utf16::Codepoint();
+#endif
+    sink.strings.startString();
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endString(TSink& sink) {
+    if (!sink.strings.isValid())
+      return DeserializationError::NoMemory;
+    if (isKey_) {
+      state_ = State::Colon;
+      return DeserializationError::Ok;
+    }
+    valueDone();
+    return sink.string();
+  }
+
+  DeserializationError::Code startKeyword(const char* keyword) {
+    state_ = State::Keyword;
+    keyword_ = keyword;
+    keywordIndex_ = 1;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endCollection(TSink& sink, bool object) {
+    depth_--;
+    valueDone();
+    return object ? sink.endObject() : sink.endArray();
+  }
+
+  State state_;
+  DeserializationError::Code error_;
+  size_t consumed_;
+  uint8_t depth_;
+  uint8_t maxDepth_;
+  uint32_t objects_;  // one bit per level, set for objects
+  bool isKey_;
+  char stopChar_;
+  const char* keyword_;
+  uint8_t keywordIndex_;
+  uint8_t numberLength_;
+  char number_[64];
+#if ARDUINOJSON_DECODE_UNICODE
+  Utf16::Codepoint codepoint_;
+  uint16_t codeunit_;
+  uint8_t hexDigits_;
+#endif
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses JSON input that arrives in pieces, for example in WebSocket frames,
+// without buffering the whole message.
+// T is either a JsonHandler or a JsonDocument.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename T>
+class JsonStreamParser {
+  static_assert(detail::is_base_of<JsonHandler<T>, T>::value,
+                "JsonStreamParser<T> requires a JsonHandler or a JsonDocument");
+
+ public:
+  explicit JsonStreamParser(
+      T& handler, DeserializationOption::NestingLimit nestingLimit = {})
+      : sink_(handler, strings_, sizeof(strings_)), parser_(nestingLimit) {}
+
+  // Parses the next piece of input.
+  // Returns IncompleteInput until the value is complete, then Ok.
+  DeserializationError feed(const char* data, size_t length) {
+    return parser_.feed(sink_, data, length);
+  }
+
+  DeserializationError feed(const uint8_t* data, size_t length) {
+    return feed(reinterpret_cast<const char*>(data), length);
+  }
+
+  // Returns the number of bytes that the last call to feed() used. Once the
+  // value is complete, or the handler stopped, the rest of the piece is left
+  // for the next message: reset() and feed() it again.
+  size_t consumed() const {
+    return parser_.consumed();
+  }
+
+  // Tells that there is no more input; completes a number at the root.
+  DeserializationError end() {
+    return parser_.end(sink_);
+  }
+
+  // Prepares the parser for the next message.
+  void reset() {
+    sink_.reset();
+    parser_.reset();
+  }
+
+ private:
+  char strings_[ARDUINOJSON_EVENT_STRING_CAPACITY];
+  detail::HandlerSink<T> sink_;
+  detail::IncrementalJsonParser<detail::HandlerSink<T>> parser_;
+};
+
+template <>
+class JsonStreamParser<JsonDocument> {
+ public:
+  // Clears the document and fills it as the input comes.
+  explicit JsonStreamParser(
+      JsonDocument& doc, DeserializationOption::NestingLimit nestingLimit = {})
+      : doc_(doc),
+        sink_(detail::VariantAttorney::getOrCreateData(doc),
+              detail::VariantAttorney::getResourceManager(doc)),
+        parser_(nestingLimit) {
+    doc_.clear();
+  }
+
+  // Parses the next piece of input.
+  // Returns IncompleteInput until the value is complete, then Ok.
+  DeserializationError feed(const char* data, size_t length) {
+    return done(parser_.feed(sink_, data, length));
+  }
+
+  DeserializationError feed(const uint8_t* data, size_t length) {
+    return feed(reinterpret_cast<const char*>(data), length);
+  }
+
+  // Returns the number of bytes that the last call to feed() used; once the
+  // value is complete, the rest of the piece belongs to the next message.
+  size_t consumed() const {
+    return parser_.consumed();
+  }
+
+  // Tells that there is no more input; completes a number at the root.
+  DeserializationError end() {
+    return done(parser_.end(sink_));
+  }
+
+  // Clears the document for the next message.
+  void reset() {
+    doc_.clear();
+    sink_.reset();
+    parser_.reset();
+  }
+
+ private:
+  DeserializationError::Code done(DeserializationError::Code err) {
+    if (err != DeserializationError::IncompleteInput)
+      detail::shrinkJsonDocument(doc_);
+    return err;
+  }
+
+  JsonDocument& doc_;
+  detail::VariantSink sink_;
+  detail::IncrementalJsonParser<detail::VariantSink> parser_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -40,6 +40,26 @@ class PrettyJsonSerializer : public JsonSerializer<TWriter> {
     return this->bytesWritten();
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  size_t visit(const PackedArrayData& array) {
+    if (array.size()) {
+      base::write("[\r\n");
+      nesting_++;
+      for (size_t i = 0; i < array.size(); i++) {
+        indent();
+        array.visitElement(i, *this);
+        base::write(i + 1 == array.size() ? "\r\n" : ",\r\n");
+      }
+      nesting_--;
+      indent();
+      base::write("]");
+    } else {
+      base::write("[]");
+    }
+    return this->bytesWritten();
+  }
+#endif
+
   size_t visit(const ObjectData& object) {
     auto it = object.createIterator(base::resources_);
     if (!it.done()) {
@@ -100,6 +120,14 @@ inline size_t serializeJsonPretty(JsonVariantConst source, void* buffer,
   return serialize<PrettyJsonSerializer>(source, buffer, bufferSize);
 }
 
+// Produces a prettified JSON document in a single pass, into a buffer sized
+// from the previous call.
+inline size_t serializeJsonPretty(JsonDocument& doc,
+                                  JsonOutputBuffer& output) {
+  using namespace ArduinoJson::detail;
+  return serialize<PrettyJsonSerializer>(doc, output);
+}
+
 // Computes the length of the document that serializeJsonPretty() produces.
 // https://arduinojson.org/v7/api/json/measurejsonpretty/
 inline size_t measureJsonPretty(JsonVariantConst source) {
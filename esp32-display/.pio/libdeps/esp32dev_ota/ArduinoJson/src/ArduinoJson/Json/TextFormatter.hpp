@@ -10,6 +10,9 @@
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
+#if ARDUINOJSON_SHORTEST_FLOAT
+#  include <ArduinoJson/Numbers/ShortestFloat.hpp>
+#endif
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -64,10 +67,70 @@ class TextFormatter {
     }
   }
 
+#if ARDUINOJSON_SHORTEST_FLOAT
+  template <typename T>
+  void writeFloat(T value) {
+    if (isnan(value))
+      return writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
+
+#  if ARDUINOJSON_ENABLE_INFINITY
+    if (value < 0) {
+      writeRaw('-');
+      value = -value;
+    }
+
+    if (isinf(value))
+      return writeRaw("Infinity");
+#  else
+    if (isinf(value))
+      return writeRaw("null");
+
+    if (value < 0) {
+      writeRaw('-');
+      value = -value;
+    }
+#  endif
+
+    if (value == 0)
+      return writeRaw('0');
+
+    auto parts = decomposeFloatShortest(value);
+    const char* digits = parts.digits;
+    int16_t length = parts.length;
+
+    // position of the decimal point relative to the first digit
+    int16_t point = int16_t(length + parts.exponent);
+
+    if (value >= ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD ||
+        value <= ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD) {
+      writeRaw(digits[0]);
+      if (length > 1) {
+        writeRaw('.');
+        writeRaw(digits + 1, digits + length);
+      }
+      writeRaw('e');
+      writeInteger(int16_t(point - 1));
+    } else if (point <= 0) {
+      writeRaw("0.");
+      for (int16_t i = point; i < 0; i++)
+        writeRaw('0');
+      writeRaw(digits, digits + length);
+    } else if (point < length) {
+      writeRaw(digits, digits + point);
+      writeRaw('.');
+      writeRaw(digits + point, digits + length);
+    } else {
+      writeRaw(digits, digits + length);
+      for (int16_t i = length; i < point; i++)
+        writeRaw('0');
+    }
+  }
+#else
   template <typename T>
   void writeFloat(T value) {
     writeFloat(JsonFloat(value), sizeof(T) >= 8 ? 9 : 6);
   }
+#endif
 
   void writeFloat(JsonFloat value, int8_t decimalPlaces) {
     if (isnan(value))
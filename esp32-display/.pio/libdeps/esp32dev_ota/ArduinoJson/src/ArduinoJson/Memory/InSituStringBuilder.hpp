@@ -0,0 +1,79 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Readers/InSituReader.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Writes the unescaped strings back into the input buffer, behind the reader,
+// and stores them as linked strings, so that nothing is allocated.
+class InSituStringBuilder {
+ public:
+  InSituStringBuilder(ResourceManager*) {}
+
+  void bind(InSituBuffer* buffer) {
+    buffer_ = buffer;
+  }
+
+  // Must be called when the reader is just past the opening quote (or the
+  // first character of a non-quoted key), which is where the string starts.
+  void startString() {
+    ARDUINOJSON_ASSERT(buffer_ != nullptr);
+    start_ = buffer_->ptr - 1;
+    size_ = 0;
+  }
+
+  void save(VariantData* variant) {
+    ARDUINOJSON_ASSERT(variant != nullptr);
+    start_[size_] = 0;
+    variant->setLinkedString(start_);
+  }
+
+  void append(char c) {
+    // an escape sequence is never shorter than the character it produces
+    ARDUINOJSON_ASSERT(start_ + size_ < buffer_->ptr);
+    start_[size_++] = c;
+  }
+
+  bool isValid() const {
+    return true;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  JsonString str() const {
+    start_[size_] = 0;
+    return JsonString(start_, size_);
+  }
+
+ private:
+  InSituBuffer* buffer_ = nullptr;
+  char* start_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename TReader>
+struct StringBuilderFor {
+  using type = StringBuilder;
+};
+
+template <>
+struct StringBuilderFor<InSituReader> {
+  using type = InSituStringBuilder;
+};
+
+template <typename TReader>
+inline void bindStringBuilder(StringBuilder&, const TReader&) {}
+
+inline void bindStringBuilder(InSituStringBuilder& builder,
+                              const InSituReader& reader) {
+  builder.bind(reader.buffer());
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Memory/PoolPolicy.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
@@ -60,6 +61,7 @@ class MemoryPoolList {
     swap_(a.count_, b.count_);
     swap_(a.capacity_, b.capacity_);
     swap_(a.freeList_, b.freeList_);
+    swap_(a.policy_, b.policy_);
   }
 
   MemoryPoolList& operator=(MemoryPoolList&& src) {
@@ -74,6 +76,7 @@ class MemoryPoolList {
     }
     count_ = src.count_;
     capacity_ = src.capacity_;
+    policy_ = src.policy_;
     src.count_ = 0;
     src.capacity_ = 0;
     return *this;
@@ -137,6 +140,35 @@ class MemoryPoolList {
     return Pool::slotsToBytes(usage());
   }
 
+  // Returns the number of slots in the free list
+  SlotCount freeSlots() const {
+    SlotCount count = 0;
+    for (SlotId id = freeList_; id != NULL_SLOT;
+         id = reinterpret_cast<const FreeSlot*>(getSlot(id))->next)
+      count++;
+    return count;
+  }
+
+  // Returns the number of bytes allocated but not in use: the end of the
+  // pools and the pool array
+  size_t overhead() const {
+    size_t total = 0;
+    for (PoolCount i = 0; i < count_; i++)
+      total += Pool::slotsToBytes(
+          SlotCount(pools_[i].capacity() - pools_[i].usage()));
+    if (pools_ != preallocatedPools_)
+      total += capacity_ * sizeof(Pool);
+    return total;
+  }
+
+  void setPolicy(PoolPolicy policy) {
+    policy_ = policy;
+  }
+
+  PoolPolicy policy() const {
+    return policy_;
+  }
+
   void shrinkToFit(Allocator* allocator) {
     if (count_ > 0)
       pools_[count_ - 1].shrinkToFit(allocator);
@@ -170,9 +202,11 @@ class MemoryPoolList {
   Pool* addPool(Allocator* allocator) {
     if (count_ == capacity_ && !increaseCapacity(allocator))
       return nullptr;
-    auto pool = &pools_[count_++];
-    SlotCount poolCapacity = ARDUINOJSON_POOL_CAPACITY;
-    if (count_ == maxPools)  // last pool is smaller because of NULL_SLOT
+    auto pool = &pools_[count_];
+    auto poolCapacity = SlotCount(policy_.poolCapacity(count_));
+    count_++;
+    if (count_ == maxPools &&
+        poolCapacity == ARDUINOJSON_POOL_CAPACITY)  // NULL_SLOT is reserved
       poolCapacity--;
     pool->create(poolCapacity, allocator);
     return pool;
@@ -205,6 +239,7 @@ class MemoryPoolList {
   PoolCount count_ = 0;
   PoolCount capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
   SlotId freeList_ = NULL_SLOT;
+  PoolPolicy policy_;
 
  public:
   static const PoolCount maxPools =
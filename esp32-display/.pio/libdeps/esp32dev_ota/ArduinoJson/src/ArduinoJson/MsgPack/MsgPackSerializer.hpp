@@ -48,16 +48,7 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
   }
 
   size_t visit(const ArrayData& array) {
-    size_t n = array.size(resources_);
-    if (n < 0x10) {
-      writeByte(uint8_t(0x90 + n));
-    } else if (n < 0x10000) {
-      writeByte(0xDC);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDD);
-      writeInteger(uint32_t(n));
-    }
+    writeArrayHeader(array.size(resources_));
 
     auto slotId = array.head();
     while (slotId != NULL_SLOT) {
@@ -69,6 +60,15 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     return bytesWritten();
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  size_t visit(const PackedArrayData& array) {
+    writeArrayHeader(array.size());
+    for (size_t i = 0; i < array.size(); i++)
+      array.visitElement(i, *this);
+    return bytesWritten();
+  }
+#endif
+
   size_t visit(const ObjectData& object) {
     size_t n = object.size(resources_);
     if (n < 0x10) {
@@ -202,6 +202,18 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     writer_.write(p, n);
   }
 
+  void writeArrayHeader(size_t n) {
+    if (n < 0x10) {
+      writeByte(uint8_t(0x90 + n));
+    } else if (n < 0x10000) {
+      writeByte(0xDC);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(0xDD);
+      writeInteger(uint32_t(n));
+    }
+  }
+
   template <typename T>
   void writeInteger(T value) {
     fixEndianness(value);
@@ -234,6 +246,13 @@ inline size_t serializeMsgPack(JsonVariantConst source, void* output,
   return serialize<MsgPackSerializer>(source, output, size);
 }
 
+// Produces a MessagePack document in a single pass, into a buffer sized from
+// the previous call.
+inline size_t serializeMsgPack(JsonDocument& doc, JsonOutputBuffer& output) {
+  using namespace ArduinoJson::detail;
+  return serialize<MsgPackSerializer>(doc, output);
+}
+
 // Computes the length of the document that serializeMsgPack() produces.
 // https://arduinojson.org/v7/api/msgpack/measuremsgpack/
 inline size_t measureMsgPack(JsonVariantConst source) {
@@ -75,6 +75,24 @@ class Number {
     }
   }
 
+  template <typename T>
+  bool canConvertTo() const {
+    switch (type_) {
+      case NumberType::Float:
+        return canConvertNumber<T>(value_.asFloat);
+      case NumberType::SignedInteger:
+        return canConvertNumber<T>(value_.asSignedInteger);
+      case NumberType::UnsignedInteger:
+        return canConvertNumber<T>(value_.asUnsignedInteger);
+#if ARDUINOJSON_USE_DOUBLE
+      case NumberType::Double:
+        return canConvertNumber<T>(value_.asDouble);
+#endif
+      default:
+        return false;
+    }
+  }
+
   NumberType type() const {
     return type_;
   }
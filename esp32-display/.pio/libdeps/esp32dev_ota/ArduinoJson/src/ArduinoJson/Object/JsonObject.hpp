@@ -64,6 +64,14 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
     return data_ ? data_->size(resources_) : 0;
   }
 
+  // Makes lookups with a JsonKey compare the key hashes instead of the
+  // characters, until a member is removed or the object is cleared. Only the
+  // last ARDUINOJSON_OBJECT_INDEX_COUNT objects are indexed; returns false if
+  // out of memory or if indexing is disabled.
+  bool buildIndex() const {
+    return detail::ObjectData::buildIndex(data_, resources_);
+  }
+
   // Returns an iterator to the first key-value pair of the object.
   // https://arduinojson.org/v7/api/jsonobject/begin/
   iterator begin() const {
@@ -0,0 +1,113 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+
+#if ARDUINOJSON_OBJECT_INDEX_COUNT
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+class CollectionData;
+
+// Remembers the hashes of the keys of the last objects passed to
+// ObjectData::buildIndex(), so that a lookup with a JsonKey compares characters
+// only when the hashes match. Appending keeps an entry valid, although the new
+// members are not in it; removing a member or clearing the object drops it.
+class ObjectIndex {
+ public:
+  struct Member {
+    uint32_t hash;
+    SlotId key;
+  };
+
+  struct Entry {
+    const CollectionData* object;
+    SlotId head;
+    SlotCount size;
+    SlotCount capacity;
+    Member* members;
+  };
+
+  ObjectIndex() : next_(0) {
+    for (auto& entry : entries_)
+      entry = Entry{nullptr, NULL_SLOT, 0, 0, nullptr};
+  }
+
+  // Returns the entry of the object, or null if it's not indexed.
+  const Entry* find(const CollectionData* object, SlotId head) const {
+    for (auto& entry : entries_) {
+      if (entry.object == object && entry.head == head)
+        return &entry;
+    }
+    return nullptr;
+  }
+
+  // Returns an empty entry for the object, recycling the oldest one if needed.
+  Entry& create(const CollectionData* object, SlotId head) {
+    for (auto& entry : entries_) {
+      if (entry.object == object && entry.head == head) {
+        entry.size = 0;
+        return entry;
+      }
+    }
+    Entry& entry = entries_[next_];
+    next_ = uint8_t((next_ + 1) % ARDUINOJSON_OBJECT_INDEX_COUNT);
+    entry.object = object;
+    entry.head = head;
+    entry.size = 0;
+    return entry;
+  }
+
+  // Adds the next member; returns false if out of memory.
+  static bool append(Entry& entry, uint32_t hash, SlotId key,
+                     Allocator* allocator) {
+    if (entry.size == entry.capacity) {
+      SlotCount capacity = SlotCount(entry.capacity ? entry.capacity * 2 : 8);
+      if (capacity <= entry.capacity)
+        return false;  // SlotCount overflow
+      auto members = reinterpret_cast<Member*>(
+          allocator->reallocate(entry.members, capacity * sizeof(Member)));
+      if (!members)
+        return false;
+      entry.members = members;
+      entry.capacity = capacity;
+    }
+    entry.members[entry.size++] = Member{hash, key};
+    return true;
+  }
+
+  void invalidate(const CollectionData* object) {
+    for (auto& entry : entries_) {
+      if (entry.object == object)
+        entry.object = nullptr;
+    }
+  }
+
+  // Returns the number of bytes allocated for the members
+  size_t size() const {
+    size_t total = 0;
+    for (auto& entry : entries_)
+      total += entry.capacity * sizeof(Member);
+    return total;
+  }
+
+  void clear(Allocator* allocator) {
+    for (auto& entry : entries_) {
+      if (entry.members)
+        allocator->deallocate(entry.members);
+      entry = Entry{nullptr, NULL_SLOT, 0, 0, nullptr};
+    }
+  }
+
+ private:
+  Entry entries_[ARDUINOJSON_OBJECT_INDEX_COUNT];
+  uint8_t next_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+#endif
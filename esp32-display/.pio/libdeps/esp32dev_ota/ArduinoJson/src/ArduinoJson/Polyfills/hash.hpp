@@ -0,0 +1,29 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// FNV-1a, in a form that can run at compile time (C++11 constexpr functions
+// can't have loops)
+constexpr uint32_t hashString(const char* s, size_t n,
+                              uint32_t hash = 2166136261u) {
+  return n ? hashString(s + 1, n - 1, (hash ^ uint8_t(*s)) * 16777619u) : hash;
+}
+
+// Same as above, without relying on the compiler to remove the recursion
+inline uint32_t hashBytes(const char* s, size_t n) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < n; i++)
+    hash = (hash ^ uint8_t(s[i])) * 16777619u;
+  return hash;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -28,6 +28,11 @@ struct uint_<32> {
   using type = uint32_t;
 };
 
+template <>
+struct uint_<64> {
+  using type = uint64_t;
+};
+
 template <int Bits>
 using uint_t = typename uint_<Bits>::type;
 
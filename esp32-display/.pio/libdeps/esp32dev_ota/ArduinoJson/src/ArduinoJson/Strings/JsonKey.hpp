@@ -0,0 +1,52 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/hash.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// strlen() in a form that can run at compile time
+constexpr size_t constStrlen(const char* s, size_t n = 0) {
+  return s[n] ? constStrlen(s, n + 1) : n;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A key whose length and hash are computed at compile time when it's a
+// literal. Lookups with a JsonKey compare hashes before comparing characters
+// in the objects indexed with JsonObject::buildIndex().
+//   constexpr JsonKey kPrice("price");
+//   float price = doc[kPrice];
+// Like a char*, the key is copied when it adds a member, so the string only
+// has to outlive the JsonKey.
+class JsonKey {
+ public:
+  constexpr JsonKey(const char* s)
+      : str_(s),
+        size_(s ? detail::constStrlen(s) : 0),
+        hash_(detail::hashString(s, size_)) {}
+
+  constexpr const char* c_str() const {
+    return str_;
+  }
+
+  constexpr size_t size() const {
+    return size_;
+  }
+
+  constexpr uint32_t hash() const {
+    return hash_;
+  }
+
+ private:
+  const char* str_;
+  size_t size_;
+  uint32_t hash_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
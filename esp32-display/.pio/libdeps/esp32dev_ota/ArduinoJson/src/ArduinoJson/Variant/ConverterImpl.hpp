@@ -328,10 +328,15 @@ struct Converter<JsonArrayConst> : private detail::VariantAttorney {
       dst.to<JsonArray>().set(src);
   }
 
+  // A packed array is read where it is, only a JsonArray unpacks it
   static JsonArrayConst fromJson(JsonVariantConst src) {
     auto data = getData(src);
-    auto array = data ? data->asArray() : nullptr;
-    return JsonArrayConst(array, getResourceManager(src));
+    auto resources = getResourceManager(src);
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (data && data->isPackedArray())
+      return JsonArrayConst(data, resources);
+#endif
+    return JsonArrayConst(data ? data->asArray() : nullptr, resources);
   }
 
   static bool checkJson(JsonVariantConst src) {
@@ -352,7 +357,7 @@ struct Converter<JsonArray> : private detail::VariantAttorney {
   static JsonArray fromJson(JsonVariant src) {
     auto data = getData(src);
     auto resources = getResourceManager(src);
-    return JsonArray(data != 0 ? data->asArray() : 0, resources);
+    return JsonArray(data != 0 ? data->asArray(resources) : 0, resources);
   }
 
   static bool checkJson(JsonVariant src) {
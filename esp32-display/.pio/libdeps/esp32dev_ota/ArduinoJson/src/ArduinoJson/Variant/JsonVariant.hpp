@@ -65,8 +65,10 @@ struct Converter<JsonVariantConst> : private detail::VariantAttorney {
     copyVariant(dst, src);
   }
 
+  // A copy, not a new reference to the data: an element of a packed array is
+  // in the reference itself
   static JsonVariantConst fromJson(JsonVariantConst src) {
-    return JsonVariantConst(getData(src), getResourceManager(src));
+    return src;
   }
 
   static bool checkJson(JsonVariantConst src) {
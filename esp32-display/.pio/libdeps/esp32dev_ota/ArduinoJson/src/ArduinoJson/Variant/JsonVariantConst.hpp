@@ -42,6 +42,28 @@ class JsonVariantConst : public detail::VariantTag,
                             const detail::ResourceManager* resources)
       : data_(data), resources_(resources) {}
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // INTERNAL USE ONLY
+  // An element of a packed array has no slot, so the reference keeps a copy
+  JsonVariantConst(const detail::PackedArrayData& array, size_t index,
+                   const detail::ResourceManager* resources)
+      : data_(&element_),
+        resources_(resources),
+        element_(detail::VariantData::packedElement(array, index)) {}
+
+  JsonVariantConst(const JsonVariantConst& src)
+      : data_(src.data_ == &src.element_ ? &element_ : src.data_),
+        resources_(src.resources_),
+        element_(src.element_) {}
+
+  JsonVariantConst& operator=(const JsonVariantConst& src) {
+    element_ = src.element_;
+    data_ = src.data_ == &src.element_ ? &element_ : src.data_;
+    resources_ = src.resources_;
+    return *this;
+  }
+#endif
+
   // Returns true if the value is null or the reference is unbound.
   // https://arduinojson.org/v7/api/jsonvariantconst/isnull/
   bool isNull() const {
@@ -104,6 +126,14 @@ class JsonVariantConst : public detail::VariantTag,
   template <typename T,
             detail::enable_if_t<detail::is_integral<T>::value, int> = 0>
   JsonVariantConst operator[](T index) const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (data_ && data_->isPackedArray()) {
+      auto array = data_->asPackedArray();
+      if (size_t(index) >= array.size())
+        return JsonVariantConst();
+      return JsonVariantConst(array, size_t(index), resources_);
+    }
+#endif
     return JsonVariantConst(
         detail::VariantData::getElement(data_, size_t(index), resources_),
         resources_);
@@ -192,6 +222,9 @@ class JsonVariantConst : public detail::VariantTag,
  private:
   const detail::VariantData* data_;
   const detail::ResourceManager* resources_;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  detail::VariantData element_;  // see the packed array constructor
+#endif
 };
 
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Array/JsonSpan.hpp>
 #include <ArduinoJson/Variant/JsonVariant.hpp>
 #include <ArduinoJson/Variant/JsonVariantVisitor.hpp>
 
@@ -20,6 +21,25 @@ class JsonVariantCopier {
     return dst_.set(src);
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // The copy stays packed
+  bool visit(const PackedArrayData& src) {
+    switch (src.type()) {
+      case PackedArrayType::Int32:
+        return dst_.set(JsonSpan<int32_t>(
+            static_cast<const int32_t*>(src.data()), src.size()));
+#  if ARDUINOJSON_USE_DOUBLE
+      case PackedArrayType::Double:
+        return dst_.set(
+            JsonSpan<double>(static_cast<const double*>(src.data()), src.size()));
+#  endif
+      default:
+        return dst_.set(
+            JsonSpan<float>(static_cast<const float*>(src.data()), src.size()));
+    }
+  }
+#endif
+
  private:
   JsonVariant dst_;
 };
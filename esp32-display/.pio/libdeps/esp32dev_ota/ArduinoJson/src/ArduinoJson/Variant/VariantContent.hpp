@@ -7,6 +7,7 @@
 #include <stddef.h>  // size_t
 
 #include <ArduinoJson/Array/ArrayData.hpp>
+#include <ArduinoJson/Array/PackedArrayData.hpp>
 #include <ArduinoJson/Numbers/JsonFloat.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
 #include <ArduinoJson/Object/ObjectData.hpp>
@@ -20,6 +21,9 @@ enum class VariantTypeBits : uint8_t {
   ExtensionBit = 0x10,  // 0001 0000
 #endif
   CollectionMask = 0x60,
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  PackedArrayBit = 0x80,  // 1000 0000
+#endif
 };
 
 enum class VariantType : uint8_t {
@@ -29,6 +33,10 @@ enum class VariantType : uint8_t {
   LinkedString = 0x04,  // 0000 0100
   OwnedString = 0x05,   // 0000 0101
   Boolean = 0x06,       // 0000 0110
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+  // Only in copies of elements of a packed array, see packedElement()
+  PackedDouble = 0x08,  // 0000 1000
+#endif
   Uint32 = 0x0A,        // 0000 1010
   Int32 = 0x0C,         // 0000 1100
   Float = 0x0E,         // 0000 1110
@@ -41,6 +49,14 @@ enum class VariantType : uint8_t {
 #endif
   Object = 0x20,
   Array = 0x40,
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // 0x80 | PackedArrayType << 1 | OwnedStringBit
+  PackedInt32Array = 0x81,  // 1000 0001
+  PackedFloatArray = 0x83,  // 1000 0011
+#  if ARDUINOJSON_USE_DOUBLE
+  PackedDoubleArray = 0x85,  // 1000 0101
+#  endif
+#endif
 };
 
 inline bool operator&(VariantType type, VariantTypeBits bit) {
@@ -65,6 +81,9 @@ union VariantContent {
   const char* asLinkedString;
   struct StringNode* asOwnedString;
   char asTinyString[tinyStringMaxLength + 1];
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+  const char* asPackedDouble;  // in the packed array, maybe unaligned
+#endif
 };
 
 #if ARDUINOJSON_USE_EXTENSIONS
@@ -67,12 +67,26 @@ class VariantData {
         return visit.visit(extension->asDouble);
 #endif
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+      case VariantType::PackedDouble:
+        return visit.visit(readPackedDouble());
+#endif
+
       case VariantType::Array:
         return visit.visit(content_.asArray);
 
       case VariantType::Object:
         return visit.visit(content_.asObject);
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+      case VariantType::PackedInt32Array:
+      case VariantType::PackedFloatArray:
+#  if ARDUINOJSON_USE_DOUBLE
+      case VariantType::PackedDoubleArray:
+#  endif
+        return visit.visit(asPackedArray());
+#endif
+
       case VariantType::TinyString:
         return visit.visit(JsonString(content_.asTinyString));
 
@@ -120,7 +134,7 @@ class VariantData {
   }
 
   VariantData* addElement(ResourceManager* resources) {
-    auto array = isNull() ? &toArray() : asArray();
+    auto array = isNull() ? &toArray() : asArray(resources);
     return detail::ArrayData::addElement(array, resources);
   }
 
@@ -132,7 +146,7 @@ class VariantData {
 
   template <typename T>
   bool addValue(const T& value, ResourceManager* resources) {
-    auto array = isNull() ? &toArray() : asArray();
+    auto array = isNull() ? &toArray() : asArray(resources);
     return detail::ArrayData::addValue(array, value, resources);
   }
 
@@ -161,6 +175,10 @@ class VariantData {
 #if ARDUINOJSON_USE_DOUBLE
       case VariantType::Double:
         return extension->asDouble != 0;
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+      case VariantType::PackedDouble:
+        return readPackedDouble() != 0;
 #endif
       case VariantType::Null:
         return false;
@@ -175,13 +193,61 @@ class VariantData {
   }
 
   ArrayData* asArray() {
-    return isArray() ? &content_.asArray : 0;
+    return type_ == VariantType::Array ? &content_.asArray : 0;
   }
 
   const ArrayData* asArray() const {
     return const_cast<VariantData*>(this)->asArray();
   }
 
+  // Same as asArray(), but converts a packed array to a regular one first
+  ArrayData* asArray(ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    unpackArray(resources);
+#else
+    (void)resources;  // silence warning
+#endif
+    return asArray();
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  PackedArrayData asPackedArray() const {
+    ARDUINOJSON_ASSERT(isPackedArray());
+    return PackedArrayData(PackedArrayType((uint8_t(type_) >> 1) & 3),
+                           content_.asOwnedString);
+  }
+
+  // Replaces a packed array with a regular one, so that its elements can be
+  // accessed as variants. Returns false if there isn't enough memory, in which
+  // case the array stays packed and the document reports an overflow.
+  bool unpackArray(ResourceManager* resources);
+
+  // A copy of an element of a packed array, for reading it through a
+  // JsonVariantConst, as the element has no slot. A double is read where it is
+  // in the array, so the copy needs no extension.
+  static VariantData packedElement(const PackedArrayData& array, size_t index) {
+    VariantData element;
+    switch (array.type()) {
+      case PackedArrayType::Int32:
+        element.type_ = VariantType::Int32;
+        element.content_.asInt32 = array.get<int32_t>(index);
+        break;
+#  if ARDUINOJSON_USE_DOUBLE
+      case PackedArrayType::Double:
+        element.type_ = VariantType::PackedDouble;
+        element.content_.asPackedDouble =
+            static_cast<const char*>(array.data()) + index * sizeof(double);
+        break;
+#  endif
+      default:
+        element.type_ = VariantType::Float;
+        element.content_.asFloat = array.get<float>(index);
+        break;
+    }
+    return element;
+  }
+#endif
+
   CollectionData* asCollection() {
     return isCollection() ? &content_.asCollection : 0;
   }
@@ -226,6 +292,10 @@ class VariantData {
 #if ARDUINOJSON_USE_DOUBLE
       case VariantType::Double:
         return static_cast<T>(extension->asDouble);
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+      case VariantType::PackedDouble:
+        return static_cast<T>(readPackedDouble());
 #endif
       default:
         return 0.0;
@@ -271,6 +341,10 @@ class VariantData {
 #if ARDUINOJSON_USE_DOUBLE
       case VariantType::Double:
         return convertNumber<T>(extension->asDouble);
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+      case VariantType::PackedDouble:
+        return convertNumber<T>(readPackedDouble());
 #endif
       default:
         return 0;
@@ -318,6 +392,7 @@ class VariantData {
 
   VariantData* getElement(size_t index,
                           const ResourceManager* resources) const {
+    // A packed array has no slots to point to, until something unpacks it
     return ArrayData::getElement(asArray(), index, resources);
   }
 
@@ -341,7 +416,7 @@ class VariantData {
   }
 
   VariantData* getOrAddElement(size_t index, ResourceManager* resources) {
-    auto array = isNull() ? &toArray() : asArray();
+    auto array = isNull() ? &toArray() : asArray(resources);
     if (!array)
       return nullptr;
     return array->getOrAddElement(index, resources);
@@ -358,9 +433,19 @@ class VariantData {
   }
 
   bool isArray() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPackedArray())
+      return true;
+#endif
     return type_ == VariantType::Array;
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  bool isPackedArray() const {
+    return type_ & VariantTypeBits::PackedArrayBit;
+  }
+#endif
+
   bool isBoolean() const {
     return type_ == VariantType::Boolean;
   }
@@ -424,8 +509,11 @@ class VariantData {
     auto collection = asCollection();
     if (collection)
       return collection->nesting(resources);
-    else
-      return 0;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPackedArray())
+      return 1;
+#endif
+    return 0;
   }
 
   static size_t nesting(const VariantData* var,
@@ -436,7 +524,7 @@ class VariantData {
   }
 
   void removeElement(size_t index, ResourceManager* resources) {
-    ArrayData::removeElement(asArray(), index, resources);
+    ArrayData::removeElement(asArray(resources), index, resources);
   }
 
   static void removeElement(VariantData* var, size_t index,
@@ -543,6 +631,15 @@ class VariantData {
     content_.asTinyString[n] = 0;
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  void setPackedArray(PackedArrayType type, StringNode* s) {
+    ARDUINOJSON_ASSERT(type_ == VariantType::Null);  // must call clear() first
+    ARDUINOJSON_ASSERT(s);
+    type_ = VariantType(0x81 | (uint8_t(type) << 1));
+    content_.asOwnedString = s;
+  }
+#endif
+
   void setOwnedString(StringNode* s) {
     ARDUINOJSON_ASSERT(type_ == VariantType::Null);  // must call clear() first
     ARDUINOJSON_ASSERT(s);
@@ -554,9 +651,14 @@ class VariantData {
     if (isObject())
       return content_.asObject.size(resources);
 
-    if (isArray())
+    if (type_ == VariantType::Array)
       return content_.asArray.size(resources);
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPackedArray())
+      return asPackedArray().size();
+#endif
+
     return 0;
   }
 
@@ -604,6 +706,15 @@ class VariantData {
       return;
     var->clear(resources);
   }
+
+ private:
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS && ARDUINOJSON_USE_DOUBLE
+  double readPackedDouble() const {
+    double value;
+    memcpy(&value, content_.asPackedDouble, sizeof(double));
+    return value;
+  }
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -61,6 +61,45 @@ inline void VariantData::clear(ResourceManager* resources) {
   type_ = VariantType::Null;
 }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+inline bool VariantData::unpackArray(ResourceManager* resources) {
+  if (!isPackedArray())
+    return true;
+
+  PackedArrayData packed = asPackedArray();
+  ArrayData array;
+  for (size_t i = 0; i < packed.size(); i++) {
+    auto element = array.addElement(resources);
+    bool ok = element != nullptr;
+    if (ok) {
+      switch (packed.type()) {
+        case PackedArrayType::Int32:
+          ok = element->setInteger(packed.get<int32_t>(i), resources);
+          break;
+#  if ARDUINOJSON_USE_DOUBLE
+        case PackedArrayType::Double:
+          ok = element->setFloat(packed.get<double>(i), resources);
+          break;
+#  endif
+        default:
+          ok = element->setFloat(packed.get<float>(i), resources);
+          break;
+      }
+    }
+    if (!ok) {
+      // keep the packed array
+      array.clear(resources);
+      return false;
+    }
+  }
+
+  resources->dereferenceString(content_.asOwnedString->data);
+  type_ = VariantType::Array;
+  new (&content_.asArray) ArrayData(array);
+  return true;
+}
+#endif
+
 #if ARDUINOJSON_USE_EXTENSIONS
 inline const VariantExtension* VariantData::getExtension(
     const ResourceManager* resources) const {
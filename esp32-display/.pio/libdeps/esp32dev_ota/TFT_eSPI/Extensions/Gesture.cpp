@@ -0,0 +1,272 @@
+/***************************************************************************************
+** Code for the touch gesture recogniser
+***************************************************************************************/
+
+#define GESTURE_SHARED_CELL 0x80
+
+/***************************************************************************************
+** Function name:           TFT_eSPI_Gesture
+** Description:             Constructor
+***************************************************************************************/
+TFT_eSPI_Gesture::TFT_eSPI_Gesture(void)
+{
+  _count  = 0;
+  _grid   = nullptr;
+  _cols   = 0;
+  _rows   = 0;
+  _dirty  = 0;
+  _down   = false;
+  _moved  = false;
+  _held   = false;
+  _widget = -1;
+}
+
+/***************************************************************************************
+** Function name:           ~TFT_eSPI_Gesture
+** Description:             Destructor, frees the hit test grid
+***************************************************************************************/
+TFT_eSPI_Gesture::~TFT_eSPI_Gesture(void)
+{
+  if (_grid) free(_grid);
+}
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Allocate the hit test grid, returns false if out of memory
+***************************************************************************************/
+bool TFT_eSPI_Gesture::begin(uint16_t width, uint16_t height)
+{
+  if (_grid) free(_grid);
+  _cols = (width  + (1 << GESTURE_GRID_SHIFT) - 1) >> GESTURE_GRID_SHIFT;
+  _rows = (height + (1 << GESTURE_GRID_SHIFT) - 1) >> GESTURE_GRID_SHIFT;
+  _grid = (uint8_t*)malloc(_cols * _rows);
+  if (!_grid) { _cols = _rows = 0; return false; }
+  rebuildGrid();
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           addButton
+** Description:             Register a button, returns its widget index
+***************************************************************************************/
+int8_t TFT_eSPI_Gesture::addButton(TFT_eSPI_Button *button)
+{
+  int8_t index = addArea(button->_x1, button->_y1, button->_w, button->_h);
+  if (index >= 0) {
+    _widgets[index].button = button;
+    _dirty |= 1UL << index;  // Drawn by the next drawDirtyButtons()
+  }
+  return index;
+}
+
+/***************************************************************************************
+** Function name:           addArea
+** Description:             Register a screen area, returns its widget index
+***************************************************************************************/
+int8_t TFT_eSPI_Gesture::addArea(int16_t x, int16_t y, uint16_t w, uint16_t h)
+{
+  if (_count >= GESTURE_MAX_WIDGETS || _count >= 32) return -1;
+
+  widget_t &widget = _widgets[_count];
+  widget.x = x;
+  widget.y = y;
+  widget.w = w;
+  widget.h = h;
+  widget.button = nullptr;
+
+  // Mark the cells overlapped by the widget, it is on top of the previous ones
+  if (_grid && w && h) {
+    int32_t c0 = max(x, (int16_t)0) >> GESTURE_GRID_SHIFT;
+    int32_t r0 = max(y, (int16_t)0) >> GESTURE_GRID_SHIFT;
+    int32_t c1 = min((int32_t)(x + w - 1) >> GESTURE_GRID_SHIFT, (int32_t)_cols - 1);
+    int32_t r1 = min((int32_t)(y + h - 1) >> GESTURE_GRID_SHIFT, (int32_t)_rows - 1);
+    for (int32_t r = r0; r <= r1; r++) {
+      for (int32_t c = c0; c <= c1; c++) {
+        uint8_t &cell = _grid[r * _cols + c];
+        cell = (cell ? GESTURE_SHARED_CELL : 0) | (_count + 1);
+      }
+    }
+  }
+
+  return _count++;
+}
+
+/***************************************************************************************
+** Function name:           clearWidgets
+** Description:             Remove all the widgets
+***************************************************************************************/
+void TFT_eSPI_Gesture::clearWidgets(void)
+{
+  _count  = 0;
+  _dirty  = 0;
+  _widget = -1;
+  rebuildGrid();
+}
+
+/***************************************************************************************
+** Function name:           rebuildGrid
+** Description:             Clear the hit test grid
+***************************************************************************************/
+void TFT_eSPI_Gesture::rebuildGrid(void)
+{
+  if (!_grid) return;
+  memset(_grid, 0, _cols * _rows);
+
+  // Register the widgets again
+  uint8_t count = _count;
+  _count = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    TFT_eSPI_Button *button = _widgets[i].button;
+    addArea(_widgets[i].x, _widgets[i].y, _widgets[i].w, _widgets[i].h);
+    _widgets[i].button = button;
+  }
+}
+
+/***************************************************************************************
+** Function name:           hitTest
+** Description:             Index of the top widget containing a point, -1 if none
+***************************************************************************************/
+int8_t TFT_eSPI_Gesture::hitTest(int16_t x, int16_t y)
+{
+  uint8_t cell = GESTURE_SHARED_CELL;
+  if (_grid) {
+    if (x < 0 || y < 0 || (x >> GESTURE_GRID_SHIFT) >= _cols || (y >> GESTURE_GRID_SHIFT) >= _rows) return -1;
+    cell = _grid[(y >> GESTURE_GRID_SHIFT) * _cols + (x >> GESTURE_GRID_SHIFT)];
+    if (!cell) return -1;
+  }
+
+  // A cell shared by several widgets (or no grid) is resolved by checking them all, top first
+  int8_t i = (cell & GESTURE_SHARED_CELL) ? _count - 1 : (cell & ~GESTURE_SHARED_CELL) - 1;
+  int8_t last = (cell & GESTURE_SHARED_CELL) ? 0 : i;
+  for (; i >= last; i--) {
+    const widget_t &w = _widgets[i];
+    if (x >= w.x && x < w.x + w.w && y >= w.y && y < w.y + w.h) return i;
+  }
+  return -1;
+}
+
+/***************************************************************************************
+** Function name:           handleEvent
+** Description:             Process a touch event, returns true if a gesture is complete
+***************************************************************************************/
+bool TFT_eSPI_Gesture::handleEvent(const touch_event_t *event, gesture_t *gesture)
+{
+  _x = event->x;
+  _y = event->y;
+
+  switch (event->type) {
+    case TOUCH_EVENT_DOWN:
+      _down   = true;
+      _moved  = false;
+      _held   = false;
+      _x0     = _x;
+      _y0     = _y;
+      _t0     = event->time;
+      _widget = hitTest(_x, _y);
+      setPressed(true);
+      return false;
+
+    case TOUCH_EVENT_MOVE:
+    case TOUCH_EVENT_UP: {
+      if (!_down) return false;
+      if (!_moved && (abs(_x - _x0) > GESTURE_TAP_SLOP || abs(_y - _y0) > GESTURE_TAP_SLOP)) {
+        _moved = true;
+        setPressed(false); // Sliding off a button cancels it
+      }
+      if (event->type == TOUCH_EVENT_MOVE) return false;
+
+      _down = false;
+      bool released = !_moved;
+      setPressed(false);
+
+      if (_held) return false; // Already reported as a long press
+
+      if (released) {
+        fill(gesture, GESTURE_TAP, event->time);
+        return true;
+      }
+
+      int16_t dx = _x - _x0, dy = _y - _y0;
+      if (event->time - _t0 > GESTURE_SWIPE_MAX_MS) return false;
+      if (abs(dx) >= GESTURE_SWIPE_MIN && abs(dx) > 2 * abs(dy)) {
+        fill(gesture, dx < 0 ? GESTURE_SWIPE_LEFT : GESTURE_SWIPE_RIGHT, event->time);
+        return true;
+      }
+      if (abs(dy) >= GESTURE_SWIPE_MIN && abs(dy) > 2 * abs(dx)) {
+        fill(gesture, dy < 0 ? GESTURE_SWIPE_UP : GESTURE_SWIPE_DOWN, event->time);
+        return true;
+      }
+      return false;
+    }
+  }
+  return false;
+}
+
+/***************************************************************************************
+** Function name:           poll
+** Description:             Report a long press once the touch has been held long enough
+***************************************************************************************/
+bool TFT_eSPI_Gesture::poll(uint32_t time, gesture_t *gesture)
+{
+  if (!_down || _moved || _held || time - _t0 < GESTURE_LONG_PRESS_MS) return false;
+  _held = true;
+  fill(gesture, GESTURE_LONG_PRESS, time);
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           nextDirty
+** Description:             Index of a button to redraw, -1 if none
+***************************************************************************************/
+int8_t TFT_eSPI_Gesture::nextDirty(void)
+{
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_dirty & (1UL << i)) {
+      _dirty &= ~(1UL << i);
+      return i;
+    }
+  }
+  return -1;
+}
+
+/***************************************************************************************
+** Function name:           drawDirtyButtons
+** Description:             Redraw the buttons whose pressed state changed
+***************************************************************************************/
+void TFT_eSPI_Gesture::drawDirtyButtons(void)
+{
+  int8_t i;
+  while ((i = nextDirty()) >= 0) {
+    TFT_eSPI_Button *button = _widgets[i].button;
+    if (button && button->_gfx) button->drawButton(button->isPressed());
+  }
+}
+
+/***************************************************************************************
+** Function name:           setPressed
+** Description:             Press or release the button under the touch down point
+***************************************************************************************/
+void TFT_eSPI_Gesture::setPressed(bool pressed)
+{
+  if (_widget < 0) return;
+  TFT_eSPI_Button *button = _widgets[_widget].button;
+  if (!button) return;
+  bool changed = button->isPressed() != pressed;
+  button->press(pressed);
+  if (changed) _dirty |= 1UL << _widget;
+}
+
+/***************************************************************************************
+** Function name:           fill
+** Description:             Describe the gesture of the current touch
+***************************************************************************************/
+void TFT_eSPI_Gesture::fill(gesture_t *gesture, uint8_t type, uint32_t time)
+{
+  gesture->type   = type;
+  gesture->widget = _widget;
+  gesture->x      = _x0;
+  gesture->y      = _y0;
+  gesture->dx     = _x - _x0;
+  gesture->dy     = _y - _y0;
+  gesture->time   = time;
+}
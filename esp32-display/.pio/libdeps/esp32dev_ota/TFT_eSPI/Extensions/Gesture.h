@@ -0,0 +1,110 @@
+/***************************************************************************************
+// The following class recognises touch gestures (tap, long press and swipes) from the
+// down/move/up events of the touch sampler, and dispatches them to the buttons and screen
+// areas registered with it. A grid over the screen gives the widget under a point
+// without checking every widget. Buttons are pressed and released as the touch moves,
+// and only the buttons whose state changed are flagged for redrawing.
+***************************************************************************************/
+
+// Maximum number of widgets (buttons and areas), 32 at most
+#ifndef GESTURE_MAX_WIDGETS
+  #define GESTURE_MAX_WIDGETS 16
+#endif
+
+// Hit test grid cells are 2^GESTURE_GRID_SHIFT pixels square
+#ifndef GESTURE_GRID_SHIFT
+  #define GESTURE_GRID_SHIFT 4
+#endif
+
+// A touch that moves further than this (in pixels) is no longer a tap or a long press
+#ifndef GESTURE_TAP_SLOP
+  #define GESTURE_TAP_SLOP 10
+#endif
+
+// Minimum hold time of a long press
+#ifndef GESTURE_LONG_PRESS_MS
+  #define GESTURE_LONG_PRESS_MS 600
+#endif
+
+// A swipe travels at least GESTURE_SWIPE_MIN pixels, mostly along one axis,
+// within GESTURE_SWIPE_MAX_MS
+#ifndef GESTURE_SWIPE_MIN
+  #define GESTURE_SWIPE_MIN 40
+#endif
+#ifndef GESTURE_SWIPE_MAX_MS
+  #define GESTURE_SWIPE_MAX_MS 800
+#endif
+
+#define GESTURE_NONE        0
+#define GESTURE_TAP         1
+#define GESTURE_LONG_PRESS  2
+#define GESTURE_SWIPE_LEFT  3
+#define GESTURE_SWIPE_RIGHT 4
+#define GESTURE_SWIPE_UP    5
+#define GESTURE_SWIPE_DOWN  6
+
+typedef struct {
+  uint8_t  type;     // GESTURE_TAP ... GESTURE_SWIPE_DOWN
+  int8_t   widget;   // Widget under the touch down point, -1 if none
+  int16_t  x, y;     // Touch down point
+  int16_t  dx, dy;   // Distance travelled
+  uint32_t time;     // Time stamp of the event that completed the gesture
+} gesture_t;
+
+class TFT_eSPI_Gesture
+{
+ public:
+  TFT_eSPI_Gesture(void);
+  ~TFT_eSPI_Gesture(void);
+
+           // Allocate the hit test grid for a screen of the given size
+  bool     begin(uint16_t width, uint16_t height);
+
+           // Register a widget, returns its index or -1 if there is no room
+           // Widgets registered later are on top of the earlier ones
+  int8_t   addButton(TFT_eSPI_Button *button);
+  int8_t   addArea(int16_t x, int16_t y, uint16_t w, uint16_t h);
+  void     clearWidgets(void);
+
+           // Index of the top widget containing the point, -1 if none
+  int8_t   hitTest(int16_t x, int16_t y);
+
+           // Process a touch event (in screen coordinates, see getTouchEvent()),
+           // returns true and fills in gesture if a gesture is complete
+  bool     handleEvent(const touch_event_t *event, gesture_t *gesture);
+           // Call while the screen is touched to detect long presses
+  bool     poll(uint32_t time, gesture_t *gesture);
+
+           // Index of a button whose pressed state changed, -1 if none, clears its flag
+  int8_t   nextDirty(void);
+           // Redraw the buttons whose pressed state changed, pressed buttons are inverted
+  void     drawDirtyButtons(void);
+
+ private:
+  void     rebuildGrid(void);
+  void     setPressed(bool pressed);
+  void     fill(gesture_t *gesture, uint8_t type, uint32_t time);
+
+  typedef struct {
+    int16_t  x, y;
+    uint16_t w, h;
+    TFT_eSPI_Button *button;  // nullptr for an area
+  } widget_t;
+
+  widget_t _widgets[GESTURE_MAX_WIDGETS];
+  uint8_t  _count;
+
+           // Per cell: 1 + index of the top widget overlapping it, 0 if none,
+           // GESTURE_SHARED_CELL set if more than one widget overlaps it
+  uint8_t *_grid;
+  uint16_t _cols, _rows;
+
+  uint32_t _dirty;            // Bit per widget whose button must be redrawn
+
+  bool     _down;             // A touch is in progress
+  bool     _moved;            // It went further than GESTURE_TAP_SLOP
+  bool     _held;             // A long press has been reported
+  int8_t   _widget;           // Widget under the touch down point
+  int16_t  _x0, _y0, _x, _y;  // Touch down and latest points
+  uint32_t _t0;               // Touch down time
+};
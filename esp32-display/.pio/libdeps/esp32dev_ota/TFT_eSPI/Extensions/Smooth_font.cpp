@@ -29,6 +29,71 @@ void TFT_eSPI::loadFont(String fontName, fs::FS &ffs)
 }
 #endif
 
+#ifdef FONT_PARTITION_AVAILABLE
+/***************************************************************************************
+** Function name:           loadFontPartition
+** Description:             maps a vlw font packed in a flash data partition and loads it
+**                          like a font array, glyphs are then read straight from flash
+*************************************************************************************x*/
+bool TFT_eSPI::loadFontPartition(const char* fontName, const char* partitionLabel)
+{
+  // Partition layout written by Tools/Pack_Smooth_Fonts/pack_fonts.py (little endian):
+  // "VLWP", uint16_t version, uint16_t font count, then one entry per font
+  struct { char magic[4]; uint16_t version; uint16_t count; } header;
+  struct { char name[24]; uint32_t offset; uint32_t size; } entry;
+
+  if (strlen(fontName) >= sizeof(entry.name)) return false;
+
+  const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partitionLabel);
+  if (!partition) {
+    Serial.println("Font partition " + String(partitionLabel) + " not found!");
+    return false;
+  }
+
+  if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK ||
+      memcmp(header.magic, "VLWP", 4) != 0 || header.version != 1) {
+    Serial.println("Partition " + String(partitionLabel) + " does not hold packed fonts!");
+    return false;
+  }
+
+  bool found = false;
+  for (uint16_t i = 0; i < header.count && !found; i++) {
+    if (esp_partition_read(partition, sizeof(header) + i * sizeof(entry), &entry, sizeof(entry)) != ESP_OK) return false;
+    found = strncmp(entry.name, fontName, sizeof(entry.name)) == 0;
+  }
+
+  // The 24 byte vlw header must be present and the font must lie inside the partition
+  if (!found || entry.size < 24 || entry.offset > partition->size || entry.size > partition->size - entry.offset) {
+    Serial.println("Font " + String(fontName) + " not found in partition " + String(partitionLabel) + "!");
+    return false;
+  }
+
+  if (fontLoaded) unloadFont();
+
+  // Flash is mapped in 64K pages into the data address space, no RAM is used
+  const void* fontData;
+  #if ESP_IDF_VERSION_MAJOR >= 5
+  if (esp_partition_mmap(partition, entry.offset, entry.size, ESP_PARTITION_MMAP_DATA, &fontData, &fontMapHandle) != ESP_OK) return false;
+  #else
+  if (esp_partition_mmap(partition, entry.offset, entry.size, SPI_FLASH_MMAP_DATA, &fontData, &fontMapHandle) != ESP_OK) return false;
+  #endif
+
+  loadFont((const uint8_t*)fontData);
+  if (!fontLoaded) {
+    // Nothing uses the mapping, so release it now rather than leave it to an unloadFont()
+  #if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_munmap(fontMapHandle);
+  #else
+    spi_flash_munmap(fontMapHandle);
+  #endif
+    return false;
+  }
+  fontMapped = true; // Set after loadFont() so the mapping is released by the next unloadFont()
+
+  return true;
+}
+#endif
+
 /***************************************************************************************
 ** Function name:           loadFont
 ** Description:             loads parameters from a font vlw file
@@ -188,6 +253,7 @@ void TFT_eSPI::loadMetrics(void)
 #endif
 
   uint16_t gNum = 0;
+  uint32_t maxBitmapSize = 0;
 
   while (gNum < gFont.gCount)
   {
@@ -238,6 +304,8 @@ void TFT_eSPI::loadMetrics(void)
 
     bitmapPtr += gWidth[gNum] * gHeight[gNum];
 
+    if (gWidth[gNum] * gHeight[gNum] > maxBitmapSize) maxBitmapSize = gWidth[gNum] * gHeight[gNum];
+
     gNum++;
     yield();
   }
@@ -245,6 +313,23 @@ void TFT_eSPI::loadMetrics(void)
   gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
 
   gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
+
+#ifdef FONT_FS_AVAILABLE
+  // Glyph bitmaps are read from the file in one go, into buffers sized to the largest glyph
+  if (fs_font)
+  {
+    glyphBufferSize = maxBitmapSize;
+  #if SMOOTH_FONT_CACHE_GLYPHS > 0
+    glyphCache = (uint8_t*)malloc(SMOOTH_FONT_CACHE_GLYPHS * glyphBufferSize);
+    for (uint8_t i = 0; i < SMOOTH_FONT_CACHE_GLYPHS; i++) glyphCacheUse[i] = 0;
+    glyphCacheTick = 0;
+    if (!glyphCache) // Fall back to a single buffer
+  #endif
+    glyphBuffer = (uint8_t*)malloc(glyphBufferSize);
+  }
+#else
+  (void)maxBitmapSize;
+#endif
 }
 
 
@@ -300,6 +385,32 @@ void TFT_eSPI::unloadFont( void )
 
 #ifdef FONT_FS_AVAILABLE
   if (fs_font && fontFile) fontFile.close();
+
+  if (glyphBuffer)
+  {
+    free(glyphBuffer);
+    glyphBuffer = nullptr;
+  }
+
+  #if SMOOTH_FONT_CACHE_GLYPHS > 0
+  if (glyphCache)
+  {
+    free(glyphCache);
+    glyphCache = nullptr;
+  }
+  #endif
+#endif
+
+#ifdef FONT_PARTITION_AVAILABLE
+  if (fontMapped)
+  {
+  #if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_munmap(fontMapHandle);
+  #else
+    spi_flash_munmap(fontMapHandle);
+  #endif
+    fontMapped = false;
+  }
 #endif
 
   fontLoaded = false;
@@ -352,6 +463,75 @@ bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 }
 
 
+/***************************************************************************************
+** Function name:           getGlyphBitmap
+** Description:             Get a pointer to the greyscale bitmap of a glyph
+*************************************************************************************x*/
+// For a font file the bitmap is read with a single seek and read, into a buffer that
+// belongs to the font, so the pointer is valid until the next call.
+// Returns nullptr if the buffer could not be allocated or the file could not be read.
+const uint8_t* TFT_eSPI::getGlyphBitmap(uint16_t gNum)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font)
+  {
+  #if SMOOTH_FONT_CACHE_GLYPHS > 0
+    if (glyphCache)
+    {
+      // Look for the glyph, else replace the least recently used (or empty) slot
+      uint8_t slot = 0;
+      for (uint8_t i = 0; i < SMOOTH_FONT_CACHE_GLYPHS; i++)
+      {
+        if (glyphCacheUse[i] && glyphCacheNum[i] == gNum)
+        {
+          glyphCacheUse[i] = ++glyphCacheTick;
+          return glyphCache + i * glyphBufferSize;
+        }
+        if (glyphCacheUse[i] < glyphCacheUse[slot]) slot = i;
+      }
+
+      uint8_t* bitmap = glyphCache + slot * glyphBufferSize;
+      // Do not keep a partial read
+      if (!readGlyphBitmap(gNum, bitmap)) {
+        glyphCacheUse[slot] = 0;
+        return nullptr;
+      }
+      glyphCacheUse[slot] = ++glyphCacheTick;
+      glyphCacheNum[slot] = gNum;
+      return bitmap;
+    }
+  #endif
+
+    if (!glyphBuffer || !readGlyphBitmap(gNum, glyphBuffer)) return nullptr;
+    return glyphBuffer;
+  }
+#endif
+
+  return gFont.gArray + gBitmap[gNum];
+}
+
+
+#ifdef FONT_FS_AVAILABLE
+/***************************************************************************************
+** Function name:           readGlyphBitmap
+** Description:             Read the greyscale bitmap of a glyph from the font file
+*************************************************************************************x*/
+// An SD card shares the SPI bus with the TFT, so a transaction the caller opened
+// with startWrite() is ended for the read and restarted afterwards
+bool TFT_eSPI::readGlyphBitmap(uint16_t gNum, uint8_t* buffer)
+{
+  uint32_t size = gWidth[gNum] * gHeight[gNum];
+  bool release = !spiffs && inTransaction;
+
+  if (release) endWrite();   // Release SPI for SD card transaction
+  bool ok = fontFile.seek(gBitmap[gNum], fs::SeekSet) && fontFile.read(buffer, size) == size;
+  if (release) startWrite(); // Re-start SPI for TFT transaction
+
+  return ok;
+}
+#endif
+
+
 /***************************************************************************************
 ** Function name:           drawGlyph
 ** Description:             Write a character to the TFT cursor position
@@ -391,8 +571,11 @@ void TFT_eSPI::drawGlyph(uint16_t code)
 
   uint16_t gNum = 0;
   bool found = getUnicodeIndex(code, &gNum);
-  
-  if (found)
+
+  // For a font file, this reads the whole bitmap before the TFT transaction
+  const uint8_t* gPtr = found ? getGlyphBitmap(gNum) : nullptr;
+
+  if (gPtr)
   {
 
     if (textwrapX && (cursor_x + gWidth[gNum] + gdX[gNum] > width()))
@@ -404,38 +587,73 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     if (textwrapY && ((cursor_y + gFont.yAdvance) >= height())) cursor_y = 0;
     if (cursor_x == 0) cursor_x -= gdX[gNum];
 
-    uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
-
-#ifdef FONT_FS_AVAILABLE
-    if (fs_font)
-    {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet);
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
-    }
-#endif
-
     int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
     int16_t cx = cursor_x + gdX[gNum];
 
     //  if (cx > width() && bg_cursor_x > width()) return;
     //  if (cursor_y > height()) return;
 
-    int16_t  fxs = cx;
-    uint32_t fl = 0;
-    int16_t  bxs = cx;
-    uint32_t bl = 0;
     int16_t  bx = 0;
-    uint8_t pixel;
+    uint8_t  pixel;
+
+    // Glyph rows are composed in a line buffer and pushed with one window per
+    // run of pixels, rather than one window per anti-aliased pixel. Colours are
+    // stored byte swapped for pushRect()/pushPixels().
+    uint16_t fgs = fg >> 8 | fg << 8;
+    uint16_t bgs = bg >> 8 | bg << 8;
 
     startWrite(); // Avoid slow ESP32 transaction overhead for every pixel
 
+    int16_t cellx = cursor_x + gxAdvance[gNum]; // Right edge of character cell
     int16_t fillwidth  = 0;
     int16_t fillheight = 0;
 
-    // Fill area above glyph
     if (_fillbg) {
-      fillwidth  = (cursor_x + gxAdvance[gNum]) - bg_cursor_x;
+      fillwidth = cellx - bg_cursor_x;
+      // Could be negative
+      if (fillwidth < 0) fillwidth = 0;
+      // Set x position in glyph area where background starts
+      if (bg_cursor_x > cx) bx = bg_cursor_x - cx;
+    }
+
+    // If the background is filled and the glyph fits in its cell then the cell
+    // is pushed in a single window, one row at a time
+    bool cellWindow = fillwidth > 0 && bx == 0 && cx + gWidth[gNum] <= cellx &&
+                      cy >= cursor_y && cy + gHeight[gNum] <= cursor_y + gFont.yAdvance &&
+                      !_vpOoB && bg_cursor_x + _xDatum >= _vpX && cursor_y + _yDatum >= _vpY &&
+                      cellx + _xDatum <= _vpW && cursor_y + gFont.yAdvance + _yDatum <= _vpH;
+
+    if (cellWindow) {
+      uint16_t lineBuf[fillwidth];
+      uint16_t* glyphBuf = lineBuf + (cx - bg_cursor_x);
+      bool swap = _swapBytes; _swapBytes = false;
+      setWindow(bg_cursor_x + _xDatum, cursor_y + _yDatum, cellx + _xDatum - 1, cursor_y + gFont.yAdvance + _yDatum - 1);
+
+      for (int32_t py = cursor_y; py < cursor_y + gFont.yAdvance; py++)
+      {
+        for (int32_t i = 0; i < fillwidth; i++) lineBuf[i] = bgs;
+
+        int32_t y = py - cy;
+        if (y >= 0 && y < gHeight[gNum])
+        {
+          for (int32_t x = 0; x < gWidth[gNum]; x++)
+          {
+            pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
+
+            if (pixel == 0xFF) glyphBuf[x] = fgs;
+            else if (pixel) {
+              uint16_t c = alphaBlend(pixel, fg, getColor ? getColor(x + cx, y + cy) : bg);
+              glyphBuf[x] = c >> 8 | c << 8;
+            }
+          }
+        }
+        pushPixels(lineBuf, fillwidth);
+      }
+
+      _swapBytes = swap;
+    }
+    else {
+      // Fill area above glyph
       if (fillwidth > 0) {
         fillheight = gFont.maxAscent - gdY[gNum];
         // Could be negative
@@ -443,91 +661,58 @@ void TFT_eSPI::drawGlyph(uint16_t code)
           fillRect(bg_cursor_x, cursor_y, fillwidth, fillheight, textbgcolor);
         }
       }
-      else {
-        // Could be negative
-        fillwidth = 0;
-      }
 
-      // Fill any area to left of glyph                              
-      if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gHeight[gNum], textbgcolor);
-      // Set x position in glyph area where background starts
-      if (bg_cursor_x > cx) bx = bg_cursor_x - cx;
-      // Fill any area to right of glyph
-      if (cx + gWidth[gNum] < cursor_x + gxAdvance[gNum]) {
-        fillRect(cx + gWidth[gNum], cy, (cursor_x + gxAdvance[gNum]) - (cx + gWidth[gNum]), gHeight[gNum], textbgcolor);
-      }
-    }
-
-    for (int32_t y = 0; y < gHeight[gNum]; y++)
-    {
-#ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
-        if (spiffs)
-        {
-          fontFile.read(pbuffer, gWidth[gNum]);
-          //Serial.println("SPIFFS");
-        }
-        else
-        {
-          endWrite();    // Release SPI for SD card transaction
-          fontFile.read(pbuffer, gWidth[gNum]);
-          startWrite();  // Re-start SPI for TFT transaction
-          //Serial.println("Not SPIFFS");
+      if (_fillbg) {
+        // Fill any area to left of glyph
+        if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gHeight[gNum], textbgcolor);
+        // Fill any area to right of glyph
+        if (cx + gWidth[gNum] < cellx) {
+          fillRect(cx + gWidth[gNum], cy, cellx - (cx + gWidth[gNum]), gHeight[gNum], textbgcolor);
         }
       }
-#endif
 
-      for (int32_t x = 0; x < gWidth[gNum]; x++)
-      {
-#ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
-#endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+      uint16_t lineBuf[gWidth[gNum]];
 
-        if (pixel)
+      for (int32_t y = 0; y < gHeight[gNum]; y++)
+      {
+        // Transparent pixels split the row into runs
+        int32_t xs = -1;
+        for (int32_t x = 0; x <= gWidth[gNum]; x++)
         {
-          if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
-          if (pixel != 0xFF)
+          bool opaque = false;
+          if (x < gWidth[gNum])
           {
-            if (fl) {
-              if (fl==1) drawPixel(fxs, y + cy, fg);
-              else drawFastHLine( fxs, y + cy, fl, fg);
-              fl = 0;
+            pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
+
+            opaque = true;
+            if (pixel == 0xFF) lineBuf[x] = fgs;
+            else if (pixel) {
+              uint16_t c = alphaBlend(pixel, fg, getColor ? getColor(x + cx, y + cy) : bg);
+              lineBuf[x] = c >> 8 | c << 8;
             }
-            if (getColor) bg = getColor(x + cx, y + cy);
-            drawPixel(x + cx, y + cy, alphaBlend(pixel, fg, bg));
+            else if (_fillbg && x >= bx) lineBuf[x] = bgs;
+            else opaque = false;
           }
-          else
-          {
-            if (fl==0) fxs = x + cx;
-            fl++;
+
+          if (opaque) {
+            if (xs < 0) xs = x;
           }
-        }
-        else
-        {
-          if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
-          if (_fillbg) {
-            if (x >= bx) {
-              if (bl==0) bxs = x + cx;
-              bl++;
-            }
+          else if (xs >= 0) {
+            pushRect(cx + xs, cy + y, x - xs, 1, lineBuf + xs);
+            xs = -1;
           }
         }
       }
-      if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
-      if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
-    }
 
-    // Fill area below glyph
-    if (fillwidth > 0) {
-      fillheight = (cursor_y + gFont.yAdvance) - (cy + gHeight[gNum]);
-      if (fillheight > 0) {
-        fillRect(bg_cursor_x, cy + gHeight[gNum], fillwidth, fillheight, textbgcolor);
+      // Fill area below glyph
+      if (fillwidth > 0) {
+        fillheight = (cursor_y + gFont.yAdvance) - (cy + gHeight[gNum]);
+        if (fillheight > 0) {
+          fillRect(bg_cursor_x, cy + gHeight[gNum], fillwidth, fillheight, textbgcolor);
+        }
       }
     }
 
-    if (pbuffer) free(pbuffer);
     cursor_x += gxAdvance[gNum];
     endWrite();
   }
@@ -9,8 +9,12 @@
   void     loadFont(String fontName, fs::FS &ffs);
 #endif
   void     loadFont(String fontName, bool flash = true);
+#ifdef FONT_PARTITION_AVAILABLE
+  bool     loadFontPartition(const char* fontName, const char* partitionLabel = "fonts");
+#endif
   void     unloadFont( void );
   bool     getUnicodeIndex(uint16_t unicode, uint16_t *index);
+  const uint8_t* getGlyphBitmap(uint16_t gNum);
 
   virtual void drawGlyph(uint16_t code);
 
@@ -48,14 +52,35 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   bool     spiffs   = true;
   bool     fs_font = false;    // For ESP32/8266 use smooth font file or FLASH (PROGMEM) array
 
+  uint8_t* glyphBuffer = nullptr; // Bitmap of the last glyph read from the file
+  uint32_t glyphBufferSize = 0;   // Size of the largest glyph bitmap
+  #if SMOOTH_FONT_CACHE_GLYPHS > 0
+  uint8_t* glyphCache = nullptr;  // Recently used glyph bitmaps, glyphBufferSize bytes each
+  uint16_t glyphCacheNum[SMOOTH_FONT_CACHE_GLYPHS];
+  uint32_t glyphCacheUse[SMOOTH_FONT_CACHE_GLYPHS]; // 0 = empty slot
+  uint32_t glyphCacheTick = 0;
+  #endif
+
 #else
   bool     fontFile = true;
 #endif
 
+#ifdef FONT_PARTITION_AVAILABLE
+  bool     fontMapped = false;  // Font array is mapped from a partition by loadFontPartition()
+  #if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_mmap_handle_t fontMapHandle;
+  #else
+  spi_flash_mmap_handle_t     fontMapHandle;
+  #endif
+#endif
+
   private:
 
   void     loadMetrics(void);
   uint32_t readInt32(void);
+#ifdef FONT_FS_AVAILABLE
+  bool     readGlyphBitmap(uint16_t gNum, uint8_t* buffer);
+#endif
 
   uint8_t* fontPtr = nullptr;
 
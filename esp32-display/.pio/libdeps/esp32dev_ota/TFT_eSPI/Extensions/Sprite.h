@@ -126,6 +126,12 @@ class TFT_eSprite : public TFT_eSPI {
            // Push a windowed area of the sprite to the TFT at tx, ty
   bool     pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
 
+           // Push the sprite to the TFT at x, y using DMA (see TFT_eSPI::pushImageDMA() for 4 and 8 bpp).
+           // The sprite goes out a strip at a time through internal RAM bounce buffers, so it may be
+           // in PSRAM, and it can be drawn into again as soon as the function returns.
+           // 1 bpp sprites are pushed without DMA.
+  void     pushSpriteDMA(int32_t x, int32_t y);
+
            // Push the sprite to another sprite at x,y. This fn calls pushImage() in the destination sprite (dspr) class.
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y);
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, uint16_t transparent);
@@ -22,6 +22,18 @@
            // Set the screen calibration values
   void     setTouch(uint16_t *data);
 
+           // Non-blocking touch sampling, see Extensions/Touch_Sampler.h
+           // Once started serviceTouch() must be called often, e.g. every loop. It takes at most
+           // one raw sample every TOUCH_SAMPLE_INTERVAL ms and, if TOUCH_IRQ is defined, returns at
+           // once while the screen is not touched. getTouch() then returns the latest filtered
+           // position without waiting, its threshold parameter is replaced by the one given here.
+  void     beginTouchSampling(uint16_t threshold = 600);
+  void     endTouchSampling(void);
+           // Returns true if the touch state changed
+  bool     serviceTouch(void);
+           // Get the next touch down/move/up event in screen coordinates, false if none
+  bool     getTouchEvent(touch_event_t *event);
+
  private:
            // Legacy support only - deprecated TODO: delete
   void     spi_begin_touch();
@@ -40,3 +52,11 @@
 
   uint32_t _pressTime;        // Press and hold time-out
   uint16_t _pressX, _pressY;  // For future use (last sampled calibrated coordinates)
+
+  TFT_eSPI_TouchSampler touchSampler;
+  bool     _touchSampling = false;  // Set by beginTouchSampling()
+  uint32_t _touchSampleTime = 0;    // millis() time of the last sample
+#ifdef TOUCH_IRQ
+  static void touchIrqHandler(void);
+  static volatile bool _touchIrq;   // Set by the pen interrupt, cleared when sampled
+#endif
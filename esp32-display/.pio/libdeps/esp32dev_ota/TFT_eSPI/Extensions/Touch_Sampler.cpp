@@ -0,0 +1,159 @@
+ // This is part of the TFT_eSPI library and is associated with the Touch Screen handlers
+ // See license in root directory.
+
+/***************************************************************************************
+** Code for the touch sampler class
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eSPI_TouchSampler
+** Description:             Constructor
+***************************************************************************************/
+TFT_eSPI_TouchSampler::TFT_eSPI_TouchSampler(void)
+{
+  _threshold = 600;
+  _head = _tail = 0;
+  _overruns = 0;
+  reset();
+}
+
+/***************************************************************************************
+** Function name:           setThreshold
+** Description:             Set the pressure threshold of a touch
+***************************************************************************************/
+void TFT_eSPI_TouchSampler::setThreshold(uint16_t threshold)
+{
+  if (threshold < 20) threshold = 20;
+  _threshold = threshold;
+}
+
+/***************************************************************************************
+** Function name:           reset
+** Description:             Forget the current touch
+***************************************************************************************/
+void TFT_eSPI_TouchSampler::reset(void)
+{
+  _pressed  = false;
+  _count    = 0;
+  _released = 0;
+}
+
+/***************************************************************************************
+** Function name:           addSample
+** Description:             Filter a raw sample and queue the events it generates
+***************************************************************************************/
+bool TFT_eSPI_TouchSampler::addSample(uint16_t x, uint16_t y, uint16_t z, uint32_t time)
+{
+  // Hysteresis: a touch starts above the threshold and ends below half of it
+  if (z <= _threshold / 2 || (!_pressed && z <= _threshold)) {
+    if (!_pressed) { _count = 0; return false; }
+    if (++_released < TOUCH_RELEASE_SAMPLES) return false;
+    pushEvent(TOUCH_EVENT_UP, time);
+    reset();
+    return true;
+  }
+  _released = 0;
+
+  // The position is not reliable until the pressure has settled
+  if (_count < TOUCH_SETTLE_SAMPLES) { _count++; return false; }
+
+  // Median of the last 3 samples removes single sample spikes
+  uint8_t n = _count - TOUCH_SETTLE_SAMPLES;
+  if (n < 3) {
+    _rawX[n] = x;
+    _rawY[n] = y;
+    if (++_count < TOUCH_SETTLE_SAMPLES + 3) return false;
+  }
+  else {
+    _rawX[0] = _rawX[1]; _rawX[1] = _rawX[2]; _rawX[2] = x;
+    _rawY[0] = _rawY[1]; _rawY[1] = _rawY[2]; _rawY[2] = y;
+  }
+
+  uint32_t mx = (uint32_t)median(_rawX) << TOUCH_IIR_SHIFT;
+  uint32_t my = (uint32_t)median(_rawY) << TOUCH_IIR_SHIFT;
+
+  if (!_pressed) {
+    _filterX = mx;
+    _filterY = my;
+    _pressed = true;
+    pushEvent(TOUCH_EVENT_DOWN, time);
+    return true;
+  }
+
+  // Exponential average of the median, the filter state keeps TOUCH_IIR_SHIFT fraction bits
+  _filterX += ((int32_t)(mx - _filterX)) >> TOUCH_IIR_SHIFT;
+  _filterY += ((int32_t)(my - _filterY)) >> TOUCH_IIR_SHIFT;
+
+  uint16_t fx = _filterX >> TOUCH_IIR_SHIFT;
+  uint16_t fy = _filterY >> TOUCH_IIR_SHIFT;
+  if (abs(fx - _reportX) < TOUCH_MOVE_DEADBAND && abs(fy - _reportY) < TOUCH_MOVE_DEADBAND) return false;
+
+  pushEvent(TOUCH_EVENT_MOVE, time);
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           getPosition
+** Description:             Latest filtered raw position, false if not touched
+***************************************************************************************/
+bool TFT_eSPI_TouchSampler::getPosition(uint16_t *x, uint16_t *y)
+{
+  if (!_pressed) return false;
+  *x = _filterX >> TOUCH_IIR_SHIFT;
+  *y = _filterY >> TOUCH_IIR_SHIFT;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           getEvent
+** Description:             Pop the oldest touch event, false if none
+***************************************************************************************/
+bool TFT_eSPI_TouchSampler::getEvent(touch_event_t *event)
+{
+  uint16_t tail = _tail;
+  if (tail == _head) return false;
+  *event = _events[tail];
+  _tail = (tail + 1) & (TOUCH_EVENT_QUEUE - 1);
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           eventsAvailable
+** Description:             Number of queued touch events
+***************************************************************************************/
+uint16_t TFT_eSPI_TouchSampler::eventsAvailable(void)
+{
+  return (_head - _tail) & (TOUCH_EVENT_QUEUE - 1);
+}
+
+/***************************************************************************************
+** Function name:           pushEvent
+** Description:             Queue an event at the filtered position
+***************************************************************************************/
+void TFT_eSPI_TouchSampler::pushEvent(uint8_t type, uint32_t time)
+{
+  _reportX = _filterX >> TOUCH_IIR_SHIFT;
+  _reportY = _filterY >> TOUCH_IIR_SHIFT;
+
+  uint16_t head = _head;
+  uint16_t next = (head + 1) & (TOUCH_EVENT_QUEUE - 1);
+  if (next == _tail) { _overruns++; return; }
+
+  _events[head].type = type;
+  _events[head].x    = _reportX;
+  _events[head].y    = _reportY;
+  _events[head].time = time;
+  _head = next; // Publish the event once it is complete
+}
+
+/***************************************************************************************
+** Function name:           median
+** Description:             Median of 3 values
+***************************************************************************************/
+uint16_t TFT_eSPI_TouchSampler::median(const uint16_t *v)
+{
+  uint16_t a = v[0], b = v[1], c = v[2];
+  if (a > b) { uint16_t t = a; a = b; b = t; }
+  if (b > c) b = c;
+  return a > b ? a : b;
+}
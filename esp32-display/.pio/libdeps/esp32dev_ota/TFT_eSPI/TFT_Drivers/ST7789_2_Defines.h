@@ -66,6 +66,9 @@
 #define TFT_PASET   0x2B
 #define TFT_RAMWR   0x2C
 #define TFT_RAMRD   0x2E
+#define TFT_VSCRDEF 0x33
+#define TFT_VSCRSADD 0x37
+#define TFT_VSCR_LINES 320 // Frame memory lines, the scroll areas add up to this
 #define TFT_MADCTL  0x36
 #define TFT_COLMOD  0x3A
 
@@ -2173,6 +2173,114 @@ void TFT_eSPI::pushMaskedImage(int32_t x, int32_t y, int32_t w, int32_t h, uint1
 }
 
 
+// The DMA functions are in the processor specific files
+#if defined (ESP32_DMA) || defined (RP2040_DMA) || (defined (STM32_DMA) && !defined (TFT_PARALLEL_8_BIT))
+/***************************************************************************************
+** Function name:           pushImageDMA
+** Description:             plot 8-bit or 4-bit image using DMA, expanded a strip at a time
+***************************************************************************************/
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* data, bool bpp8, uint16_t* cmap)
+{
+  if (!bpp8 && cmap == nullptr) return; // 4 bpp needs a colour map
+
+  pushStripsDMA(x, y, w, h, data, bpp8 ? 8 : 4, cmap);
+}
+
+
+/***************************************************************************************
+** Function name:           pushStripsDMA
+** Description:             push a 4, 8 or 16 bpp image with DMA through bounce buffers
+***************************************************************************************/
+void TFT_eSPI::pushStripsDMA(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t* data, uint8_t bpp, uint16_t* cmap)
+{
+  if (!DMA_Enabled) return;
+
+  PI_CLIP;
+
+  if (_dmaBounce == nullptr) {
+    // A strip holds at least one line
+    uint32_t size = max((uint32_t)DMA_BOUNCE_PIXELS, (uint32_t)max(_init_width, _init_height));
+#if defined (ESP32)
+    _dmaBounce = (uint16_t*)heap_caps_malloc(2 * size * sizeof(uint16_t), MALLOC_CAP_DMA); // Not PSRAM
+#else
+    _dmaBounce = (uint16_t*)malloc(2 * size * sizeof(uint16_t));
+#endif
+    if (_dmaBounce == nullptr) return;
+    _dmaBounceSize = size;
+  }
+
+  // Colours in TFT byte order, so the strips are sent as they are
+  uint16_t lut[256];
+  if (bpp == 4) {
+    for (uint32_t i = 0; i < 16; i++) lut[i] = cmap[i] << 8 | cmap[i] >> 8;
+  }
+  else if (bpp == 8) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint16_t color = cmap ? cmap[i] : color8to16(i);
+      lut[i] = color << 8 | color >> 8;
+    }
+  }
+
+  // Source line length in bytes, 4 bpp lines start on a byte boundary
+  uint32_t stride = (bpp == 4) ? (w + 1) >> 1 : (bpp == 8) ? w : w << 1;
+  data += dy * stride;
+
+  int32_t lines = _dmaBounceSize / dw;
+  bool swap = _swapBytes;
+
+  begin_tft_write();
+  inTransaction = true;
+  _swapBytes = false;
+
+  while (dh > 0) {
+    int32_t sh = (dh < lines) ? dh : lines;
+    uint16_t* strip = _dmaBounce + _dmaBounceNext * _dmaBounceSize;
+    uint16_t* linePtr = strip;
+
+    // Expand while the previous strip is being sent from the other buffer
+    for (int32_t yp = 0; yp < sh; yp++) {
+      uint32_t len = dw;
+      if (bpp == 4) {
+        const uint8_t* ptr = data + (dx >> 1);
+        if (dx & 0x01) { *linePtr++ = lut[*ptr++ & 0x0F]; len--; }
+        while (len > 1) {
+          uint8_t colors = *ptr++;
+          *linePtr++ = lut[colors >> 4];
+          *linePtr++ = lut[colors & 0x0F];
+          len -= 2;
+        }
+        if (len) *linePtr++ = lut[*ptr >> 4];
+      }
+      else if (bpp == 8) {
+        const uint8_t* ptr = data + dx;
+        while (len--) *linePtr++ = lut[*ptr++];
+      }
+      else {
+        const uint16_t* ptr = (const uint16_t*)data + dx;
+        if (swap) { while (len--) { *linePtr++ = *ptr << 8 | *ptr >> 8; ptr++; } }
+        else { memcpy(linePtr, ptr, dw << 1); linePtr += dw; }
+      }
+      data += stride;
+    }
+
+    // Waits for the previous strip to be sent, then starts this one
+    pushImageDMA(x, y, dw, sh, strip);
+    _dmaBounceNext ^= 1;
+
+    y  += sh;
+    dh -= sh;
+  }
+
+  _swapBytes = swap;
+
+  // The last strip must be sent before CS goes high, unless the sketch holds the transaction
+  inTransaction = lockTransaction;
+  if (!inTransaction) dmaWait();
+  end_tft_write();
+}
+#endif // DMA
+
+
 /***************************************************************************************
 ** Function name:           setSwapBytes
 ** Description:             Used by 16-bit pushImage() to swap byte order in colours
@@ -4844,6 +4952,57 @@ void TFT_eSPI::invertDisplay(bool i)
 }
 
 
+#ifdef TFT_VSCRDEF
+/***************************************************************************************
+** Function name:           setScrollArea
+** Description:             Fix tfa lines at the top and bfa at the bottom, the rest scroll
+***************************************************************************************/
+void TFT_eSPI::setScrollArea(uint16_t tfa, uint16_t bfa)
+{
+  if (tfa > TFT_VSCR_LINES) tfa = TFT_VSCR_LINES;
+  if (bfa > TFT_VSCR_LINES - tfa) bfa = TFT_VSCR_LINES - tfa;
+  uint16_t vsa = TFT_VSCR_LINES - tfa - bfa;
+
+  _scrollTop   = tfa;
+  _scrollLines = vsa;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRDEF);
+  writedata(tfa >> 8); writedata(tfa);
+  writedata(vsa >> 8); writedata(vsa);
+  writedata(bfa >> 8); writedata(bfa);
+  end_tft_write();
+}
+
+/***************************************************************************************
+** Function name:           scrollTo
+** Description:             Show the scroll area moved up by offset lines
+***************************************************************************************/
+// Only the start line is sent, nothing is redrawn. Frame memory line _scrollTop + n
+// shows (n - offset) % _scrollLines lines down the area, so the bottom line of the area
+// is memory line _scrollTop + (offset + _scrollLines - 1) % _scrollLines.
+void TFT_eSPI::scrollTo(uint16_t offset)
+{
+  if (_scrollLines == 0) return;
+  uint16_t vsp = _scrollTop + offset % _scrollLines;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRSADD);
+  writedata(vsp >> 8); writedata(vsp);
+  end_tft_write();
+}
+
+/***************************************************************************************
+** Function name:           resetScrollArea
+** Description:             Stop scrolling, frame memory lines show where they are drawn
+***************************************************************************************/
+void TFT_eSPI::resetScrollArea(void)
+{
+  setScrollArea(0, 0);
+  scrollTo(0);
+}
+#endif
+
 /**************************************************************************
 ** Function name:           setAttribute
 ** Description:             Sets a control parameter of an attribute
@@ -6133,12 +6292,16 @@ void TFT_eSPI::getSetup(setup_t &tft_settings)
 
 
 ////////////////////////////////////////////////////////////////////////////////////////
+#include "Extensions/Touch_Sampler.cpp"
+
 #ifdef TOUCH_CS
   #include "Extensions/Touch.cpp"
 #endif
 
 #include "Extensions/Button.cpp"
 
+#include "Extensions/Gesture.cpp"
+
 #include "Extensions/Sprite.cpp"
 
 #ifdef SMOOTH_FONT
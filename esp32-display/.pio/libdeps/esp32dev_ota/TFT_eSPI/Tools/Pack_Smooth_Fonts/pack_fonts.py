@@ -0,0 +1,120 @@
+'''
+
+    This script packs Smooth Font .vlw files into one binary image that is
+    written to a flash data partition. TFT_eSPI::loadFontPartition() then
+    memory maps a font from the partition and uses it like a font array,
+    without a filing system and without copying the glyphs to RAM.
+
+    You'll need python 3.6
+
+    usage: python pack_fonts.py [-v] NotoSansBold15.vlw NotoSansBold36.vlw [-o fonts.bin] [-s 0x100000]
+           python pack_fonts.py --list fonts.bin
+
+    The font name used by loadFontPartition() is the file name without ".vlw".
+
+    Image layout (little endian):
+        "VLWP", uint16 version (1), uint16 font count
+        one 32 byte entry per font: name (24 bytes, zero padded), uint32 offset, uint32 size
+        the vlw files, each one starting on a 4 byte boundary
+
+'''
+
+import sys
+import struct
+import argparse
+import os
+
+MAGIC = b"VLWP"
+VERSION = 1
+HEADER = struct.Struct("<4sHH")
+ENTRY = struct.Struct("<24sII")
+ALIGN = 4
+
+debug = None
+
+def debugOut(s):
+    if debug:
+        print(s)
+
+def checkFont(name, data):
+    # 24 byte header, 28 bytes of metrics per glyph, then one byte per bitmap pixel
+    if len(data) < 24:
+        return "too short for a vlw header"
+    count = struct.unpack(">I", data[0:4])[0]
+    end = 24 + 28 * count
+    if len(data) < end:
+        return "the glyph metrics are truncated"
+    bitmaps = 0
+    for i in range(count):
+        height, width = struct.unpack(">II", data[24 + 28 * i + 4 : 24 + 28 * i + 12])
+        bitmaps += width * height
+    if len(data) < end + bitmaps:
+        return "the glyph bitmaps are truncated"
+    debugOut("{}: {} glyphs, {} bytes".format(name, count, len(data)))
+    return None
+
+def pack(files, size):
+    fonts = []
+    for path in files:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if len(name.encode()) >= ENTRY.size - 8:
+            sys.exit("Font name {} is longer than {} characters".format(name, ENTRY.size - 9))
+        if any(name == n for n, d in fonts):
+            sys.exit("Font {} is given twice".format(name))
+        with open(path, "rb") as f:
+            data = f.read()
+        error = checkFont(name, data)
+        if error:
+            sys.exit("{} is not a vlw font: {}".format(path, error))
+        fonts.append((name, data))
+
+    image = bytearray(HEADER.pack(MAGIC, VERSION, len(fonts)))
+    offset = HEADER.size + ENTRY.size * len(fonts)
+    for name, data in fonts:
+        offset += -offset % ALIGN
+        image += ENTRY.pack(name.encode(), offset, len(data))
+        offset += len(data)
+    for name, data in fonts:
+        image += bytes(-len(image) % ALIGN)
+        image += data
+
+    if size:
+        if len(image) > size:
+            sys.exit("The fonts need {} bytes, the partition only has {}".format(len(image), size))
+        image += b"\xff" * (size - len(image))  # erased flash
+    return image
+
+def listImage(path):
+    with open(path, "rb") as f:
+        image = f.read()
+    magic, version, count = HEADER.unpack_from(image, 0)
+    if magic != MAGIC or version != VERSION:
+        sys.exit("{} is not a packed font image".format(path))
+    for i in range(count):
+        name, offset, length = ENTRY.unpack_from(image, HEADER.size + ENTRY.size * i)
+        name = name.rstrip(b"\0").decode()
+        error = checkFont(name, image[offset : offset + length])
+        print("{:<24} offset 0x{:06x} size {:7}{}".format(name, offset, length, "  " + error if error else ""))
+
+parser = argparse.ArgumentParser(description="Pack vlw fonts into a flash partition image")
+parser.add_argument("-v", "--verbose", help="debug output", action="store_true")
+parser.add_argument("fonts", nargs="*", help="vlw font files")
+parser.add_argument("-o", "--output", help="output file name", default="fonts.bin")
+parser.add_argument("-s", "--size", help="partition size, pads the image with 0xFF", type=lambda x: int(x, 0))
+parser.add_argument("-l", "--list", help="list the fonts of a packed image")
+args = parser.parse_args()
+
+debug = args.verbose
+
+if args.list:
+    listImage(args.list)
+    sys.exit(0)
+
+if not args.fonts:
+    parser.print_help()
+    sys.exit(1)
+
+image = pack(args.fonts, args.size)
+with open(args.output, "wb") as f:
+    f.write(image)
+print("Wrote {} fonts, {} bytes to {}".format(len(args.fonts), len(image), args.output))
@@ -228,6 +228,7 @@
 //#define TFT_BL   22  // LED back-light
 
 //#define TOUCH_CS 21     // Chip select pin (T_CS) of touch screen
+//#define TOUCH_IRQ 36    // Pen interrupt pin (T_IRQ) of touch screen, optional, arms beginTouchSampling()
 
 //#define TFT_WR 22    // Write strobe for modified Raspberry Pi TFT only
 
@@ -0,0 +1,74 @@
+/*
+  Sketch to time sprite scrolling at each colour depth.
+
+  A 320 x 32 pixel sprite, the size of a ticker across a 320
+  pixel wide screen, is scrolled left by 1, 2 and 8 pixels and
+  up by 1 line. The average time of a scroll() call is printed
+  to the serial port for 1, 4, 8 and 16 bits per pixel.
+
+  1 and 4 bpp sprites move the pixels a byte at a time when the
+  shift is a whole number of bytes (8 pixels at 1 bpp, 2 pixels
+  at 4 bpp) and with a shift-and-carry loop otherwise.
+
+  Example for library:
+  https://github.com/Bodmer/TFT_eSPI
+
+  A 1-bit 320 x 32 Sprite occupies 1280 bytes in RAM,
+  a 4-bit one 5120 bytes, an 8-bit one 10240 bytes and
+  a 16-bit one 20480 bytes.
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI tft = TFT_eSPI();
+
+TFT_eSprite ticker = TFT_eSprite(&tft);
+
+#define TICKER_WIDTH  320
+#define TICKER_HEIGHT 32
+#define SCROLLS       200
+
+// Average time of a scroll in microseconds
+float timeScroll(int16_t dx, int16_t dy)
+{
+  uint32_t start = micros();
+  for (int i = 0; i < SCROLLS; i++) ticker.scroll(dx, dy);
+  return (micros() - start) / (float)SCROLLS;
+}
+
+void benchmark(uint8_t bpp)
+{
+  ticker.setColorDepth(bpp);
+  if (!ticker.createSprite(TICKER_WIDTH, TICKER_HEIGHT)) {
+    Serial.printf("%2d bpp: not enough RAM\n", bpp);
+    return;
+  }
+
+  // Some text, so that the pixels moved are not all the same
+  ticker.fillSprite(TFT_BLACK);
+  ticker.setTextColor(TFT_WHITE);
+  ticker.drawString("BTC 64,213.50  ETH 3,120.75  SOL 148.20", 0, 8, 2);
+
+  Serial.printf("%2d bpp: left 1: %7.1f us, left 2: %7.1f us, left 8: %7.1f us, up 1: %7.1f us\n",
+                bpp, timeScroll(-1, 0), timeScroll(-2, 0), timeScroll(-8, 0), timeScroll(0, -1));
+
+  ticker.deleteSprite();
+}
+
+//==========================================================================================
+void setup() {
+  Serial.begin(115200);
+  tft.init();
+  tft.fillScreen(TFT_BLACK);
+
+  Serial.printf("\nscroll() of a %d x %d sprite, average of %d calls\n", TICKER_WIDTH, TICKER_HEIGHT, SCROLLS);
+  benchmark(1);
+  benchmark(4);
+  benchmark(8);
+  benchmark(16);
+}
+
+//==========================================================================================
+void loop() {
+  delay(1000);
+}
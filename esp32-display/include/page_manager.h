@@ -0,0 +1,82 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "page_transition.h"
+
+// Draws a page. The canvas is an off-screen strip whose viewport maps page
+// coordinates onto it, so a page draws at page coordinates and must not rely on
+// fillScreen() or height(); the background is filled by the page manager.
+// The renderer runs once per strip, and drawing outside the strip is clipped, so
+// a renderer should skip what gfx.checkViewport() says is not in the strip.
+typedef void (*PageRenderer)(TFT_eSPI& gfx);
+
+// Full screen pages drawn off-screen, in strips, and switched with animated
+// transitions. Strips are rendered into two sprites in turn, so one is drawn
+// while the other is sent through DMA.
+class PageManager {
+public:
+    static const uint8_t maxPages = 4;
+
+    explicit PageManager(TFT_eSPI& tft) : tft_(tft), stripA_(&tft), stripB_(&tft) {}
+    ~PageManager() { delete cache_; }
+
+    // Allocates the strip sprites. If cachePages is set and there is PSRAM, the next
+    // page is also pre-rendered into a full screen sprite while nothing else happens.
+    bool begin(uint16_t stripHeight = 32, bool cachePages = true);
+
+    // Returns the page index
+    uint8_t addPage(PageRenderer render, uint16_t background);
+
+    uint8_t current() const { return current_; }
+    uint8_t count() const { return count_; }
+    bool busy() const { return transition_.active(); }
+
+    // Draws a page at once
+    void show(uint8_t page);
+    // Draws the current page again, e.g. after its data changed
+    void redraw() { show(current_); }
+    // Starts a transition to a page, drawn by update()
+    void go(uint8_t page, PageEffect effect);
+    void next() { go((current_ + 1) % count_, PageEffect::SlideLeft); }
+    void previous() { go((current_ + count_ - 1) % count_, PageEffect::SlideRight); }
+
+    // Call every loop: draws the next transition frame when it's due, otherwise
+    // pre-renders one strip of the next page. Returns true during a transition.
+    bool update(uint32_t now);
+
+    // The data shown by the pages changed, the pre-rendered page is out of date
+    void invalidate() { cachedLines_ = 0; }
+
+    // Transition timing. A switch ends durationMs after it starts plus the time to
+    // draw the last frame; a full screen frame is about 22 ms at 55 MHz SPI.
+    uint16_t durationMs = 100;
+    uint16_t frameMs = 25;
+
+    // Frames drawn by the last transition
+    uint16_t frames() const { return transition_.frames(); }
+
+private:
+    void render(TFT_eSprite& canvas, uint8_t page, int16_t dx, int16_t y, int16_t h);
+    void drawFrame(uint16_t pos);
+    void pushStrip(TFT_eSprite& strip, int16_t y, int16_t h);
+    void pushColumns(TFT_eSprite& sprite, int16_t x, int16_t y, int16_t w, int16_t h, int16_t sy);
+    bool cached(uint8_t page) const { return cache_ && cachedPage_ == page && cachedLines_ >= height_; }
+
+    TFT_eSPI& tft_;
+    TFT_eSprite stripA_, stripB_;
+    TFT_eSprite* cache_ = nullptr;
+    bool dma_ = false;
+    int16_t width_ = 0, height_ = 0, stripHeight_ = 0;
+
+    PageRenderer pages_[maxPages];
+    uint16_t backgrounds_[maxPages];
+    uint8_t count_ = 0;
+    uint8_t current_ = 0;
+    uint8_t target_ = 0;
+
+    PageTransition transition_;
+    uint16_t pos_ = 0;          // Boundary position of the last frame drawn
+
+    uint8_t cachedPage_ = 0;    // Page pre-rendered in cache_
+    int16_t cachedLines_ = 0;   // Lines of it rendered so far
+};
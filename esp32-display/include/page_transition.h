@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+// Page transitions
+enum class PageEffect : uint8_t {
+    Cut,         // New page drawn at once
+    SlideLeft,   // New page comes in from the right
+    SlideRight,  // New page comes in from the left
+    WipeLeft,    // New page uncovered from the right edge
+    WipeRight,   // New page uncovered from the left edge
+};
+
+// Frame scheduler of a page transition, kept free of display code so it can be tested
+// on the host. Frames are due every frameMs from the start; a frame that runs late
+// skips the slots it missed instead of making the transition longer. The last frame
+// is due at start + durationMs and always shows the whole new page.
+class PageTransition {
+public:
+    void begin(PageEffect effect, uint32_t now, uint16_t durationMs, uint16_t frameMs) {
+        effect_ = effect;
+        start_ = now;
+        duration_ = effect == PageEffect::Cut ? 0 : durationMs;
+        frameMs_ = frameMs ? frameMs : 1;
+        next_ = duration_ < frameMs_ ? duration_ : frameMs_;
+        frames_ = 0;
+        active_ = true;
+    }
+
+    bool active() const { return active_; }
+    PageEffect effect() const { return effect_; }
+    uint16_t frames() const { return frames_; }
+
+    // True if a frame must be drawn now
+    bool due(uint32_t now) const {
+        return active_ && now - start_ >= next_;
+    }
+
+    // Position of the boundary between the pages for the frame drawn now,
+    // from 0 (old page only) to width (new page only), eased out.
+    // Marks the frame as drawn and ends the transition with the last frame.
+    uint16_t frame(uint32_t now, uint16_t width) {
+        uint32_t t = now - start_;
+        frames_++;
+        if (t >= duration_) {
+            active_ = false;
+            return width;
+        }
+        // Next slot after now, clamped to the end
+        next_ = (t / frameMs_ + 1) * frameMs_;
+        if (next_ > duration_) next_ = duration_;
+
+        // Ease out: p * (2 - p) with p = t / duration, in 12-bit fixed point
+        uint32_t p = (t << 12) / duration_;
+        uint32_t eased = (p * ((2UL << 12) - p)) >> 12;
+        return (uint16_t)((eased * width) >> 12);
+    }
+
+private:
+    PageEffect effect_ = PageEffect::Cut;
+    uint32_t start_ = 0;
+    uint32_t duration_ = 0;
+    uint32_t frameMs_ = 1;
+    uint32_t next_ = 0;
+    uint16_t frames_ = 0;
+    bool active_ = false;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+
+// Lines of text rolling up through a band of the screen. The band is the display's
+// hardware scroll area, so a step sends the scroll start line and the one line of
+// pixels that comes into view, instead of the whole band.
+//
+// The band spans the full screen width and scrolls all of it; only columns x to
+// x + w are drawn, the rest must look the same on every line of the band (plain
+// background or the sides of a panel). Needs rotation 0.
+class Ticker {
+public:
+    static const uint8_t maxItems = 6;
+
+    explicit Ticker(TFT_eSPI& tft) : tft_(tft), line_(&tft) {}
+
+    // Band of lines y to y + h, text in columns x to x + w (w a multiple of 8).
+    // Items are pitch lines apart.
+    bool begin(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t fg, uint16_t bg,
+               uint8_t font = 2, int16_t pitch = 20);
+
+    // Items roll past in order; a change shows the next time the item comes round
+    void setItem(uint8_t i, const String& text);
+    uint8_t count() const { return count_; }
+
+    // Takes over the band: sets the scroll area and draws what it shows. The band must
+    // not be drawn by anything else until stop().
+    void start();
+    // Puts the screen back to unscrolled, for drawing full screen pages
+    void stop();
+    bool running() const { return running_; }
+
+    // Call every loop: scrolls one line when a step is due. Returns true if it did.
+    bool update(uint32_t now);
+
+    uint16_t stepMs = 40;      // 25 lines a second
+
+private:
+    void drawLine(uint32_t row);
+
+    TFT_eSPI& tft_;
+    TFT_eSprite line_;         // The item being shown, pitch lines of 1 bpp
+    String items_[maxItems];
+    uint8_t count_ = 0;
+    int16_t x_ = 0, y_ = 0, w_ = 0, h_ = 0, pitch_ = 0;
+    uint16_t fg_ = TFT_WHITE, bg_ = TFT_BLACK;
+    uint8_t font_ = 2;
+
+    bool running_ = false;
+    uint32_t top_ = 0;         // Row of the text at the top of the band, counted from the first item
+    int32_t drawn_ = -1;       // Item number rendered into line_
+    uint32_t due_ = 0;
+};
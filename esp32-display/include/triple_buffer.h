@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+// Hands snapshots from one writer task to one reader task without locks, kept free of
+// Arduino code so it can be tested on the host. There are three buffers: the writer
+// owns one, the reader owns one, and the third holds the latest snapshot published.
+// Publishing and taking a snapshot are single atomic swaps with that third buffer,
+// so neither side ever waits and the reader never sees a snapshot half written.
+//
+// The buffer the writer gets back is an old snapshot, so it must write all of it.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer: the buffer to fill, then publish() it
+    T& write() { return buffers_[back_]; }
+    void publish() {
+        back_ = latest_.exchange(back_ | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader: takes the latest snapshot if one was published since the last call.
+    // read() stays the same until the next update(), however often the writer publishes.
+    bool update() {
+        if (!(latest_.load(std::memory_order_acquire) & freshBit)) return false;
+        front_ = latest_.exchange(front_, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+    const T& read() const { return buffers_[front_]; }
+
+private:
+    static const uint8_t indexMask = 3;
+    static const uint8_t freshBit = 4;  // Set on the latest buffer until the reader takes it
+
+    T buffers_[3];
+    uint8_t back_ = 0;                  // Writer's buffer
+    uint8_t front_ = 1;                 // Reader's buffer
+    std::atomic<uint8_t> latest_{2};
+};
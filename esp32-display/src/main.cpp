@@ -1,7 +1,11 @@
 /**
  * PLUTO LAUNCHER ESP32 - ESP32-2432S028 (CYD)
  * 2.8" ST7789V TFT Display
- * Vertical 3-section layout: TIME | BLOCK HEIGHT | BOT STATUS
+ * Dashboard page, vertical 3-section layout: TIME | BLOCK HEIGHT | BOT STATUS
+ * Portfolio page: BTC PRICE | PROFIT
+ * Ticker rolling through the bot status and prices on the dashboard
+ * Swipe left/right to switch pages
+ * Network and JSON run on core 0, drawing on core 1
  */
 
 #include <Arduino.h>
@@ -10,9 +14,18 @@
 #include <ArduinoJson.h>
 #include <ArduinoOTA.h>
 #include <TFT_eSPI.h>
+#include <SPI.h>
 #include <time.h>
+#include "page_manager.h"
+#include "ticker.h"
+#include "triple_buffer.h"
 
 TFT_eSPI tft = TFT_eSPI();
+PageManager pages(tft);
+Ticker ticker(tft);
+
+// Pages, in swipe order
+enum Page : uint8_t { DASHBOARD_PAGE, PORTFOLIO_PAGE };
 
 // Configuration
 #include "config.h"
@@ -26,27 +39,50 @@ TFT_eSPI tft = TFT_eSPI();
 #define RED         tft.color565(239, 68, 68)
 #define GOLD        tft.color565(255, 193, 7)
 
-// Data
+// Data, copied whole between the tasks, so no Strings
 struct DisplayData {
     int blockHeight = 890518;
     float blockChange = 5.3;
-    String botStatus = "Waiting for signal...";
+    char botStatus[32] = "Waiting for signal...";
     bool botReady = true;
     unsigned long lastUpdate = 0;
-} data;
+    float btcPrice = 0;
+    float btcChange = 0;
+    float profitUsd = 0;
+    float profitToday = 0;
+    char mode[16] = "standby";
+    float sparkline[20];
+    size_t sparklineSize = 0;
+    
+    // Bumped when a group of values changes, so the renderer knows what to repaint
+    uint32_t blockSeq = 0;
+    uint32_t telemetrySeq = 0;
+};
+
+// The ingest task updates latest and publishes copies of it; the render task
+// draws shown, the snapshot it took last, which nothing else writes
+DisplayData latest;
+TripleBuffer<DisplayData> model;
+const DisplayData* shown = nullptr;
+
+void publishData() {
+    model.write() = latest;
+    model.publish();
+}
 
 // Time
 time_t now;
 struct tm timeinfo;
 
-void drawTimePanel() {
+// Panels draw on the screen, or on the strip a page is rendered into
+void drawTimePanel(TFT_eSPI& gfx = tft) {
     // Panel background (top section)
-    tft.fillRoundRect(8, 8, 224, 90, 10, PANEL);
+    gfx.fillRoundRect(8, 8, 224, 90, 10, PANEL);
     
     // Label "Local Time"
-    tft.setTextColor(GRAY, PANEL);
-    tft.setTextDatum(TL_DATUM);
-    tft.drawString("Local Time", 20, 20, 2);
+    gfx.setTextColor(GRAY, PANEL);
+    gfx.setTextDatum(TL_DATUM);
+    gfx.drawString("Local Time", 20, 20, 2);
     
     // Get current time
     time(&now);
@@ -58,90 +94,388 @@ void drawTimePanel() {
     if (hour12 == 0) hour12 = 12; // Convert 0 to 12 for 12-hour format
     const char* ampm = (timeinfo.tm_hour < 12) ? "AM" : "PM";
     sprintf(timeStr, "%d:%02d %s", hour12, timeinfo.tm_min, ampm);
-    tft.setTextColor(WHITE, PANEL);
-    tft.setTextDatum(TC_DATUM);
-    tft.drawString(timeStr, 120, 55, 7); // Large font size 7
+    gfx.setTextColor(WHITE, PANEL);
+    gfx.setTextDatum(TC_DATUM);
+    gfx.drawString(timeStr, 120, 55, 7); // Large font size 7
 }
 
-void drawBlockHeightPanel() {
+// Sparkline centred on y0, scaled to the graph area
+void drawSparkline(TFT_eSPI& gfx, int x0, int y0, int graphWidth, int graphHeight) {
+    int prevY = y0;
+    if (shown->sparklineSize >= 2) {
+        // Scale the backend sparkline to the graph area
+        float lo = shown->sparkline[0], hi = shown->sparkline[0];
+        for (size_t i = 1; i < shown->sparklineSize; i++) {
+            lo = min(lo, shown->sparkline[i]);
+            hi = max(hi, shown->sparkline[i]);
+        }
+        float range = hi > lo ? hi - lo : 1;
+        for (size_t i = 0; i < shown->sparklineSize; i++) {
+            int x = x0 + i * graphWidth / (shown->sparklineSize - 1);
+            int y = y0 + graphHeight / 2 - (int)((shown->sparkline[i] - lo) / range * graphHeight);
+            if (i > 0) {
+                int prevX = x0 + (i - 1) * graphWidth / (shown->sparklineSize - 1);
+                gfx.drawLine(prevX, prevY, x, y, GREEN);
+            }
+            prevY = y;
+        }
+        return;
+    }
+    // Placeholder until the backend sends one, made once so that every
+    // strip of a page draws the same graph
+    static int8_t wiggle[64];
+    static bool wiggleMade = false;
+    if (!wiggleMade) {
+        for (int i = 0; i < 64; i++) wiggle[i] = random(-6, 6);
+        wiggleMade = true;
+    }
+    int steps = min(graphWidth / 4, 63);
+    for (int i = 0; i <= steps; i++) {
+        int y = y0 + wiggle[i] * graphHeight / 20;
+        if (i > 0) {
+            gfx.drawLine(x0 + (i - 1) * 4, prevY, x0 + i * 4, y, GREEN);
+        }
+        prevY = y;
+    }
+}
+
+void drawBlockHeightPanel(TFT_eSPI& gfx = tft) {
     // Panel background (middle section)
-    tft.fillRoundRect(8, 106, 224, 120, 10, PANEL);
+    gfx.fillRoundRect(8, 106, 224, 120, 10, PANEL);
     
     // Header "Block Height"
-    tft.setTextColor(GRAY, PANEL);
-    tft.setTextDatum(TL_DATUM);
-    tft.drawString("Block Height", 20, 118, 2);
+    gfx.setTextColor(GRAY, PANEL);
+    gfx.setTextDatum(TL_DATUM);
+    gfx.drawString("Block Height", 20, 118, 2);
     
     // Percentage on right (5.3%)
     char pctStr[12];
-    sprintf(pctStr, "%.1f%%", data.blockChange);
-    tft.setTextDatum(TR_DATUM);
-    tft.setTextColor(GREEN, PANEL);
-    tft.drawString(pctStr, 228, 118, 2);
+    sprintf(pctStr, "%.1f%%", shown->blockChange);
+    gfx.setTextDatum(TR_DATUM);
+    gfx.setTextColor(GREEN, PANEL);
+    gfx.drawString(pctStr, 228, 118, 2);
     
     // Massive block number (890,518)
-    tft.setTextColor(WHITE, PANEL);
-    tft.setTextDatum(TC_DATUM);
+    gfx.setTextColor(WHITE, PANEL);
+    gfx.setTextDatum(TC_DATUM);
     char blockStr[20];
-    sprintf(blockStr, "%d", data.blockHeight);
-    tft.drawString(blockStr, 120, 155, 6); // Large font size 6
+    sprintf(blockStr, "%d", shown->blockHeight);
+    gfx.drawString(blockStr, 120, 155, 6); // Large font size 6
     
     // Green sparkline graph below number
-    int y0 = 200;
-    int prevY = y0;
-    int graphWidth = 200;
-    int graphHeight = 20;
-    for(int i = 0; i < graphWidth; i += 4) {
-        int y = y0 + random(-6, 6);
-        if (i > 0) {
-            tft.drawLine(20 + i - 4, prevY, 20 + i, y, GREEN);
-        }
-        prevY = y;
-    }
+    drawSparkline(gfx, 20, 200, 200, 20);
 }
 
-void drawBotStatusPanel() {
+void drawBotStatusPanel(TFT_eSPI& gfx = tft) {
     // Panel background (bottom section)
-    tft.fillRoundRect(8, 234, 224, 86, 10, PANEL);
+    gfx.fillRoundRect(8, 234, 224, 86, 10, PANEL);
     
     // "Bot Ready" status (yellow/gold color)
-    tft.setTextColor(GOLD, PANEL);
-    tft.setTextDatum(TC_DATUM);
-    tft.drawString("Bot Ready", 120, 250, 2);
+    gfx.setTextColor(GOLD, PANEL);
+    gfx.setTextDatum(TC_DATUM);
+    gfx.drawString("Bot Ready", 120, 250, 2);
     
-    // Status message "Waiting for signal..."
-    tft.setTextColor(WHITE, PANEL);
-    tft.drawString(data.botStatus, 120, 280, 2);
+    // Lines 270 to 302 are the ticker, see setupTicker()
     
     // Status indicator bar at bottom (gray)
-    tft.fillRect(60, 310, 120, 4, GRAY);
+    gfx.fillRect(60, 310, 120, 4, GRAY);
 }
 
-void drawMainDisplay() {
-    tft.fillScreen(BG_BLACK);
-    drawTimePanel();
-    drawBlockHeightPanel();
-    drawBotStatusPanel();
+void drawPricePanel(TFT_eSPI& gfx) {
+    // BTC price panel (top section)
+    gfx.fillRoundRect(8, 8, 224, 150, 10, PANEL);
+    gfx.setTextColor(GRAY, PANEL);
+    gfx.setTextDatum(TL_DATUM);
+    gfx.drawString("BTC / USD", 20, 20, 2);
+    
+    // 24h change on right
+    char pctStr[12];
+    sprintf(pctStr, "%+.1f%%", shown->btcChange);
+    gfx.setTextDatum(TR_DATUM);
+    gfx.setTextColor(shown->btcChange < 0 ? RED : GREEN, PANEL);
+    gfx.drawString(pctStr, 228, 20, 2);
+    
+    char priceStr[16];
+    sprintf(priceStr, "%.0f", shown->btcPrice);
+    gfx.setTextColor(WHITE, PANEL);
+    gfx.setTextDatum(TC_DATUM);
+    gfx.drawString(priceStr, 120, 45, 6); // Large font size 6
+    
+    // Large sparkline
+    drawSparkline(gfx, 20, 125, 200, 40);
 }
 
-void fetchBlockHeight() {
-    if (WiFi.status() != WL_CONNECTED) return;
+void drawProfitPanel(TFT_eSPI& gfx) {
+    // Profit panel (bottom section)
+    gfx.fillRoundRect(8, 166, 224, 154, 10, PANEL);
+    gfx.setTextColor(GRAY, PANEL);
+    gfx.setTextDatum(TL_DATUM);
+    gfx.drawString("Profit", 20, 178, 2);
+    gfx.drawString("Today", 20, 238, 2);
+    
+    char profitStr[20];
+    sprintf(profitStr, "%+.2f", shown->profitUsd);
+    gfx.setTextColor(shown->profitUsd < 0 ? RED : GREEN, PANEL);
+    gfx.setTextDatum(TR_DATUM);
+    gfx.drawString(profitStr, 220, 198, 4);
+    sprintf(profitStr, "%+.2f", shown->profitToday);
+    gfx.setTextColor(shown->profitToday < 0 ? RED : GREEN, PANEL);
+    gfx.drawString(profitStr, 220, 258, 4);
+    
+    // Trading mode at bottom
+    gfx.setTextColor(GOLD, PANEL);
+    gfx.setTextDatum(TC_DATUM);
+    gfx.drawString(shown->mode, 120, 296, 2);
+}
+
+// Page renderers, the page manager fills the background. They run once per
+// strip, so only the panels in the strip are drawn.
+void drawDashboardPage(TFT_eSPI& gfx) {
+    if (gfx.checkViewport(8, 8, 224, 90)) drawTimePanel(gfx);
+    if (gfx.checkViewport(8, 106, 224, 120)) drawBlockHeightPanel(gfx);
+    if (gfx.checkViewport(8, 234, 224, 86)) drawBotStatusPanel(gfx);
+}
+
+void drawPortfolioPage(TFT_eSPI& gfx) {
+    if (gfx.checkViewport(8, 8, 224, 150)) drawPricePanel(gfx);
+    if (gfx.checkViewport(8, 166, 224, 154)) drawProfitPanel(gfx);
+}
+
+// Returns true if the block height changed
+bool fetchBlockHeight() {
+    if (WiFi.status() != WL_CONNECTED) return false;
     
     HTTPClient http;
     http.begin("https://mempool.space/api/blocks/tip/height");
     http.setTimeout(5000);
+    bool changed = false;
     if (http.GET() == 200) {
         int newHeight = http.getString().toInt();
-        if (newHeight > 0) {
+        if (newHeight > 0 && newHeight != latest.blockHeight) {
             // Calculate change
-            if (data.blockHeight > 0) {
-                data.blockChange = ((float)(newHeight - data.blockHeight) / data.blockHeight) * 100.0;
+            if (latest.blockHeight > 0) {
+                latest.blockChange = ((float)(newHeight - latest.blockHeight) / latest.blockHeight) * 100.0;
+            }
+            latest.blockHeight = newHeight;
+            latest.lastUpdate = millis();
+            changed = true;
+        }
+    }
+    http.end();
+    return changed;
+}
+
+// Telemetry keys, hashed at compile time
+static constexpr JsonKey kBtcPrice("btc_price");
+static constexpr JsonKey kBtcChange("btc_change_24h");
+static constexpr JsonKey kProfitUsd("profit_usd");
+static constexpr JsonKey kProfitToday("profit_today");
+static constexpr JsonKey kMode("mode");
+static constexpr JsonKey kSparkline("sparkline");
+
+// Telemetry state, kept between polls so the backend only sends what changed
+JsonDocument telemetry;
+// "<epoch>:<n>" as the backend sent it; empty asks for a full snapshot. The epoch
+// changes when the backend restarts, so an old version never gets a delta.
+char telemetryVersion[32] = "";
+
+// Each patch is built in this block rather than on the heap, which polling every
+// few seconds would fragment. A frame is at most 512 bytes, well under 4 KB as a
+// document in small pools; one that doesn't fit fails like a corrupt frame.
+static uint8_t patchMemory[4096];
+ArenaAllocator patchArena(patchMemory, sizeof(patchMemory));
+
+// Returns true if a value shown on the display changed
+bool fetchTelemetry() {
+    if (WiFi.status() != WL_CONNECTED) return false;
+    
+    char url[128];
+    snprintf(url, sizeof(url), "http://%s:%d/api/telemetry/latest?since=%s",
+             BACKEND_HOST, BACKEND_PORT, telemetryVersion);
+    
+    HTTPClient http;
+    http.begin(url);
+    http.addHeader("Accept", "application/msgpack");
+    const char* headers[] = {"X-Telemetry-Version", "X-Telemetry-Patch"};
+    http.collectHeaders(headers, 2);
+    http.setTimeout(5000);
+    bool changed = false;
+    bool sparklineChanged = false;
+    // 304 means nothing changed since telemetryVersion
+    if (http.GET() == 200) {
+        // Read the frame in one go; parsing from the socket costs a call per byte
+        static uint8_t frame[512];
+        int len = http.getSize();
+        if (len > 0 && len <= (int)sizeof(frame) &&
+            http.getStream().readBytes(frame, len) == (size_t)len) {
+            patchArena.reset();  // The last patch is gone
+            JsonDocument patch(PoolPolicy::geometric(16), &patchArena);
+            if (!deserializeMsgPack(patch, frame, len)) {
+                // Anything but a delta is a full snapshot
+                if (http.header("X-Telemetry-Patch") != "1") telemetry.clear();
+                
+                // Only the values in the patch are touched
+                bool ok = mergePatch(telemetry, patch, [&](const char* path) {
+                    changed = true;
+                    if (path[0] == 0 || strcmp(path, "/sparkline") == 0)
+                        sparklineChanged = true;
+                });
+                // The lookups below compare key hashes; clear() and removed
+                // members drop the index, so it's built again after each patch
+                telemetry.as<JsonObject>().buildIndex();
+                // Ask for a full snapshot next time if the state is incomplete
+                strlcpy(telemetryVersion, ok ? http.header("X-Telemetry-Version").c_str() : "",
+                        sizeof(telemetryVersion));
+                
+                latest.btcPrice = telemetry[kBtcPrice] | latest.btcPrice;
+                latest.btcChange = telemetry[kBtcChange] | latest.btcChange;
+                latest.profitUsd = telemetry[kProfitUsd] | latest.profitUsd;
+                latest.profitToday = telemetry[kProfitToday] | latest.profitToday;
+                const char* mode = telemetry[kMode];
+                if (mode) strlcpy(latest.mode, mode, sizeof(latest.mode));
+                
+                if (sparklineChanged) {
+                    // A float32 array is stored packed, so this is a plain copy
+                    JsonSpan<float> spark = telemetry[kSparkline].as<JsonSpan<float>>();
+                    if (!spark.isNull()) {
+                        latest.sparklineSize = min(spark.size(), sizeof(latest.sparkline) / sizeof(float));
+                        memcpy(latest.sparkline, spark.data(), latest.sparklineSize * sizeof(float));
+                    } else {
+                        // Int or double values: JsonArray unpacks them into slots
+                        JsonArray values = telemetry[kSparkline];
+                        latest.sparklineSize = 0;
+                        for (JsonVariantConst v : values) {
+                            if (latest.sparklineSize == sizeof(latest.sparkline) / sizeof(float)) break;
+                            latest.sparkline[latest.sparklineSize++] = v.as<float>();
+                        }
+                    }
+                }
             }
-            data.blockHeight = newHeight;
-            data.lastUpdate = millis();
         }
     }
     http.end();
+    return changed;
+}
+
+// CYD touch controller (XPT2046), on its own SPI bus
+#define XPT2046_IRQ  36
+#define XPT2046_MOSI 32
+#define XPT2046_MISO 39
+#define XPT2046_CLK  25
+#define XPT2046_CS   33
+
+// Samples taken while a touch lasts, like TOUCH_SAMPLE_INTERVAL in TFT_eSPI
+#define TOUCH_SAMPLE_MS 5
+
+// Raw touch range and orientation for the portrait rotation
+#define TOUCH_RAW_X_MIN 200
+#define TOUCH_RAW_X_MAX 3700
+#define TOUCH_RAW_Y_MIN 240
+#define TOUCH_RAW_Y_MAX 3800
+#define TOUCH_SWAP_XY   true
+#define TOUCH_INVERT_X  false
+#define TOUCH_INVERT_Y  false
+
+SPIClass touchSpi(VSPI);
+TFT_eSPI_TouchSampler touch;
+TFT_eSPI_Gesture gestures;
+TaskHandle_t touchTaskHandle = nullptr;
+
+uint16_t readTouchChannel(uint8_t command) {
+    touchSpi.transfer(command);
+    return touchSpi.transfer16(0) >> 3;  // 12-bit result
+}
+
+// Feeds one sample to the touch filter
+void sampleTouch(uint32_t time) {
+    touchSpi.beginTransaction(SPISettings(SPI_TOUCH_FREQUENCY, MSBFIRST, SPI_MODE0));
+    digitalWrite(XPT2046_CS, LOW);
+    uint16_t z = 4095 + readTouchChannel(0xB0) - readTouchChannel(0xC0);
+    uint16_t x = readTouchChannel(0xD0);
+    uint16_t y = readTouchChannel(0x90);  // Last read powers down, IRQ enabled
+    digitalWrite(XPT2046_CS, HIGH);
+    touchSpi.endTransaction();
+    
+    touch.addSample(x, y, z, time);
+}
+
+// Converts a raw touch event to screen coordinates
+void mapTouch(touch_event_t& e) {
+    uint16_t rx = TOUCH_SWAP_XY ? e.y : e.x;
+    uint16_t ry = TOUCH_SWAP_XY ? e.x : e.y;
+    int32_t x = constrain(map(rx, TOUCH_RAW_X_MIN, TOUCH_RAW_X_MAX, 0, tft.width() - 1), 0, tft.width() - 1);
+    int32_t y = constrain(map(ry, TOUCH_RAW_Y_MIN, TOUCH_RAW_Y_MAX, 0, tft.height() - 1), 0, tft.height() - 1);
+    e.x = TOUCH_INVERT_X ? tft.width() - 1 - x : x;
+    e.y = TOUCH_INVERT_Y ? tft.height() - 1 - y : y;
+}
+
+// The controller pulls IRQ low when the screen is pressed
+void IRAM_ATTR touchIrq() {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(touchTaskHandle, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+// Sleeps until IRQ falls, then samples until the filter has let go of the touch, so
+// even a tap shorter than a render pass is sampled while the finger is down. The
+// XPT2046 has the VSPI bus to itself, so this never waits on the screen. A spurious
+// edge, which GPIO36 can see while WiFi runs, costs one sample below the threshold.
+void touchTask(void*) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        do {
+            sampleTouch(millis());
+            vTaskDelay(pdMS_TO_TICKS(TOUCH_SAMPLE_MS));
+        } while (touch.isActive() || !digitalRead(XPT2046_IRQ));
+    }
+}
+
+// Events are queued by touchTask and taken here, on the render task
+void handleTouch() {
+    touch_event_t e;
+    gesture_t g;
+    while (touch.getEvent(&e)) {
+        mapTouch(e);
+        if (!gestures.handleEvent(&e, &g)) continue;
+        if (g.type == GESTURE_SWIPE_LEFT) pages.next();
+        if (g.type == GESTURE_SWIPE_RIGHT) pages.previous();
+    }
+}
+
+void setupTouch() {
+    pinMode(XPT2046_IRQ, INPUT);
+    pinMode(XPT2046_CS, OUTPUT);
+    digitalWrite(XPT2046_CS, HIGH);
+    touchSpi.begin(XPT2046_CLK, XPT2046_MISO, XPT2046_MOSI, XPT2046_CS);
+    gestures.begin(tft.width(), tft.height());
+    
+    // Above the render task, so a sample is taken as soon as it's due, and on the same
+    // core, as the event queue between them has no barriers
+    xTaskCreatePinnedToCore(touchTask, "touch", 2048, nullptr, 2, &touchTaskHandle, 1);
+    attachInterrupt(digitalPinToInterrupt(XPT2046_IRQ), touchIrq, FALLING);
+}
+
+// The ticker scrolls a band of the bot status panel, between its rounded corners
+void setupTicker() {
+    ticker.begin(16, 270, 208, 32, WHITE, PANEL);
+}
+
+// Ticker items, set whenever a value in them changes
+void updateTicker() {
+    char text[40];
+    ticker.setItem(0, shown->botStatus);
+    snprintf(text, sizeof(text), "BTC %.0f  %+.1f%%", shown->btcPrice, shown->btcChange);
+    ticker.setItem(1, text);
+    snprintf(text, sizeof(text), "Today %+.2f", shown->profitToday);
+    ticker.setItem(2, text);
+    ticker.setItem(3, String("Mode: ") + shown->mode);
+}
+
+// Repaints a dashboard panel if the dashboard is on screen; the
+// pre-rendered page is out of date either way
+void updateDashboard(void (*drawPanel)(TFT_eSPI&)) {
+    pages.invalidate();
+    if (pages.current() == DASHBOARD_PAGE && !pages.busy()) drawPanel(tft);
 }
 
 void setupOTA() {
@@ -158,6 +492,107 @@ void setupOTA() {
     ArduinoOTA.begin();
 }
 
+// Polls the data sources, on core 0 with the WiFi stack. Blocking HTTP calls only
+// hold up this task; the renderer keeps drawing the last snapshot meanwhile.
+void ingestTask(void*) {
+    unsigned long lastBlockUpdate = millis();
+    unsigned long lastTelemetryUpdate = millis();
+    unsigned long lastStatusUpdate = millis();
+    for (;;) {
+        bool changed = false;
+        
+        // Update block height every 60 seconds
+        if (millis() - lastBlockUpdate > 60000) {
+            if (fetchBlockHeight()) {
+                latest.blockSeq++;
+                changed = true;
+            }
+            lastBlockUpdate = millis();
+        }
+        
+        // Update backend telemetry every 10 seconds
+        if (millis() - lastTelemetryUpdate > 10000) {
+            if (fetchTelemetry()) {
+                latest.telemetrySeq++;
+                changed = true;
+            }
+            lastTelemetryUpdate = millis();
+        }
+        
+        // Update bot status (mock for now)
+        if (millis() - lastStatusUpdate > 5000) {
+            // Rotate status messages
+            static int statusIndex = 0;
+            const char* statuses[] = {
+                "Waiting for signal...",
+                "Monitoring markets...",
+                "Ready to trade..."
+            };
+            strlcpy(latest.botStatus, statuses[statusIndex % 3], sizeof(latest.botStatus));
+            statusIndex++;
+            changed = true;
+            lastStatusUpdate = millis();
+        }
+        
+        if (changed) publishData();
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+}
+
+// Owns the screen and the touch events, on core 1. Takes a new snapshot at most once
+// a loop, so a page is always drawn from one consistent set of values.
+void renderTask(void*) {
+    // Values of the snapshot drawn last; once a new one is taken, the old buffer
+    // belongs to the ingest task again and must not be read
+    uint32_t blockSeq = shown->blockSeq;
+    uint32_t telemetrySeq = shown->telemetrySeq;
+    for (;;) {
+        // OTA draws its progress on the screen, so it's handled here
+        ArduinoOTA.handle();
+        
+        // Swipes start page transitions, drawn a frame at a time by update()
+        handleTouch();
+        
+        if (model.update()) {
+            shown = &model.read();
+            // Repaint only what changed
+            bool telemetryChanged = shown->telemetrySeq != telemetrySeq;
+            if (shown->blockSeq != blockSeq || telemetryChanged) {
+                updateDashboard(drawBlockHeightPanel);
+            }
+            if (telemetryChanged && pages.current() == PORTFOLIO_PAGE && !pages.busy()) {
+                pages.redraw();
+            }
+            updateTicker();
+            blockSeq = shown->blockSeq;
+            telemetrySeq = shown->telemetrySeq;
+        }
+        
+        // The ticker scrolls part of the screen, so it stops before a page is drawn
+        bool showTicker = pages.current() == DASHBOARD_PAGE && !pages.busy();
+        if (showTicker && !ticker.running()) ticker.start();
+        if (!showTicker) ticker.stop();
+        
+        pages.update(millis());
+        ticker.update(millis());
+        
+        // Update time every second
+        static unsigned long lastTimeUpdate = 0;
+        if (millis() - lastTimeUpdate > 1000) {
+            // The clock shows minutes, so it only changes once a minute
+            static time_t lastMinute = 0;
+            if (time(nullptr) / 60 != lastMinute) {
+                updateDashboard(drawTimePanel);
+                lastMinute = time(nullptr) / 60;
+            }
+            lastTimeUpdate = millis();
+        }
+        
+        // Short enough for the touch sampling and the transition frame rate
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
 void setup() {
     Serial.begin(115200);
     delay(300);
@@ -200,6 +635,7 @@ void setup() {
         
         // Fetch initial data
         fetchBlockHeight();
+        fetchTelemetry();
         
         delay(1000);
     } else {
@@ -209,42 +645,24 @@ void setup() {
     }
     
     // Draw main display
-    drawMainDisplay();
+    publishData();
+    model.update();
+    shown = &model.read();
+    setupTouch();
+    pages.begin();
+    pages.addPage(drawDashboardPage, BG_BLACK);
+    pages.addPage(drawPortfolioPage, BG_BLACK);
+    pages.show(DASHBOARD_PAGE);
+    setupTicker();
+    updateTicker();
+    
+    // The WiFi stack runs on core 0 and Arduino's loop() on core 1
+    xTaskCreatePinnedToCore(ingestTask, "ingest", 8192, nullptr, 1, nullptr, 0);
+    xTaskCreatePinnedToCore(renderTask, "render", 8192, nullptr, 1, nullptr, 1);
 }
 
 void loop() {
-    ArduinoOTA.handle();
-    
-    // Update time every second
-    static unsigned long lastTimeUpdate = 0;
-    if (millis() - lastTimeUpdate > 1000) {
-        drawTimePanel();
-        lastTimeUpdate = millis();
-    }
-    
-    // Update block height every 60 seconds
-    static unsigned long lastBlockUpdate = 0;
-    if (millis() - lastBlockUpdate > 60000) {
-        fetchBlockHeight();
-        drawBlockHeightPanel();
-        lastBlockUpdate = millis();
-    }
-    
-    // Update bot status (mock for now)
-    static unsigned long lastStatusUpdate = 0;
-    if (millis() - lastStatusUpdate > 5000) {
-        // Rotate status messages
-        static int statusIndex = 0;
-        const char* statuses[] = {
-            "Waiting for signal...",
-            "Monitoring markets...",
-            "Ready to trade..."
-        };
-        data.botStatus = statuses[statusIndex % 3];
-        statusIndex++;
-        drawBotStatusPanel();
-        lastStatusUpdate = millis();
-    }
-    
-    delay(100);
+    // Everything runs in the tasks
+    vTaskDelete(nullptr);
 }
+
@@ -0,0 +1,184 @@
+#include "page_manager.h"
+
+bool PageManager::begin(uint16_t stripHeight, bool cachePages) {
+    width_ = tft_.width();
+    height_ = tft_.height();
+    stripHeight_ = stripHeight;
+
+    // The pre-rendered page only fits in PSRAM, which DMA can't read, so it's
+    // allocated before DMA is enabled and copied to the screen by the CPU
+    if (cachePages && psramFound()) {
+        cache_ = new TFT_eSprite(&tft_);
+        cache_->setColorDepth(16);
+        if (!cache_->createSprite(width_, height_)) {
+            delete cache_;
+            cache_ = nullptr;
+        }
+    }
+
+    // Strips are sent through DMA, so they must be in internal RAM
+    dma_ = tft_.initDMA();
+    stripA_.setColorDepth(16);
+    stripB_.setColorDepth(16);
+    return stripA_.createSprite(width_, stripHeight_) != nullptr &&
+           stripB_.createSprite(width_, stripHeight_) != nullptr;
+}
+
+uint8_t PageManager::addPage(PageRenderer render, uint16_t background) {
+    if (count_ == maxPages) return count_ - 1;
+    pages_[count_] = render;
+    backgrounds_[count_] = background;
+    return count_++;
+}
+
+// Renders lines y to y + h of a page into a strip, shifted right by dx
+void PageManager::render(TFT_eSprite& canvas, uint8_t page, int16_t dx, int16_t y, int16_t h) {
+    (void)h;  // The strip clips the page
+    canvas.setViewport(dx, -y, width_, height_, true);
+    canvas.fillRect(0, 0, width_, height_, backgrounds_[page]);
+    pages_[page](canvas);
+    canvas.resetViewport();
+}
+
+void PageManager::pushStrip(TFT_eSprite& strip, int16_t y, int16_t h) {
+    if (dma_) {
+        // Returns once the previous strip is sent, so that one can be drawn again
+        tft_.pushImageDMA(0, y, width_, h, (uint16_t*)strip.getPointer());
+    } else {
+        strip.pushSprite(0, y, 0, 0, width_, h);
+    }
+}
+
+// Sends columns x to x + w of a full width sprite, from line sy, in one window.
+// pushSprite() with a source area would open a window per line.
+void PageManager::pushColumns(TFT_eSprite& sprite, int16_t x, int16_t y, int16_t w, int16_t h,
+                              int16_t sy) {
+    bool swap = tft_.getSwapBytes();
+    tft_.setSwapBytes(false);
+    tft_.setViewport(x, y, w, h, false);
+    tft_.pushImage(0, y, width_, h, (uint16_t*)sprite.getPointer() + sy * width_);
+    tft_.resetViewport();
+    tft_.setSwapBytes(swap);
+}
+
+void PageManager::show(uint8_t page) {
+    if (page >= count_) return;
+    current_ = page;
+
+    if (cached(page)) {
+        cache_->pushSprite(0, 0);
+    } else {
+        bool swap = tft_.getSwapBytes();
+        tft_.setSwapBytes(false);  // Sprites hold pixels in display byte order
+        tft_.startWrite();
+        for (int16_t y = 0, i = 0; y < height_; y += stripHeight_, i++) {
+            TFT_eSprite& strip = (i & 1) ? stripB_ : stripA_;
+            int16_t h = min<int16_t>(stripHeight_, height_ - y);
+            render(strip, page, 0, y, h);
+            pushStrip(strip, y, h);
+        }
+        if (dma_) tft_.dmaWait();
+        tft_.endWrite();
+        tft_.setSwapBytes(swap);
+    }
+
+    // Pre-render the page a swipe to the left would show
+    uint8_t next = (page + 1) % count_;
+    if (cachedPage_ != next) {
+        cachedPage_ = next;
+        cachedLines_ = 0;
+    }
+}
+
+void PageManager::go(uint8_t page, PageEffect effect) {
+    if (page >= count_ || page == current_ || transition_.active()) return;
+    if (effect == PageEffect::Cut) {
+        show(page);
+        return;
+    }
+    target_ = page;
+    pos_ = 0;
+    transition_.begin(effect, millis(), durationMs, frameMs);
+}
+
+// Draws the transition with the pages boundary at pos
+void PageManager::drawFrame(uint16_t pos) {
+    PageEffect effect = transition_.effect();
+
+    // A wipe leaves the old page where it is, so only the newly uncovered columns are drawn
+    if (effect == PageEffect::WipeLeft || effect == PageEffect::WipeRight) {
+        int16_t w = pos - pos_;
+        if (w <= 0) return;
+        int16_t x = effect == PageEffect::WipeRight ? pos_ : width_ - pos;
+        if (cached(target_)) {
+            pushColumns(*cache_, x, 0, w, height_, 0);
+            return;
+        }
+        for (int16_t y = 0; y < height_; y += stripHeight_) {
+            int16_t h = min<int16_t>(stripHeight_, height_ - y);
+            render(stripA_, target_, 0, y, h);
+            pushColumns(stripA_, x, y, w, h, 0);
+        }
+        return;
+    }
+
+    // A slide moves both pages, so the whole screen is drawn
+    bool left = effect == PageEffect::SlideLeft;
+    int16_t oldX = left ? -pos : pos;
+    int16_t newX = left ? width_ - pos : pos - width_;
+    bool fromCache = cached(target_);
+
+    bool swap = tft_.getSwapBytes();
+    tft_.setSwapBytes(false);
+    tft_.startWrite();
+    for (int16_t y = 0, i = 0; y < height_; y += stripHeight_, i++) {
+        TFT_eSprite& strip = (i & 1) ? stripB_ : stripA_;
+        int16_t h = min<int16_t>(stripHeight_, height_ - y);
+        if (pos < width_) render(strip, current_, oldX, y, h);
+        if (pos > 0) {
+            if (fromCache) {
+                // Copy the visible columns of the new page
+                uint16_t* dst = (uint16_t*)strip.getPointer();
+                uint16_t* src = (uint16_t*)cache_->getPointer() + y * width_;
+                int16_t dstX = left ? width_ - pos : 0;
+                int16_t srcX = left ? 0 : width_ - pos;
+                for (int16_t r = 0; r < h; r++) {
+                    memcpy(dst + r * width_ + dstX, src + r * width_ + srcX, pos * 2);
+                }
+            } else {
+                render(strip, target_, newX, y, h);
+            }
+        }
+        pushStrip(strip, y, h);
+    }
+    if (dma_) tft_.dmaWait();
+    tft_.endWrite();
+    tft_.setSwapBytes(swap);
+}
+
+bool PageManager::update(uint32_t now) {
+    if (transition_.active()) {
+        if (transition_.due(now)) {
+            uint16_t pos = transition_.frame(now, width_);
+            drawFrame(pos);
+            pos_ = pos;
+            if (!transition_.active()) {
+                current_ = target_;
+                cachedPage_ = (current_ + 1) % count_;
+                cachedLines_ = 0;
+            }
+        }
+        return true;
+    }
+
+    // Nothing to animate: pre-render one strip of the next page
+    if (cache_ && count_ > 1 && cachedLines_ < height_) {
+        int16_t h = min<int16_t>(stripHeight_, height_ - cachedLines_);
+        cache_->setViewport(0, cachedLines_, width_, h, false);
+        cache_->fillRect(0, 0, width_, height_, backgrounds_[cachedPage_]);
+        pages_[cachedPage_](*cache_);
+        cache_->resetViewport();
+        cachedLines_ += h;
+    }
+    return false;
+}
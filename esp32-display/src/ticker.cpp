@@ -0,0 +1,76 @@
+#include "ticker.h"
+
+bool Ticker::begin(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t fg, uint16_t bg,
+                   uint8_t font, int16_t pitch) {
+    x_ = x;
+    y_ = y;
+    w_ = w;
+    h_ = h;
+    fg_ = fg;
+    bg_ = bg;
+    font_ = font;
+    pitch_ = pitch;
+
+    // One item at a time, 1 bpp is enough for text in one colour
+    line_.setColorDepth(1);
+    return line_.createSprite(w_, pitch_) != nullptr;
+}
+
+void Ticker::setItem(uint8_t i, const String& text) {
+    if (i >= maxItems) return;
+    items_[i] = text;
+    if (i >= count_) count_ = i + 1;
+}
+
+// Draws a text row into the frame memory line it scrolls through. Row r of the text
+// is always on line y_ + r % h_, so the scroll start line alone decides where it shows.
+void Ticker::drawLine(uint32_t row) {
+    int32_t item = row / pitch_;
+    if (item != drawn_) {
+        line_.fillSprite(0);
+        if (count_) {
+            line_.setTextColor(1);
+            line_.setTextDatum(TC_DATUM);
+            line_.drawString(items_[item % count_], w_ / 2, 0, font_);
+        }
+        drawn_ = item;
+    }
+    line_.setBitmapColor(fg_, bg_);
+    line_.pushSprite(x_, y_ + row % h_, 0, row % pitch_, w_, 1);
+}
+
+void Ticker::start() {
+    tft_.setScrollArea(y_, TFT_VSCR_LINES - y_ - h_);
+
+    // Items may have changed while stopped
+    drawn_ = -1;
+    tft_.startWrite();
+    for (int16_t r = 0; r < h_; r++) drawLine(top_ + r);
+    tft_.endWrite();
+    tft_.scrollTo(top_ % h_);
+
+    running_ = true;
+    due_ = millis() + stepMs;
+}
+
+void Ticker::stop() {
+    if (!running_) return;
+    tft_.resetScrollArea();
+    running_ = false;
+}
+
+bool Ticker::update(uint32_t now) {
+    if (!running_ || (int32_t)(now - due_) < 0) return false;
+
+    // The top line of the band is about to come back in at the bottom: draw the row
+    // that shows there, then move the start line down by one
+    tft_.startWrite();
+    drawLine(top_ + h_);
+    top_++;
+    tft_.scrollTo(top_ % h_);
+    tft_.endWrite();
+
+    // Skip steps rather than rushing to catch up after a slow loop
+    due_ = now - due_ < stepMs ? due_ + stepMs : now + stepMs;
+    return true;
+}
@@ -0,0 +1,90 @@
+// Host stand-in for the parts of the Arduino core used by the code under test.
+// Time only moves when a test calls host::advance(), so tests are repeatable.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH   1
+#define LOW    0
+#define INPUT  0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+using std::min;
+using std::max;
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+namespace host {
+  inline uint32_t now_us = 0;
+  inline uint8_t pins[64];
+  // Called for every pin write, so a test can watch chip selects and DC lines
+  inline void (*onPinWrite)(uint8_t pin, uint8_t level) = nullptr;
+  // Whether psramFound() reports PSRAM; ps_*alloc() use the heap either way
+  inline bool psram = false;
+
+  inline void advance(uint32_t ms) { now_us += ms * 1000; }
+  inline void advanceMicros(uint32_t us) { now_us += us; }
+}
+
+inline uint32_t millis() { return host::now_us / 1000; }
+inline uint32_t micros() { return host::now_us; }
+inline void delay(uint32_t ms) { host::advance(ms); }
+inline void delayMicroseconds(uint32_t us) { host::advanceMicros(us); }
+inline void yield() {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+  host::pins[pin & 63] = level;
+  if (host::onPinWrite) host::onPinWrite(pin, level);
+}
+inline int digitalRead(uint8_t pin) { return host::pins[pin & 63]; }
+
+inline bool psramFound() { return host::psram; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+inline void* ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+
+inline uint32_t digitalPinToBitMask(uint8_t pin) { return 1UL << (pin & 31); }
+
+inline char* ltoa(long value, char* buf, int base) {
+  snprintf(buf, 34, base == 16 ? "%lx" : "%ld", value);
+  return buf;
+}
+
+inline long random(long hi) { return hi > 0 ? rand() % hi : 0; }
+inline long random(long lo, long hi) { return hi > lo ? lo + rand() % (hi - lo) : lo; }
+inline void randomSeed(unsigned long seed) { srand(seed); }
+
+struct HostSerial : public Print {
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  using Print::write;
+};
+inline HostSerial Serial;
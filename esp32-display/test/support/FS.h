@@ -0,0 +1,80 @@
+// Host stand-in for the Arduino FS library, with files kept in memory. SPIFFS, which
+// comes from SPIFFS.h on the ESP32, is declared here too. Calls on files are counted,
+// and a test can watch each read through host::onFileRead.
+#pragma once
+
+#include "Arduino.h"
+#include <map>
+#include <memory>
+
+namespace host {
+  struct FileStats {
+    uint32_t reads = 0;   // read() calls, of a byte or a block
+    uint32_t bytes = 0;   // Bytes read
+    uint32_t seeks = 0;
+  };
+  inline FileStats fileStats;
+  inline void (*onFileRead)() = nullptr;
+}
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File {
+public:
+  File() {}
+  File(std::string* data) : data_(data) {}
+
+  explicit operator bool() const { return data_ != nullptr; }
+  void close() { data_ = nullptr; }
+  size_t size() const { return data_ ? data_->size() : 0; }
+  size_t position() const { return pos_; }
+
+  bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+    host::fileStats.seeks++;
+    size_t base = mode == SeekSet ? 0 : mode == SeekCur ? pos_ : size();
+    if (!data_ || base + pos > size()) return false;
+    pos_ = base + pos;
+    return true;
+  }
+
+  int read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+  }
+  size_t read(uint8_t* buffer, size_t n) {
+    host::fileStats.reads++;
+    if (host::onFileRead) host::onFileRead();
+    n = std::min(n, size() - std::min(pos_, size()));
+    if (n) memcpy(buffer, data_->data() + pos_, n);
+    pos_ += n;
+    host::fileStats.bytes += n;
+    return n;
+  }
+
+private:
+  std::string* data_ = nullptr;
+  size_t pos_ = 0;
+};
+
+// Copies share the files, as copies of an ESP32 FS share the mounted file system
+class FS {
+public:
+  FS() : files_(new std::map<std::string, std::string>) {}
+
+  std::string& file(const std::string& path) { return (*files_)[path]; }
+
+  bool exists(const String& path) const { return files_->count(path.c_str()) != 0; }
+  File open(const String& path, const char* = "r") {
+    auto it = files_->find(path.c_str());
+    return it == files_->end() ? File() : File(&it->second);
+  }
+
+private:
+  std::shared_ptr<std::map<std::string, std::string>> files_;
+};
+
+}  // namespace fs
+
+inline fs::FS SPIFFS;
@@ -0,0 +1,41 @@
+// Host stand-in for the Arduino Print class
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(long n, int base = DEC) { return printf_(base == HEX ? "%lx" : "%ld", n); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned long n, int base = DEC) { return printf_(base == HEX ? "%lx" : "%lu", n); }
+  size_t print(unsigned n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(double d, int digits = 2) { return printf_("%.*f", digits, d); }
+  template <typename T> size_t println(const T& v) { return print(v) + println(); }
+  size_t println() { return write((const uint8_t*)"\r\n", 2); }
+
+private:
+  template <typename... A> size_t printf_(const char* fmt, A... a) {
+    char buf[40];
+    int n = snprintf(buf, sizeof(buf), fmt, a...);
+    return write((const uint8_t*)buf, n < (int)sizeof(buf) ? n : sizeof(buf) - 1);
+  }
+};
@@ -0,0 +1,49 @@
+// Host stand-in for the Arduino SPI library. Every byte sent goes to host::onSpiByte,
+// see host_panel.h for a display that listens to it.
+#pragma once
+
+#include "Arduino.h"
+
+#define MSBFIRST  1
+#define SPI_MODE0 0
+#define SPI_MODE3 3
+#define VSPI 3
+#define HSPI 2
+
+namespace host {
+  inline void (*onSpiByte)(uint8_t) = nullptr;
+  // Returned by transfers, e.g. for a touch controller reply
+  inline uint8_t (*onSpiRead)() = nullptr;
+}
+
+struct SPISettings {
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+  SPIClass(uint8_t bus = 0) { (void)bus; }
+  void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  void setFrequency(uint32_t) {}
+  void setHwCs(bool) {}
+
+  uint8_t transfer(uint8_t b) {
+    if (host::onSpiByte) host::onSpiByte(b);
+    return host::onSpiRead ? host::onSpiRead() : 0;
+  }
+  uint16_t transfer16(uint16_t w) {
+    uint16_t hi = transfer(w >> 8);
+    return hi << 8 | transfer(w);
+  }
+  void transfer(void* data, uint32_t size) {
+    uint8_t* p = (uint8_t*)data;
+    while (size--) { *p = transfer(*p); p++; }
+  }
+  void writeBytes(const uint8_t* data, uint32_t size) { while (size--) transfer(*data++); }
+};
+
+inline SPIClass SPI;
@@ -0,0 +1,49 @@
+// Host stand-in for the Arduino String class, backed by std::string
+#pragma once
+
+#include <stdio.h>
+#include <string>
+
+class String {
+public:
+  String() {}
+  String(const char* s) : s_(s ? s : "") {}
+  String(const std::string& s) : s_(s) {}
+  String(char c) : s_(1, c) {}
+  String(int n) : s_(std::to_string(n)) {}
+  String(unsigned n) : s_(std::to_string(n)) {}
+  String(long n) : s_(std::to_string(n)) {}
+  String(unsigned long n) : s_(std::to_string(n)) {}
+
+  const char* c_str() const { return s_.c_str(); }
+  unsigned int length() const { return s_.size(); }
+  char operator[](unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+  char charAt(unsigned int i) const { return (*this)[i]; }
+  void toCharArray(char* buf, unsigned int size, unsigned int index = 0) const {
+    if (!size) return;
+    size_t n = index < s_.size() ? s_.copy(buf, size - 1, index) : 0;
+    buf[n] = 0;
+  }
+  long toInt() const { return atol(s_.c_str()); }
+  int indexOf(char c, unsigned int from = 0) const {
+    size_t i = s_.find(c, from);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+
+  String& operator+=(const String& s) { s_ += s.s_; return *this; }
+  String& operator+=(const char* s) { s_ += s; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  bool concat(const String& s) { s_ += s.s_; return true; }
+  bool concat(char c) { s_ += c; return true; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String& a, const char* b) { return String(a.s_ + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.s_); }
+  bool operator==(const String& s) const { return s_ == s.s_; }
+  bool operator==(const char* s) const { return s_ == s; }
+  bool operator!=(const String& s) const { return s_ != s.s_; }
+  bool operator!=(const char* s) const { return s_ != s; }
+
+private:
+  std::string s_;
+};
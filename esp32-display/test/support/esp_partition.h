@@ -0,0 +1,80 @@
+// Host stand-in for the ESP-IDF partition API: one data partition whose contents a
+// test sets, mapped by pointing into them. Mappings are counted so a test can check
+// that each one is released, and mmap can be made to fail.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#ifndef ESP_IDF_VERSION_MAJOR
+  #define ESP_IDF_VERSION_MAJOR 5
+#endif
+
+typedef int esp_err_t;
+#define ESP_OK                0
+#define ESP_FAIL              -1
+#define ESP_ERR_INVALID_ARG   0x102
+#define ESP_ERR_INVALID_SIZE  0x104
+
+typedef enum { ESP_PARTITION_TYPE_APP = 0x00, ESP_PARTITION_TYPE_DATA = 0x01 } esp_partition_type_t;
+typedef enum { ESP_PARTITION_SUBTYPE_ANY = 0xff } esp_partition_subtype_t;
+typedef enum { ESP_PARTITION_MMAP_DATA, ESP_PARTITION_MMAP_INST } esp_partition_mmap_memory_t;
+typedef uint32_t esp_partition_mmap_handle_t;
+
+typedef struct {
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+} esp_partition_t;
+
+namespace host {
+  struct Partition {
+    esp_partition_t info;
+    std::string data;
+  };
+  inline Partition partition;
+  inline int mappings = 0;           // Mapped and not yet unmapped
+  inline bool mmapFails = false;     // esp_partition_mmap() returns ESP_FAIL
+  inline bool mmapNoData = false;    // esp_partition_mmap() succeeds with a null pointer
+
+  inline void setPartition(const char* label, const std::string& data) {
+    partition.info = esp_partition_t();
+    partition.info.type = ESP_PARTITION_TYPE_DATA;
+    partition.info.subtype = ESP_PARTITION_SUBTYPE_ANY;
+    partition.info.size = data.size();
+    strncpy(partition.info.label, label, sizeof(partition.info.label) - 1);
+    partition.data = data;
+  }
+}
+
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t,
+                                                       const char* label) {
+  const esp_partition_t& p = host::partition.info;
+  if (p.size == 0 || p.type != type || (label && strcmp(label, p.label) != 0)) return nullptr;
+  return &p;
+}
+
+inline esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* dst, size_t size) {
+  if (partition != &host::partition.info) return ESP_ERR_INVALID_ARG;
+  if (offset > partition->size || size > partition->size - offset) return ESP_ERR_INVALID_SIZE;
+  memcpy(dst, host::partition.data.data() + offset, size);
+  return ESP_OK;
+}
+
+inline esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, size_t size,
+                                    esp_partition_mmap_memory_t, const void** out_ptr,
+                                    esp_partition_mmap_handle_t* out_handle) {
+  if (partition != &host::partition.info) return ESP_ERR_INVALID_ARG;
+  if (offset > partition->size || size > partition->size - offset) return ESP_ERR_INVALID_SIZE;
+  if (host::mmapFails) return ESP_FAIL;
+  static esp_partition_mmap_handle_t handles = 0;
+  *out_ptr = host::mmapNoData ? nullptr : host::partition.data.data() + offset;
+  *out_handle = ++handles;
+  host::mappings++;
+  return ESP_OK;
+}
+
+inline void esp_partition_munmap(esp_partition_mmap_handle_t) { host::mappings--; }
@@ -0,0 +1,125 @@
+// An ILI9341 on the host. It decodes the bytes TFT_eSPI sends through SPI.h and keeps
+// the frame memory, the scroll registers and bus statistics. Column and page
+// addresses are taken as screen coordinates, as in rotation 0.
+#pragma once
+
+#include <SPI.h>
+#include <vector>
+
+class HostPanel {
+public:
+  static const int width = TFT_WIDTH;
+  static const int height = TFT_HEIGHT;
+
+  struct Stats {
+    uint32_t commands = 0;      // Command bytes (DC low)
+    uint32_t dataBytes = 0;     // Parameter and pixel bytes (DC high)
+    uint32_t windows = 0;       // RAMWR commands
+    uint32_t pixels = 0;        // Pixels written to the frame memory
+    uint32_t transactions = 0;  // Chip select falling edges
+    uint32_t bytes() const { return commands + dataBytes; }
+  };
+
+  // A command and its parameters; RAMWR keeps the number of pixels instead
+  struct Command {
+    uint8_t code;
+    std::vector<uint8_t> params;
+    uint32_t pixels = 0;
+  };
+
+  uint16_t frame[height][width];
+  Stats stats;
+  std::vector<Command> log;
+  bool logging = false;
+
+  // Scroll registers as last set by VSCRDEF and VSCRSADD
+  uint16_t tfa = 0, vsa = height, bfa = 0, vsp = 0;
+
+  HostPanel() {
+    memset(frame, 0, sizeof(frame));
+    active() = this;
+    host::onSpiByte = [](uint8_t b) { active()->receive(b); };
+    host::onPinWrite = [](uint8_t pin, uint8_t level) {
+      if (pin == TFT_CS && level == LOW && active()->cs_) active()->stats.transactions++;
+      if (pin == TFT_CS) active()->cs_ = level;
+    };
+  }
+  ~HostPanel() {
+    if (active() == this) {
+      host::onSpiByte = nullptr;
+      host::onPinWrite = nullptr;
+      active() = nullptr;
+    }
+  }
+
+  void clearStats() {
+    stats = Stats();
+    log.clear();
+  }
+
+  // Pixel in frame memory
+  uint16_t pixel(int x, int y) const { return frame[y][x]; }
+
+  // Pixel seen on screen row y, after hardware scrolling
+  uint16_t shown(int x, int y) const { return frame[line(y)][x]; }
+  int line(int y) const {
+    if (y < tfa || y >= tfa + vsa || vsa == 0) return y;
+    return tfa + (vsp - tfa + y - tfa) % vsa;
+  }
+
+private:
+  static HostPanel*& active() {
+    static HostPanel* panel = nullptr;
+    return panel;
+  }
+
+  void receive(uint8_t b) {
+    if (host::pins[TFT_DC] == LOW) {
+      stats.commands++;
+      code_ = b;
+      n_ = 0;
+      if (b == 0x2C) {
+        stats.windows++;
+        x_ = xs_;
+        y_ = ys_;
+      }
+      if (logging) log.push_back(Command{b, {}});
+      return;
+    }
+
+    stats.dataBytes++;
+    if (code_ == 0x2C) {
+      if (n_++ & 1) {
+        uint16_t c = hi_ << 8 | b;
+        if (x_ < width && y_ < height) frame[y_][x_] = c;
+        stats.pixels++;
+        if (logging && !log.empty()) log.back().pixels++;
+        if (++x_ > xe_) {
+          x_ = xs_;
+          y_++;
+        }
+      } else {
+        hi_ = b;
+      }
+      return;
+    }
+
+    if (logging && !log.empty()) log.back().params.push_back(b);
+    uint16_t* word = nullptr;
+    uint8_t i = n_++;
+    switch (code_) {
+      case 0x2A: word = i < 2 ? &xs_ : &xe_; break;
+      case 0x2B: word = i < 2 ? &ys_ : &ye_; break;
+      case 0x33: word = i < 2 ? &tfa : i < 4 ? &vsa : &bfa; break;
+      case 0x37: word = &vsp; break;
+    }
+    if (word && i < 6) *word = (i & 1) ? (*word & 0xFF00) | b : b << 8;
+  }
+
+  uint8_t code_ = 0;
+  uint32_t n_ = 0;
+  uint8_t hi_ = 0;
+  uint8_t cs_ = HIGH;
+  uint16_t xs_ = 0, xe_ = width - 1, ys_ = 0, ye_ = height - 1;
+  uint16_t x_ = 0, y_ = 0;
+};
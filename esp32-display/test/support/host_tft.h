@@ -0,0 +1,19 @@
+// TFT_eSPI built for the host, drawing on a HostPanel. Include once per test suite,
+// after any setup defines such as SMOOTH_FONT.
+#pragma once
+
+#include "host_panel.h"
+#include <TFT_eSPI.cpp>
+
+// There is no DMA engine on the host, so DMA transfers are plain blocking pushes
+bool TFT_eSPI::initDMA(bool) { return DMA_Enabled = true; }
+void TFT_eSPI::deInitDMA(void) { DMA_Enabled = false; }
+bool TFT_eSPI::dmaBusy(void) { return false; }
+void TFT_eSPI::dmaWait(void) {}
+void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len) { pushPixels(image, len); }
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t*) {
+  pushImage(x, y, w, h, image);
+}
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* image, bool bpp8, uint16_t* cmap) {
+  pushImage(x, y, w, h, image, bpp8, cmap);
+}
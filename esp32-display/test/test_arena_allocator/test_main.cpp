@@ -0,0 +1,156 @@
+// ArenaAllocator: the telemetry patch of every poll is parsed without touching the heap
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <stdint.h>
+#include <string>
+
+#ifdef __GLIBC__
+// Counts the heap calls of the whole program, ArduinoJson's default allocator included
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void __libc_free(void*);
+
+static size_t heapCalls = 0;
+
+extern "C" void* malloc(size_t size) {
+    heapCalls++;
+    return __libc_malloc(size);
+}
+extern "C" void* realloc(void* p, size_t size) {
+    heapCalls++;
+    return __libc_realloc(p, size);
+}
+extern "C" void* calloc(size_t n, size_t size) {
+    heapCalls++;
+    return __libc_calloc(n, size);
+}
+extern "C" void free(void* p) { __libc_free(p); }
+#endif
+
+void setUp() {}
+void tearDown() {}
+
+// A full telemetry snapshot as the backend packs it: float32 values and sparkline
+static std::string snapshot() {
+    JsonDocument doc;
+    doc["btc_price"] = 67123.45f;
+    doc["btc_change_24h"] = -1.25f;
+    doc["profit_usd"] = 123.5f;
+    doc["profit_today"] = 12.25f;
+    doc["mode"] = "paper trading";
+    doc["bot_status"] = "running";
+    doc["open_positions"] = 3;
+    JsonArray sparkline = doc["sparkline"].to<JsonArray>();
+    for (int i = 0; i < 20; i++) sparkline.add(67000.0f + i * 10);
+    std::string frame;
+    serializeMsgPack(doc, frame);
+    return frame;
+}
+
+static uint8_t patchMemory[4096];
+
+// The polls of fetchTelemetry(): reset the arena, then parse the frame
+static void test_polls_do_not_allocate() {
+#ifndef __GLIBC__
+    TEST_IGNORE_MESSAGE("Counting heap calls needs glibc");
+#else
+    std::string frame = snapshot();
+    TEST_ASSERT_LESS_OR_EQUAL(512, frame.size());
+
+    ArenaAllocator arena(patchMemory, sizeof(patchMemory));
+    size_t before = heapCalls;
+    size_t used = 0;
+    for (int poll = 0; poll < 1000; poll++) {
+        arena.reset();
+        JsonDocument patch(PoolPolicy::geometric(16), &arena);
+        TEST_ASSERT_TRUE(deserializeMsgPack(patch, frame.data(), frame.size()) ==
+                         DeserializationError::Ok);
+        TEST_ASSERT_EQUAL_FLOAT(67123.45f, patch["btc_price"].as<float>());
+        TEST_ASSERT_EQUAL(20, patch["sparkline"].size());
+        used = arena.size();
+    }
+    TEST_ASSERT_EQUAL(0, heapCalls - before);
+
+    char message[64];
+    snprintf(message, sizeof(message), "%zu byte frame uses %zu bytes of the arena",
+             frame.size(), used);
+    TEST_MESSAGE(message);
+
+    // The same polls on the default allocator
+    before = heapCalls;
+    for (int poll = 0; poll < 1000; poll++) {
+        JsonDocument patch;
+        deserializeMsgPack(patch, frame.data(), frame.size());
+    }
+    TEST_ASSERT_GREATER_THAN(1000, heapCalls - before);
+#endif
+}
+
+// A frame too big for the arena fails cleanly, and the next one parses
+static void test_too_big_fails_with_no_memory() {
+    static uint8_t small[512];
+    ArenaAllocator arena(small, sizeof(small));
+    std::string frame = snapshot();
+    {
+        JsonDocument patch(PoolPolicy::geometric(16), &arena);
+        TEST_ASSERT_TRUE(deserializeMsgPack(patch, frame.data(), frame.size()) ==
+                         DeserializationError::NoMemory);
+    }
+    arena.reset();
+    JsonDocument patch(PoolPolicy::geometric(16), &arena);
+    TEST_ASSERT_TRUE(deserializeMsgPack(patch, "\x81\xa1" "a\x01", 4) ==
+                     DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(1, patch["a"].as<int>());
+}
+
+static void test_blocks_are_aligned() {
+    ArenaAllocator arena(patchMemory + 1, sizeof(patchMemory) - 1);
+    for (size_t size : {1, 3, 8, 13, 64}) {
+        void* p = arena.allocate(size);
+        TEST_ASSERT_NOT_NULL(p);
+        TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(p) % alignof(double));
+    }
+}
+
+static void test_last_block_grows_in_place() {
+    ArenaAllocator arena(patchMemory, sizeof(patchMemory));
+    void* a = arena.allocate(16);
+    void* b = arena.allocate(16);
+    TEST_ASSERT_TRUE(arena.reallocate(b, 200) == b);
+
+    // A block in the middle moves, keeping its bytes
+    memset(a, 0x5A, 16);
+    void* moved = arena.reallocate(a, 64);
+    TEST_ASSERT_TRUE(moved != a);
+    TEST_ASSERT_EQUAL_HEX8(0x5A, static_cast<uint8_t*>(moved)[15]);
+
+    // Freeing the last block gives its bytes back
+    size_t size = arena.size();
+    void* c = arena.allocate(32);
+    arena.deallocate(c);
+    TEST_ASSERT_EQUAL(size, arena.size());
+}
+
+static void test_mark_and_reset() {
+    ArenaAllocator arena(patchMemory, sizeof(patchMemory));
+    arena.allocate(100);
+    size_t mark = arena.mark();
+    arena.allocate(100);
+    arena.reset(mark);
+    TEST_ASSERT_EQUAL(mark, arena.size());
+    arena.reset();
+    TEST_ASSERT_EQUAL(0, arena.size());
+    TEST_ASSERT_NULL(arena.allocate(sizeof(patchMemory) + 1));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_polls_do_not_allocate);
+    RUN_TEST(test_too_big_fails_with_no_memory);
+    RUN_TEST(test_blocks_are_aligned);
+    RUN_TEST(test_last_block_grows_in_place);
+    RUN_TEST(test_mark_and_reset);
+    return UNITY_END();
+}
@@ -0,0 +1,111 @@
+// JsonArray::buildIndex(): arr[i] stays right through edits, and an indexed loop
+// costs about what an iterator loop does
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+void setUp() {}
+void tearDown() {}
+
+static void fill(JsonArray array, int n) {
+    for (int i = 0; i < n; i++) array.add(i);
+}
+
+static void test_reading_does_not_build_an_index() {
+    JsonDocument doc;
+    fill(doc.to<JsonArray>(), 100);
+    size_t before = doc.memoryReport().overhead;  // Counts the index
+
+    JsonArrayConst array = doc.as<JsonArrayConst>();
+    for (int i = 0; i < 100; i++) TEST_ASSERT_EQUAL(i, array[i].as<int>());
+    TEST_ASSERT_EQUAL(before, doc.memoryReport().overhead);
+
+    TEST_ASSERT_TRUE(doc.as<JsonArray>().buildIndex());
+    TEST_ASSERT_GREATER_THAN(before, doc.memoryReport().overhead);
+}
+
+static void test_indexed_array_follows_edits() {
+    JsonDocument doc;
+    JsonArray array = doc.to<JsonArray>();
+    fill(array, 50);
+    TEST_ASSERT_TRUE(array.buildIndex());
+    for (int i = 0; i < 50; i++) TEST_ASSERT_EQUAL(i, array[i].as<int>());
+
+    // Appended elements are found past the end of the index
+    fill(array, 10);
+    TEST_ASSERT_EQUAL(9, array[59].as<int>());
+    TEST_ASSERT_TRUE(array[60].isNull());
+
+    // Removing drops the index
+    array.remove(0);
+    TEST_ASSERT_EQUAL(1, array[0].as<int>());
+    TEST_ASSERT_EQUAL(49, array[48].as<int>());
+    TEST_ASSERT_EQUAL(9, array[58].as<int>());
+
+    array.clear();
+    TEST_ASSERT_TRUE(array[0].isNull());
+    fill(array, 3);
+    TEST_ASSERT_EQUAL(2, array[2].as<int>());
+}
+
+// Only the last few arrays keep an index; the others walk their list again
+static void test_many_arrays() {
+    JsonDocument doc;
+    for (int a = 0; a < 5; a++) {
+        JsonArray array = doc[a].to<JsonArray>();
+        fill(array, 20 + a);
+        TEST_ASSERT_TRUE(array.buildIndex());
+    }
+    for (int a = 0; a < 5; a++)
+        for (int i = 0; i < 20 + a; i++) TEST_ASSERT_EQUAL(i, doc[a][i].as<int>());
+}
+
+static void test_unbound_array() {
+    JsonArray array;
+    TEST_ASSERT_FALSE(array.buildIndex());
+}
+
+// ns per element, for a loop over arr[i] and a loop over the iterator
+static void test_benchmark() {
+    using namespace std::chrono;
+    for (int n : {10, 100, 1000}) {
+        JsonDocument doc;
+        JsonArray array = doc.to<JsonArray>();
+        fill(array, n);
+        const int runs = 200000 / n;
+
+        long sum = 0;
+        auto t0 = steady_clock::now();
+        for (int r = 0; r < runs; r++)
+            for (int i = 0; i < n; i++) sum += array[i].as<int>();
+        auto t1 = steady_clock::now();
+        array.buildIndex();
+        for (int r = 0; r < runs; r++)
+            for (int i = 0; i < n; i++) sum += array[i].as<int>();
+        auto t2 = steady_clock::now();
+        for (int r = 0; r < runs; r++)
+            for (JsonVariant v : array) sum += v.as<int>();
+        auto t3 = steady_clock::now();
+        TEST_ASSERT_EQUAL(3L * runs * n * (n - 1) / 2, sum);
+
+        double perElement = 1e9 / runs / n;
+        char message[96];
+        snprintf(message, sizeof(message), "n=%d: walk %.1f ns, indexed %.1f ns, iterator %.1f ns",
+                 n, duration<double>(t1 - t0).count() * perElement,
+                 duration<double>(t2 - t1).count() * perElement,
+                 duration<double>(t3 - t2).count() * perElement);
+        TEST_MESSAGE(message);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_reading_does_not_build_an_index);
+    RUN_TEST(test_indexed_array_follows_edits);
+    RUN_TEST(test_many_arrays);
+    RUN_TEST(test_unbound_array);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
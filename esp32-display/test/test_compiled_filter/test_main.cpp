@@ -0,0 +1,212 @@
+// CompiledFilter must keep exactly what Filter keeps, and be quicker at it
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <string>
+
+using DeserializationOption::CompiledFilter;
+using DeserializationOption::Filter;
+
+void setUp() {}
+void tearDown() {}
+
+static const char* keys[] = {"a", "b", "c", "ab", "*", ""};
+
+static void randomFilter(std::mt19937& rng, JsonVariant filter, int depth) {
+    switch (depth > 2 ? rng() % 5 : rng() % 7) {
+        case 0: filter.set(true); break;
+        case 1: filter.set(false); break;
+        case 2: filter.set(nullptr); break;
+        case 3: filter.set(1); break;
+        case 4: filter.set("x"); break;
+        case 5: randomFilter(rng, filter.to<JsonArray>().add<JsonVariant>(), depth + 1); break;
+        default: {
+            JsonObject object = filter.to<JsonObject>();
+            for (int n = rng() % 5, i = 0; i < n; i++)
+                randomFilter(rng, object[keys[rng() % 6]].to<JsonVariant>(), depth + 1);
+        }
+    }
+}
+
+static void randomInput(std::mt19937& rng, std::string& out, int depth) {
+    switch (depth > 3 ? rng() % 3 : rng() % 5) {
+        case 0: out += std::to_string(rng() % 100); break;
+        case 1: out += "\"v\""; break;
+        case 2: out += rng() % 2 ? "null" : "true"; break;
+        case 3:
+            out += '[';
+            for (int n = rng() % 4, i = 0; i < n; i++) {
+                if (i) out += ',';
+                randomInput(rng, out, depth + 1);
+            }
+            out += ']';
+            break;
+        default:
+            out += '{';
+            for (int n = rng() % 5, i = 0; i < n; i++) {
+                if (i) out += ',';
+                out += '"' + std::string(keys[rng() % 6]) + "\":";
+                randomInput(rng, out, depth + 1);
+            }
+            out += '}';
+    }
+}
+
+static std::string filtered(const std::string& input, Filter filter) {
+    JsonDocument doc;
+    deserializeJson(doc, input, filter);
+    std::string out;
+    serializeJson(doc, out);
+    return out;
+}
+
+template <size_t N>
+static std::string filtered(const std::string& input, const CompiledFilter<N>& filter) {
+    JsonDocument doc;
+    deserializeJson(doc, input, filter);
+    std::string out;
+    serializeJson(doc, out);
+    return out;
+}
+
+// A member set to null falls back to "*", like an absent one
+static void test_null_member_falls_back_to_wildcard() {
+    JsonDocument filter;
+    deserializeJson(filter, "{\"a\":null,\"b\":false,\"*\":true}");
+    CompiledFilter<8> compiled(filter);
+    TEST_ASSERT_FALSE(compiled.overflowed());
+
+    std::string input = "{\"a\":[1],\"b\":2,\"c\":3}";
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[1],\"c\":3}", filtered(input, Filter(filter)).c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[1],\"c\":3}", filtered(input, compiled).c_str());
+}
+
+static void test_nested_wildcard_and_arrays() {
+    JsonDocument filter;
+    filter["*"]["name"] = true;
+    filter["list"][0]["id"] = true;
+    filter["keep"] = 1;
+    CompiledFilter<16> compiled(filter);
+
+    std::string input =
+        "{\"a\":{\"name\":\"x\",\"y\":1},\"list\":[{\"id\":1,\"z\":2},{\"id\":3}],"
+        "\"keep\":[1,2],\"b\":{\"name\":[1]}}";
+    std::string expected = filtered(input, Filter(filter));
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), filtered(input, compiled).c_str());
+
+    // The same through MessagePack
+    JsonDocument source;
+    deserializeJson(source, input);
+    std::string msgpack;
+    serializeMsgPack(source, msgpack);
+    JsonDocument a, b;
+    deserializeMsgPack(a, msgpack, Filter(filter));
+    deserializeMsgPack(b, msgpack, compiled);
+    TEST_ASSERT_TRUE(a == b);
+}
+
+// Short keys live in the slots of the filter, which move when the pools shrink
+static void test_survives_shrinking_the_filter() {
+    JsonDocument filter;
+    deserializeJson(filter, "{\"id\":true,\"name\":true}");
+    for (int i = 0; i < 100; i++) filter["pad"][i] = i;
+    CompiledFilter<8> compiled(filter);
+
+    filter.remove("pad");
+    filter.shrinkToFit();
+    TEST_ASSERT_EQUAL_STRING("{\"id\":1,\"name\":\"x\"}",
+                             filtered("{\"id\":1,\"name\":\"x\",\"z\":2}", compiled).c_str());
+}
+
+static void test_too_small_denies_everything() {
+    JsonDocument filter;
+    filter["a"] = true;
+    filter["b"] = true;
+    CompiledFilter<3> compiled(filter);
+    TEST_ASSERT_TRUE(compiled.overflowed());
+    TEST_ASSERT_EQUAL_STRING("null", filtered("{\"a\":1}", compiled).c_str());
+}
+
+static void test_random_filters_match_filter() {
+    std::mt19937 rng(30);
+    for (int i = 0; i < 3000; i++) {
+        JsonDocument filter;
+        randomFilter(rng, filter.to<JsonVariant>(), 0);
+        CompiledFilter<64> compiled(filter);
+        TEST_ASSERT_FALSE(compiled.overflowed());
+
+        for (int j = 0; j < 5; j++) {
+            std::string input;
+            randomInput(rng, input, 0);
+            std::string expected = filtered(input, Filter(filter));
+            std::string actual = filtered(input, compiled);
+            if (expected != actual) {
+                std::string text;
+                serializeJson(filter, text);
+                text += " on " + input + ": " + expected + " != " + actual;
+                TEST_FAIL_MESSAGE(text.c_str());
+            }
+        }
+    }
+}
+
+// An Alpaca-like bar series with many members, of which a few are kept
+static void test_benchmark() {
+    std::string input = "{\"symbol\":\"AAPL\",\"bars\":[";
+    for (int b = 0; b < 20; b++) {
+        if (b) input += ',';
+        input += '{';
+        for (int k = 0; k < 500; k++) {
+            char member[32];
+            snprintf(member, sizeof(member), "%s\"k%03d\":%d.25", k ? "," : "", k, k);
+            input += member;
+        }
+        input += ",\"c\":123.5,\"t\":\"2024-01-01T00:00:00Z\",\"v\":1000}";
+    }
+    input += "],\"next_page_token\":null,\"extra\":{\"x\":[1,2,3]}}";
+
+    JsonDocument filter;
+    filter["symbol"] = true;
+    filter["bars"][0]["c"] = true;
+    filter["bars"][0]["t"] = true;
+    filter["bars"][0]["v"] = true;
+    filter["next_page_token"] = true;
+    CompiledFilter<16> compiled(filter);
+    TEST_ASSERT_EQUAL_STRING(filtered(input, Filter(filter)).c_str(),
+                             filtered(input, compiled).c_str());
+
+    using namespace std::chrono;
+    const int runs = 50;
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        JsonDocument doc;
+        deserializeJson(doc, input, Filter(filter));
+    }
+    auto t1 = steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        JsonDocument doc;
+        deserializeJson(doc, input, compiled);
+    }
+    auto t2 = steady_clock::now();
+
+    double plain = duration<double, std::milli>(t1 - t0).count() / runs;
+    double fast = duration<double, std::milli>(t2 - t1).count() / runs;
+    char message[96];
+    snprintf(message, sizeof(message), "%zu bytes: Filter %.3f ms, CompiledFilter %.3f ms (x%.1f)",
+             input.size(), plain, fast, plain / fast);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_null_member_falls_back_to_wildcard);
+    RUN_TEST(test_nested_wildcard_and_arrays);
+    RUN_TEST(test_survives_shrinking_the_filter);
+    RUN_TEST(test_too_small_denies_everything);
+    RUN_TEST(test_random_filters_match_filter);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,153 @@
+// Smooth font glyphs composed a row at a time, against the old renderer that opened
+// a window per anti-aliased pixel and per solid run: same pixels, and what goes over
+// the bus per glyph
+#define SMOOTH_FONT
+#include <host_tft.h>
+#include <unity.h>
+
+#include <stdio.h>
+#include <vector>
+
+#include "examples/Smooth Fonts/FLASH_Array/Font_Demo_1_Array/NotoSansBold36.h"
+#include "examples/Smooth Fonts/FLASH_Array/Font_Demo_1_Array/NotoSansBold15.h"
+
+void setUp() {}
+void tearDown() {}
+
+// drawGlyph() as it was before glyph rows were composed in RAM (array fonts only)
+class LegacyTFT : public TFT_eSPI {
+public:
+    void drawGlyph(uint16_t code) override {
+        uint16_t fg = textcolor;
+        uint16_t bg = textbgcolor;
+        if (last_cursor_x != cursor_x) {
+            bg_cursor_x = cursor_x;
+            last_cursor_x = cursor_x;
+        }
+        uint16_t gNum = 0;
+        if (code < 0x21 || !getUnicodeIndex(code, &gNum)) {
+            TFT_eSPI::drawGlyph(code);
+            return;
+        }
+        const uint8_t* gPtr = gFont.gArray + gBitmap[gNum];
+        if (textwrapX && (cursor_x + gWidth[gNum] + gdX[gNum] > width())) {
+            cursor_y += gFont.yAdvance;
+            cursor_x = 0;
+            bg_cursor_x = 0;
+        }
+        if (textwrapY && ((cursor_y + gFont.yAdvance) >= height())) cursor_y = 0;
+        if (cursor_x == 0) cursor_x -= gdX[gNum];
+        int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
+        int16_t cx = cursor_x + gdX[gNum];
+        int16_t fxs = cx, bxs = cx, bx = 0;
+        uint32_t fl = 0, bl = 0;
+
+        startWrite();
+        int16_t fillwidth = 0;
+        if (_fillbg) {
+            fillwidth = (cursor_x + gxAdvance[gNum]) - bg_cursor_x;
+            if (fillwidth > 0) {
+                int16_t fillheight = gFont.maxAscent - gdY[gNum];
+                if (fillheight > 0) fillRect(bg_cursor_x, cursor_y, fillwidth, fillheight, bg);
+            } else {
+                fillwidth = 0;
+            }
+            if (bg_cursor_x < cx) fillRect(bg_cursor_x, cy, cx - bg_cursor_x, gHeight[gNum], bg);
+            if (bg_cursor_x > cx) bx = bg_cursor_x - cx;
+            if (cx + gWidth[gNum] < cursor_x + gxAdvance[gNum])
+                fillRect(cx + gWidth[gNum], cy, (cursor_x + gxAdvance[gNum]) - (cx + gWidth[gNum]),
+                         gHeight[gNum], bg);
+        }
+        for (int32_t y = 0; y < gHeight[gNum]; y++) {
+            for (int32_t x = 0; x < gWidth[gNum]; x++) {
+                uint8_t pixel = gPtr[x + gWidth[gNum] * y];
+                if (pixel) {
+                    if (bl) { drawFastHLine(bxs, y + cy, bl, bg); bl = 0; }
+                    if (pixel != 0xFF) {
+                        if (fl) { drawFastHLine(fxs, y + cy, fl, fg); fl = 0; }
+                        drawPixel(x + cx, y + cy, alphaBlend(pixel, fg, bg));
+                    } else {
+                        if (fl == 0) fxs = x + cx;
+                        fl++;
+                    }
+                } else {
+                    if (fl) { drawFastHLine(fxs, y + cy, fl, fg); fl = 0; }
+                    if (_fillbg && x >= bx) {
+                        if (bl == 0) bxs = x + cx;
+                        bl++;
+                    }
+                }
+            }
+            if (fl) { drawFastHLine(fxs, y + cy, fl, fg); fl = 0; }
+            if (bl) { drawFastHLine(bxs, y + cy, bl, bg); bl = 0; }
+        }
+        if (fillwidth > 0) {
+            int16_t fillheight = (cursor_y + gFont.yAdvance) - (cy + gHeight[gNum]);
+            if (fillheight > 0) fillRect(bg_cursor_x, cy + gHeight[gNum], fillwidth, fillheight, bg);
+        }
+        cursor_x += gxAdvance[gNum];
+        endWrite();
+        bg_cursor_x = cursor_x;
+        last_cursor_x = cursor_x;
+    }
+};
+
+static const char* text = "Pluto BTC 64,164.89 +0.26%";
+
+struct Run {
+    HostPanel::Stats stats;
+    std::vector<uint16_t> frame;
+};
+
+static Run render(TFT_eSPI& tft, HostPanel& panel, const uint8_t* font, bool fill) {
+    tft.fillScreen(TFT_BLACK);
+    tft.loadFont(font);
+    tft.setTextColor(TFT_WHITE, TFT_NAVY, fill);
+    panel.clearStats();
+    tft.setCursor(4, 40);
+    tft.print(text);
+    Run run{panel.stats, {}};
+    run.frame.assign(&panel.frame[0][0], &panel.frame[0][0] + HostPanel::width * HostPanel::height);
+    tft.unloadFont();
+    return run;
+}
+
+static void compare(const char* name, const uint8_t* font, bool fill, int cut) {
+    HostPanel panel;
+    TFT_eSPI tft;
+    LegacyTFT legacy;
+    tft.init();
+    Run before = render(legacy, panel, font, fill);
+    Run after = render(tft, panel, font, fill);
+    TEST_ASSERT_TRUE_MESSAGE(before.frame == after.frame, name);
+
+    int glyphs = 0;
+    for (const char* c = text; *c; c++) glyphs += *c != ' ';
+    double beforeCommands = double(before.stats.commands) / glyphs;
+    double afterCommands = double(after.stats.commands) / glyphs;
+    TEST_ASSERT_TRUE_MESSAGE(afterCommands * cut <= beforeCommands, name);
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "%s: per glyph %.1f -> %.1f windows, %.0f -> %.0f commands, %.0f -> %.0f bytes", name,
+             double(before.stats.windows) / glyphs, double(after.stats.windows) / glyphs,
+             beforeCommands, afterCommands, double(before.stats.bytes()) / glyphs,
+             double(after.stats.bytes()) / glyphs);
+    TEST_MESSAGE(message);
+}
+
+// Filled text goes out as one window per character cell. Transparent pixels can't
+// be written, so transparent text still needs a window per run of ink.
+static void test_filled_36() { compare("NotoSansBold36 filled", NotoSansBold36, true, 10); }
+static void test_filled_15() { compare("NotoSansBold15 filled", NotoSansBold15, true, 10); }
+static void test_transparent_36() { compare("NotoSansBold36 transparent", NotoSansBold36, false, 2); }
+static void test_transparent_15() { compare("NotoSansBold15 transparent", NotoSansBold15, false, 2); }
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_filled_36);
+    RUN_TEST(test_filled_15);
+    RUN_TEST(test_transparent_36);
+    RUN_TEST(test_transparent_15);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+// Smooth fonts loaded from a file: one read per glyph, the same pixels as the font
+// array, a short read that draws nothing from a half-read bitmap, and an SD card
+// read that gets the SPI bus even inside a startWrite() of the caller
+#define SMOOTH_FONT
+#define FONT_FS_AVAILABLE
+#define SMOOTH_FONT_CACHE_GLYPHS 4
+#include <FS.h>
+#include <host_tft.h>
+#include <unity.h>
+
+#include <stdio.h>
+#include <vector>
+
+#include "examples/Smooth Fonts/FLASH_Array/Font_Demo_1_Array/NotoSansBold36.h"
+
+static const char* path = "/NotoSansBold36.vlw";
+static const char* text = "BTC 64,164.89";
+
+void setUp() {
+    SPIFFS.file(path).assign((const char*)NotoSansBold36, sizeof(NotoSansBold36));
+    host::fileStats = host::FileStats();
+    host::onFileRead = nullptr;
+}
+void tearDown() {}
+
+// Reads glyphs into a single buffer, as when the cache can't be allocated
+static void dropCache(TFT_eSPI& tft) {
+    free(tft.glyphCache);
+    tft.glyphCache = nullptr;
+    tft.glyphBuffer = (uint8_t*)malloc(tft.glyphBufferSize);
+}
+
+static std::vector<uint16_t> frame(const HostPanel& panel) {
+    return std::vector<uint16_t>(&panel.frame[0][0],
+                                 &panel.frame[0][0] + HostPanel::width * HostPanel::height);
+}
+
+static std::vector<uint16_t> render(TFT_eSPI& tft, HostPanel& panel) {
+    tft.fillScreen(TFT_BLACK);
+    tft.setTextColor(TFT_WHITE, TFT_NAVY, true);
+    tft.setCursor(4, 40);
+    tft.print(text);
+    return frame(panel);
+}
+
+// Reads per glyph, against one read per row of the bitmap before
+static void test_one_read_per_glyph() {
+    HostPanel panel;
+    TFT_eSPI tft;
+    tft.init();
+    tft.loadFont(NotoSansBold36);
+    std::vector<uint16_t> fromArray = render(tft, panel);
+
+    tft.loadFont("NotoSansBold36");
+    TEST_ASSERT_TRUE(tft.fontLoaded);
+    int glyphs = 0, rows = 0;
+    for (const char* c = text; *c; c++) {
+        uint16_t gNum;
+        if (*c != ' ' && tft.getUnicodeIndex(*c, &gNum)) {
+            glyphs++;
+            rows += tft.gHeight[gNum];
+        }
+    }
+
+    for (bool cached : {true, false}) {
+        if (!cached) dropCache(tft);
+        host::fileStats = host::FileStats();
+        TEST_ASSERT_TRUE(render(tft, panel) == fromArray);
+        host::FileStats first = host::fileStats;
+        render(tft, panel);
+        uint32_t again = host::fileStats.reads - first.reads;
+        if (!cached) TEST_ASSERT_EQUAL(glyphs, first.reads);
+        TEST_ASSERT_LESS_OR_EQUAL(glyphs, first.reads);
+
+        char message[160];
+        snprintf(message, sizeof(message),
+                 "%s: per glyph %.1f reads (%.1f before), %.0f bytes; %u reads to draw it again",
+                 cached ? "4 cached glyphs" : "no cache", double(first.reads) / glyphs,
+                 double(rows) / glyphs, double(first.bytes) / glyphs, again);
+        TEST_MESSAGE(message);
+    }
+    tft.unloadFont();
+}
+
+static void test_short_read_is_not_used() {
+    TFT_eSPI tft;
+    tft.loadFont("NotoSansBold36");
+    uint16_t gNum;
+    TEST_ASSERT_TRUE(tft.getUnicodeIndex('8', &gNum));
+    uint32_t size = tft.gWidth[gNum] * tft.gHeight[gNum];
+    const uint8_t* bitmap = NotoSansBold36 + tft.gBitmap[gNum];
+
+    for (bool cached : {true, false}) {
+        if (!cached) dropCache(tft);
+        std::string& file = SPIFFS.file(path);
+        std::string whole = file;
+        file.resize(tft.gBitmap[gNum] + size / 2);
+        TEST_ASSERT_NULL(tft.getGlyphBitmap(gNum));
+
+        // Nothing was kept from the failed read
+        file = whole;
+        const uint8_t* read = tft.getGlyphBitmap(gNum);
+        TEST_ASSERT_NOT_NULL(read);
+        TEST_ASSERT_EQUAL_MEMORY(bitmap, read, size);
+    }
+    tft.unloadFont();
+}
+
+static bool readWhileBusHeld;
+
+static void test_sd_read_releases_the_bus() {
+    HostPanel panel;
+    TFT_eSPI tft;
+    tft.init();
+    fs::FS sd;
+    sd.file(path) = SPIFFS.file(path);
+    tft.loadFont("NotoSansBold36", sd);
+    TEST_ASSERT_TRUE(tft.fontLoaded);
+
+    readWhileBusHeld = false;
+    host::onFileRead = [] { readWhileBusHeld |= host::pins[TFT_CS] == LOW; };
+    tft.startWrite();
+    tft.drawString("64,164", 4, 40);
+    tft.endWrite();
+    host::onFileRead = nullptr;
+    TEST_ASSERT_FALSE(readWhileBusHeld);
+    TEST_ASSERT_GREATER_THAN(0, host::fileStats.reads);
+    tft.unloadFont();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_read_per_glyph);
+    RUN_TEST(test_short_read_is_not_used);
+    RUN_TEST(test_sd_read_releases_the_bus);
+    return UNITY_END();
+}
@@ -0,0 +1,197 @@
+// Smooth fonts packed by Tools/Pack_Smooth_Fonts/pack_fonts.py into a data partition:
+// the directory read back, fonts mapped by loadFontPartition() drawing the same pixels
+// as the font arrays, each mapping released, and the failures, including a loadFont()
+// that loads nothing, leaving nothing mapped
+#define SMOOTH_FONT
+#define FONT_PARTITION_AVAILABLE
+#include <esp_partition.h>
+#include <host_tft.h>
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "examples/Smooth Fonts/FLASH_Array/Font_Demo_1_Array/NotoSansBold15.h"
+#include "examples/Smooth Fonts/FLASH_Array/Font_Demo_1_Array/NotoSansBold36.h"
+
+static const char* text = "BTC 64,164.89";
+static const size_t partitionSize = 0x40000;
+static std::string image;
+
+// pio test runs from the project root, a test binary run by hand from its own folder
+static std::string projectPath(const char* path) {
+    return access("platformio.ini", F_OK) == 0 ? path : std::string("../../") + path;
+}
+
+static void writeFile(const std::string& path, const void* data, size_t size) {
+    FILE* f = fopen(path.c_str(), "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(size, fwrite(data, 1, size, f));
+    fclose(f);
+}
+
+static std::string readFile(const std::string& path) {
+    std::string data;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return data;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) data.append(buffer, n);
+    fclose(f);
+    return data;
+}
+
+// Runs pack_fonts.py on the given fonts, returns the image or "" if it failed
+static std::string pack(const std::vector<std::pair<const char*, std::string>>& fonts, size_t size) {
+    char dir[] = "/tmp/font_partitionXXXXXX";
+    TEST_ASSERT_NOT_NULL(mkdtemp(dir));
+    std::string command = "python3 '" +
+        projectPath(".pio/libdeps/esp32dev/TFT_eSPI/Tools/Pack_Smooth_Fonts/pack_fonts.py") + "'";
+    for (auto& font : fonts) {
+        std::string path = std::string(dir) + "/" + font.first + ".vlw";
+        writeFile(path, font.second.data(), font.second.size());
+        command += " " + path;
+    }
+    std::string output = std::string(dir) + "/fonts.bin";
+    command += " -o " + output + " -s " + std::to_string(size) + " > /dev/null 2>&1";
+    std::string packed = system(command.c_str()) == 0 ? readFile(output) : std::string();
+    system(("rm -rf " + std::string(dir)).c_str());
+    return packed;
+}
+
+static std::string font15() { return std::string((const char*)NotoSansBold15, sizeof(NotoSansBold15)); }
+static std::string font36() { return std::string((const char*)NotoSansBold36, sizeof(NotoSansBold36)); }
+
+void setUp() {
+    if (image.empty()) image = pack({{"NotoSansBold15", font15()}, {"NotoSansBold36", font36()}}, partitionSize);
+    host::setPartition("fonts", image);
+    host::mmapFails = false;
+    host::mmapNoData = false;
+}
+void tearDown() {}
+
+template <typename T>
+static T readLE(const std::string& data, size_t offset) {
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) value |= T(uint8_t(data[offset + i])) << (8 * i);
+    return value;
+}
+
+static void test_directory() {
+    TEST_ASSERT_EQUAL_MESSAGE(partitionSize, image.size(), "pack_fonts.py didn't run");
+    TEST_ASSERT_EQUAL_MEMORY("VLWP", image.data(), 4);
+    TEST_ASSERT_EQUAL(1, readLE<uint16_t>(image, 4));
+    TEST_ASSERT_EQUAL(2, readLE<uint16_t>(image, 6));
+
+    const char* names[] = {"NotoSansBold15", "NotoSansBold36"};
+    std::string fonts[] = {font15(), font36()};
+    size_t end = 8 + 2 * 32;
+    for (int i = 0; i < 2; i++) {
+        size_t entry = 8 + i * 32;
+        TEST_ASSERT_EQUAL_STRING(names[i], image.c_str() + entry);  // Zero padded to 24 bytes
+        uint32_t offset = readLE<uint32_t>(image, entry + 24);
+        uint32_t size = readLE<uint32_t>(image, entry + 28);
+        TEST_ASSERT_EQUAL(0, offset % 4);
+        TEST_ASSERT_GREATER_OR_EQUAL(end, offset);
+        TEST_ASSERT_EQUAL(fonts[i].size(), size);
+        TEST_ASSERT_TRUE(image.compare(offset, size, fonts[i]) == 0);
+        end = offset + size;
+    }
+    // The rest is erased flash
+    TEST_ASSERT_EQUAL(std::string::npos, image.find_first_not_of('\xff', end));
+}
+
+// A font that doesn't hold its glyphs, or an image larger than the partition, isn't packed
+static void test_pack_refuses() {
+    TEST_ASSERT_TRUE(pack({{"Short", font15().substr(0, 200)}}, partitionSize).empty());
+    TEST_ASSERT_TRUE(pack({{"NotoSansBold36", font36()}}, 0x1000).empty());
+    TEST_ASSERT_TRUE(pack({{"AFontNameLongerThan23Chars", font15()}}, partitionSize).empty());
+}
+
+static std::vector<uint16_t> render(TFT_eSPI& tft, HostPanel& panel) {
+    tft.fillScreen(TFT_BLACK);
+    tft.setTextColor(TFT_WHITE, TFT_NAVY, true);
+    tft.setCursor(4, 40);
+    tft.print(text);
+    return std::vector<uint16_t>(&panel.frame[0][0],
+                                 &panel.frame[0][0] + HostPanel::width * HostPanel::height);
+}
+
+static void test_mapped_fonts_draw_like_arrays() {
+    HostPanel panel;
+    TFT_eSPI tft;
+    tft.init();
+
+    const uint8_t* arrays[] = {NotoSansBold15, NotoSansBold36};
+    const char* names[] = {"NotoSansBold15", "NotoSansBold36"};
+    for (int i = 0; i < 2; i++) {
+        tft.loadFont(arrays[i]);
+        std::vector<uint16_t> fromArray = render(tft, panel);
+
+        TEST_ASSERT_TRUE(tft.loadFontPartition(names[i]));
+        TEST_ASSERT_TRUE(tft.fontLoaded);
+        TEST_ASSERT_TRUE(tft.fontMapped);
+        // The glyphs are read in place, from the partition
+        TEST_ASSERT_TRUE(tft.gFont.gArray >= (const uint8_t*)host::partition.data.data() &&
+                         tft.gFont.gArray < (const uint8_t*)host::partition.data.data() + partitionSize);
+        TEST_ASSERT_EQUAL(1, host::mappings);
+        TEST_ASSERT_TRUE(fromArray == render(tft, panel));
+    }
+
+    // Loading another font, or unloading, releases the mapping
+    TEST_ASSERT_TRUE(tft.loadFontPartition("NotoSansBold15"));
+    TEST_ASSERT_EQUAL(1, host::mappings);
+    tft.loadFont(NotoSansBold36);
+    TEST_ASSERT_EQUAL(0, host::mappings);
+    TEST_ASSERT_FALSE(tft.fontMapped);
+    TEST_ASSERT_TRUE(tft.loadFontPartition("NotoSansBold36"));
+    tft.unloadFont();
+    TEST_ASSERT_EQUAL(0, host::mappings);
+}
+
+static void test_failures_leave_nothing_mapped() {
+    HostPanel panel;
+    TFT_eSPI tft;
+    tft.init();
+
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold20"));
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold"));
+    TEST_ASSERT_FALSE(tft.loadFontPartition("AFontNameLongerThan23Chars"));
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold15", "spiffs"));
+
+    host::mmapFails = true;
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold15"));
+    TEST_ASSERT_FALSE(tft.fontLoaded);
+    host::mmapFails = false;
+
+    // Mapped, but loadFont() loads nothing: the mapping goes at once
+    host::mmapNoData = true;
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold15"));
+    TEST_ASSERT_FALSE(tft.fontLoaded);
+    TEST_ASSERT_FALSE(tft.fontMapped);
+    TEST_ASSERT_EQUAL(0, host::mappings);
+    host::mmapNoData = false;
+
+    // Not a packed image
+    std::string erased(partitionSize, '\xff');
+    host::setPartition("fonts", erased);
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold15"));
+
+    // An entry that runs past the end of the partition
+    std::string cut = image.substr(0, 8 + 2 * 32 + 100);
+    host::setPartition("fonts", cut);
+    TEST_ASSERT_FALSE(tft.loadFontPartition("NotoSansBold36"));
+    TEST_ASSERT_EQUAL(0, host::mappings);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_directory);
+    RUN_TEST(test_pack_refuses);
+    RUN_TEST(test_mapped_fonts_draw_like_arrays);
+    RUN_TEST(test_failures_leave_nothing_mapped);
+    return UNITY_END();
+}
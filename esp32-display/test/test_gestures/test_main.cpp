@@ -0,0 +1,337 @@
+// TFT_eSPI_Gesture fed synthetic touch event streams: taps, long presses, swipes, slow
+// drags and diagonals, buttons pressed and released, and hit tests on overlapping and
+// partly off screen widgets checked against a scan of every widget
+#define GESTURE_MAX_WIDGETS 32
+#include <host_tft.h>
+#include <unity.h>
+
+#include <stdlib.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static const int16_t width = 240, height = 320;
+
+struct Point {
+    int16_t x, y;
+};
+
+// A touch from the first point to the last, one event every step ms from time t,
+// returns the gestures it completed. Long presses are polled between events.
+static std::vector<gesture_t> touch(TFT_eSPI_Gesture& gestures, const std::vector<Point>& path,
+                                    uint32_t t, uint32_t step = 10) {
+    std::vector<gesture_t> done;
+    gesture_t g;
+    for (size_t i = 0; i < path.size(); i++) {
+        uint8_t type = i == 0 ? TOUCH_EVENT_DOWN
+                     : i == path.size() - 1 ? TOUCH_EVENT_UP : TOUCH_EVENT_MOVE;
+        touch_event_t e = {type, uint16_t(path[i].x), uint16_t(path[i].y), t + uint32_t(i) * step};
+        if (i > 0 && gestures.poll(e.time, &g)) done.push_back(g);
+        if (gestures.handleEvent(&e, &g)) done.push_back(g);
+    }
+    return done;
+}
+
+// A straight line of n + 1 points
+static std::vector<Point> line(Point from, int16_t dx, int16_t dy, int n = 6) {
+    std::vector<Point> path;
+    for (int i = 0; i <= n; i++) path.push_back({int16_t(from.x + dx * i / n), int16_t(from.y + dy * i / n)});
+    return path;
+}
+
+static void test_tap() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    TEST_ASSERT_EQUAL(0, gestures.addArea(20, 20, 80, 40));
+
+    // Jitter inside the slop is still a tap
+    std::vector<gesture_t> g = touch(gestures, {{50, 30}, {55, 33}, {45, 38}, {58, 26}}, 1000);
+    TEST_ASSERT_EQUAL(1, g.size());
+    TEST_ASSERT_EQUAL(GESTURE_TAP, g[0].type);
+    TEST_ASSERT_EQUAL(0, g[0].widget);
+    TEST_ASSERT_EQUAL(50, g[0].x);
+    TEST_ASSERT_EQUAL(30, g[0].y);
+    TEST_ASSERT_EQUAL(8, g[0].dx);
+    TEST_ASSERT_EQUAL(-4, g[0].dy);
+    TEST_ASSERT_EQUAL(1030, g[0].time);
+
+    // Outside every widget, and a tap as short as one down and one up
+    g = touch(gestures, {{200, 200}, {200, 201}}, 2000);
+    TEST_ASSERT_EQUAL(1, g.size());
+    TEST_ASSERT_EQUAL(GESTURE_TAP, g[0].type);
+    TEST_ASSERT_EQUAL(-1, g[0].widget);
+
+    // An up or a move without a down is ignored
+    gesture_t none;
+    touch_event_t up = {TOUCH_EVENT_UP, 50, 30, 3000};
+    TEST_ASSERT_FALSE(gestures.handleEvent(&up, &none));
+    touch_event_t move = {TOUCH_EVENT_MOVE, 50, 30, 3000};
+    TEST_ASSERT_FALSE(gestures.handleEvent(&move, &none));
+}
+
+static void test_long_press() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    gestures.addArea(0, 0, width, height);
+
+    gesture_t g;
+    touch_event_t down = {TOUCH_EVENT_DOWN, 120, 160, 5000};
+    gestures.handleEvent(&down, &g);
+    TEST_ASSERT_FALSE(gestures.poll(5000 + GESTURE_LONG_PRESS_MS - 1, &g));
+    TEST_ASSERT_TRUE(gestures.poll(5000 + GESTURE_LONG_PRESS_MS, &g));
+    TEST_ASSERT_EQUAL(GESTURE_LONG_PRESS, g.type);
+    TEST_ASSERT_EQUAL(0, g.widget);
+    TEST_ASSERT_EQUAL(5000 + GESTURE_LONG_PRESS_MS, g.time);
+    // Reported once, and the up isn't a tap as well
+    TEST_ASSERT_FALSE(gestures.poll(7000, &g));
+    touch_event_t up = {TOUCH_EVENT_UP, 122, 158, 7100};
+    TEST_ASSERT_FALSE(gestures.handleEvent(&up, &g));
+    TEST_ASSERT_FALSE(gestures.poll(8000, &g));
+
+    // Held with a little jitter, through the event stream
+    std::vector<Point> held(80, Point{60, 60});
+    held[40] = {66, 55};
+    std::vector<gesture_t> done = touch(gestures, held, 10000);
+    TEST_ASSERT_EQUAL(1, done.size());
+    TEST_ASSERT_EQUAL(GESTURE_LONG_PRESS, done[0].type);
+
+    // Moving away first makes it no press at all
+    std::vector<Point> moved = line({60, 60}, 30, 0);
+    moved.insert(moved.end(), 80, Point{90, 60});
+    TEST_ASSERT_EQUAL(0, touch(gestures, moved, 20000).size());
+}
+
+static void test_swipes() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    const struct {
+        int16_t dx, dy;
+        uint8_t type;
+    } swipes[] = {
+        {-80, 5, GESTURE_SWIPE_LEFT},
+        {80, -5, GESTURE_SWIPE_RIGHT},
+        {10, -100, GESTURE_SWIPE_UP},
+        {-10, 100, GESTURE_SWIPE_DOWN},
+        {GESTURE_SWIPE_MIN, 0, GESTURE_SWIPE_RIGHT},
+        {0, -GESTURE_SWIPE_MIN, GESTURE_SWIPE_UP},
+    };
+    uint32_t t = 0;
+    for (auto& swipe : swipes) {
+        std::vector<gesture_t> g = touch(gestures, line({120, 160}, swipe.dx, swipe.dy), t += 1000);
+        TEST_ASSERT_EQUAL(1, g.size());
+        TEST_ASSERT_EQUAL(swipe.type, g[0].type);
+        TEST_ASSERT_EQUAL(swipe.dx, g[0].dx);
+        TEST_ASSERT_EQUAL(swipe.dy, g[0].dy);
+        TEST_ASSERT_EQUAL(120, g[0].x);
+    }
+
+    // Too short: beyond the slop, so not a tap either
+    TEST_ASSERT_EQUAL(0, touch(gestures, line({120, 160}, GESTURE_SWIPE_MIN - 1, 0), t += 1000).size());
+    TEST_ASSERT_EQUAL(0, touch(gestures, line({120, 160}, 0, 1 - GESTURE_SWIPE_MIN), t += 1000).size());
+
+    // Out and back: the up point counts, not the way there
+    std::vector<Point> back = line({120, 160}, 80, 0);
+    back.push_back({125, 160});
+    TEST_ASSERT_EQUAL(0, touch(gestures, back, t += 1000).size());
+}
+
+// The same travel as a swipe, too slow
+static void test_slow_drag() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    // 6 steps of 140 ms: 840 ms
+    TEST_ASSERT_EQUAL(0, touch(gestures, line({200, 100}, -120, 0), 1000, 140).size());
+    // 6 steps of 130 ms: 780 ms, still a swipe
+    std::vector<gesture_t> g = touch(gestures, line({200, 100}, -120, 0), 3000, 130);
+    TEST_ASSERT_EQUAL(1, g.size());
+    TEST_ASSERT_EQUAL(GESTURE_SWIPE_LEFT, g[0].type);
+    // Slow with pauses, and no long press while it moves
+    std::vector<Point> path = line({20, 20}, 0, 200, 20);
+    TEST_ASSERT_EQUAL(0, touch(gestures, path, 6000, 100).size());
+}
+
+// A swipe must travel more than twice as far along its axis as across it
+static void test_diagonal() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    uint32_t t = 0;
+    TEST_ASSERT_EQUAL(0, touch(gestures, line({60, 60}, 80, 80), t += 1000).size());
+    TEST_ASSERT_EQUAL(0, touch(gestures, line({60, 60}, 60, 30), t += 1000).size());
+    TEST_ASSERT_EQUAL(0, touch(gestures, line({60, 200}, -30, -60), t += 1000).size());
+    std::vector<gesture_t> g = touch(gestures, line({60, 60}, 60, 29), t += 1000);
+    TEST_ASSERT_EQUAL(1, g.size());
+    TEST_ASSERT_EQUAL(GESTURE_SWIPE_RIGHT, g[0].type);
+    g = touch(gestures, line({160, 260}, -29, -60), t += 1000);
+    TEST_ASSERT_EQUAL(1, g.size());
+    TEST_ASSERT_EQUAL(GESTURE_SWIPE_UP, g[0].type);
+}
+
+// Buttons are pressed while the touch is on them and flagged for redrawing on change
+static void test_buttons() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    TFT_eSPI_Button ok, cancel;
+    char okLabel[] = "OK", cancelLabel[] = "Cancel";
+    ok.initButtonUL(nullptr, 20, 260, 90, 40, TFT_WHITE, TFT_BLUE, TFT_WHITE, okLabel, 1);
+    cancel.initButtonUL(nullptr, 130, 260, 90, 40, TFT_WHITE, TFT_RED, TFT_WHITE, cancelLabel, 1);
+    TEST_ASSERT_EQUAL(0, gestures.addButton(&ok));
+    TEST_ASSERT_EQUAL(1, gestures.addButton(&cancel));
+    // Both are drawn first
+    TEST_ASSERT_EQUAL(0, gestures.nextDirty());
+    TEST_ASSERT_EQUAL(1, gestures.nextDirty());
+    TEST_ASSERT_EQUAL(-1, gestures.nextDirty());
+
+    gesture_t g;
+    touch_event_t down = {TOUCH_EVENT_DOWN, 60, 280, 100};
+    gestures.handleEvent(&down, &g);
+    TEST_ASSERT_TRUE(ok.isPressed());
+    TEST_ASSERT_FALSE(cancel.isPressed());
+    TEST_ASSERT_EQUAL(0, gestures.nextDirty());
+    TEST_ASSERT_EQUAL(-1, gestures.nextDirty());
+    touch_event_t up = {TOUCH_EVENT_UP, 62, 281, 180};
+    TEST_ASSERT_TRUE(gestures.handleEvent(&up, &g));
+    TEST_ASSERT_EQUAL(GESTURE_TAP, g.type);
+    TEST_ASSERT_EQUAL(0, g.widget);
+    TEST_ASSERT_FALSE(ok.isPressed());
+    TEST_ASSERT_EQUAL(0, gestures.nextDirty());
+
+    // Sliding off releases the button, and onto another doesn't press that one
+    std::vector<gesture_t> done = touch(gestures, line({60, 280}, 120, 0), 1000, 200);
+    TEST_ASSERT_EQUAL(0, done.size());
+    TEST_ASSERT_FALSE(ok.isPressed());
+    TEST_ASSERT_FALSE(cancel.isPressed());
+    TEST_ASSERT_EQUAL(0, gestures.nextDirty());
+    TEST_ASSERT_EQUAL(-1, gestures.nextDirty());
+}
+
+// Index of the top widget containing the point, from the rectangles alone
+struct Rect {
+    int16_t x, y;
+    uint16_t w, h;
+};
+
+static int8_t scan(const std::vector<Rect>& rects, int16_t x, int16_t y) {
+    for (int i = int(rects.size()) - 1; i >= 0; i--) {
+        const Rect& r = rects[i];
+        if (x >= r.x && x < r.x + r.w && y >= r.y && y < r.y + r.h) return i;
+    }
+    return -1;
+}
+
+static void checkEveryPixel(TFT_eSPI_Gesture& gestures, const std::vector<Rect>& rects) {
+    for (int16_t y = 0; y < height; y++) {
+        for (int16_t x = 0; x < width; x++) {
+            int8_t expected = scan(rects, x, y);
+            if (gestures.hitTest(x, y) != expected) {
+                char message[64];
+                snprintf(message, sizeof(message), "at %d,%d", x, y);
+                TEST_ASSERT_EQUAL_MESSAGE(expected, gestures.hitTest(x, y), message);
+            }
+        }
+    }
+}
+
+// Cells covered by more than one widget (GESTURE_SHARED_CELL) check every widget
+static void test_overlapping_widgets() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    std::vector<Rect> rects = {{0, 0, 100, 100}, {50, 50, 100, 100}, {20, 20, 10, 10}, {24, 0, 8, 8}};
+    for (const Rect& r : rects) gestures.addArea(r.x, r.y, r.w, r.h);
+
+    TEST_ASSERT_EQUAL(1, gestures.hitTest(75, 75));   // Both, the later one is on top
+    TEST_ASSERT_EQUAL(0, gestures.hitTest(49, 49));   // In a shared cell, only under the first
+    TEST_ASSERT_EQUAL(1, gestures.hitTest(120, 120)); // Only the second
+    TEST_ASSERT_EQUAL(2, gestures.hitTest(25, 25));   // On top of the first
+    TEST_ASSERT_EQUAL(3, gestures.hitTest(24, 0));
+    TEST_ASSERT_EQUAL(0, gestures.hitTest(20, 10));   // In a shared cell, between them
+    TEST_ASSERT_EQUAL(-1, gestures.hitTest(160, 160));
+    checkEveryPixel(gestures, rects);
+
+    // A tap reports the widget on top
+    std::vector<gesture_t> g = touch(gestures, {{75, 75}, {76, 75}}, 0);
+    TEST_ASSERT_EQUAL(1, g[0].widget);
+}
+
+static void test_partly_off_screen() {
+    TFT_eSPI_Gesture gestures;
+    gestures.begin(width, height);
+    std::vector<Rect> rects = {
+        {-30000, -30000, 60000, 60000},  // Covers everything, under the others
+        {-20, -20, 40, 40},       // Top left corner
+        {230, 310, 40, 40},       // Bottom right corner
+        {-100, 100, 110, 20},     // Left edge
+        {100, -50, 20, 60},       // Top edge
+        {300, 0, 10, 10},         // Off screen
+        {-50, 0, 50, 50},         // Ends just left of the screen
+        {0, 320, 240, 10},        // Starts just below it
+    };
+    for (const Rect& r : rects) gestures.addArea(r.x, r.y, r.w, r.h);
+
+    TEST_ASSERT_EQUAL(1, gestures.hitTest(0, 0));
+    TEST_ASSERT_EQUAL(1, gestures.hitTest(19, 19));
+    TEST_ASSERT_EQUAL(2, gestures.hitTest(239, 319));
+    TEST_ASSERT_EQUAL(3, gestures.hitTest(9, 110));
+    TEST_ASSERT_EQUAL(0, gestures.hitTest(10, 110));
+    TEST_ASSERT_EQUAL(4, gestures.hitTest(110, 9));
+    TEST_ASSERT_EQUAL(0, gestures.hitTest(120, 200));
+    TEST_ASSERT_EQUAL(0, gestures.hitTest(0, 50));
+    // Points off screen hit nothing
+    TEST_ASSERT_EQUAL(-1, gestures.hitTest(-1, 0));
+    TEST_ASSERT_EQUAL(-1, gestures.hitTest(0, height));
+    TEST_ASSERT_EQUAL(-1, gestures.hitTest(width, 0));
+    checkEveryPixel(gestures, rects);
+
+    // Without the one under them, the rest of the screen is empty
+    rects.erase(rects.begin());
+    gestures.clearWidgets();
+    for (const Rect& r : rects) gestures.addArea(r.x, r.y, r.w, r.h);
+    TEST_ASSERT_EQUAL(-1, gestures.hitTest(0, 319));
+    TEST_ASSERT_EQUAL(-1, gestures.hitTest(239, 0));
+    checkEveryPixel(gestures, rects);
+}
+
+// Random widgets, up to GESTURE_MAX_WIDGETS, with and without the grid
+static void test_matches_a_scan() {
+    srand(7);
+    for (int round = 0; round < 20; round++) {
+        TFT_eSPI_Gesture gestures;
+        gestures.begin(width, height);
+        std::vector<Rect> rects;
+        int n = 1 + rand() % GESTURE_MAX_WIDGETS;
+        for (int i = 0; i < n; i++) {
+            Rect r = {int16_t(rand() % 320 - 60), int16_t(rand() % 400 - 60),
+                      uint16_t(rand() % 120), uint16_t(rand() % 120)};
+            if (round % 4 == 0) r.w = r.h = 1 + rand() % 20;  // Small, many share a cell
+            rects.push_back(r);
+            TEST_ASSERT_EQUAL(i, gestures.addArea(r.x, r.y, r.w, r.h));
+        }
+        checkEveryPixel(gestures, rects);
+
+        if (n == GESTURE_MAX_WIDGETS) TEST_ASSERT_EQUAL(-1, gestures.addArea(0, 0, 10, 10));
+
+        // The grid sized again is filled from the same widgets
+        gestures.begin(width, height);
+        checkEveryPixel(gestures, rects);
+    }
+
+    // Without begin() every hit test is a scan
+    TFT_eSPI_Gesture gestures;
+    std::vector<Rect> rects = {{0, 0, 100, 100}, {50, 50, 100, 100}, {-10, 200, 30, 30}};
+    for (const Rect& r : rects) gestures.addArea(r.x, r.y, r.w, r.h);
+    checkEveryPixel(gestures, rects);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tap);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_swipes);
+    RUN_TEST(test_slow_drag);
+    RUN_TEST(test_diagonal);
+    RUN_TEST(test_buttons);
+    RUN_TEST(test_overlapping_widgets);
+    RUN_TEST(test_partly_off_screen);
+    RUN_TEST(test_matches_a_scan);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+// deserializeJsonInSitu(): escapes unescaped in place, empty strings, single-quoted and
+// unquoted keys, a sized buffer with bytes after it, no string copied, and the debug
+// check that fires when the buffer changes under the document
+#define ARDUINOJSON_DEBUG 1
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+void setUp() {}
+void tearDown() {}
+
+static bool inBuffer(const char* s, const char* buffer, size_t size) {
+    return s >= buffer && s < buffer + size;
+}
+
+static void test_escapes_shrink_in_place() {
+    char input[] = "{\"a\":\"x\\ny\\t\\\"z\\\"\",\"b\":\"\\u00e9\\u20AC\",\"c\\/d\":\"\\\\\"}";
+    JsonDocument doc;
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      deserializeJsonInSitu(doc, input).code());
+    TEST_ASSERT_EQUAL_STRING("x\ny\t\"z\"", doc["a"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("\xC3\xA9\xE2\x82\xAC", doc["b"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("\\", doc["c/d"].as<const char*>());
+
+    // Keys and values point into the buffer, nothing was copied
+    for (JsonPair member : doc.as<JsonObject>()) {
+        TEST_ASSERT_TRUE(inBuffer(member.key().c_str(), input, sizeof(input)));
+        TEST_ASSERT_TRUE(inBuffer(member.value().as<const char*>(), input, sizeof(input)));
+    }
+    TEST_ASSERT_EQUAL(0, doc.memoryReport().strings);
+}
+
+static void test_empty_strings() {
+    char input[] = "{\"\":\"\",\"e\":[\"\",\"\",\"x\"],\"f\":\"\"}";
+    JsonDocument doc;
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      deserializeJsonInSitu(doc, input).code());
+    TEST_ASSERT_EQUAL(3, doc.size());
+    TEST_ASSERT_EQUAL_STRING("", doc[""].as<const char*>());
+    TEST_ASSERT_EQUAL(3, doc["e"].size());
+    TEST_ASSERT_EQUAL_STRING("", doc["e"][0].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("", doc["e"][1].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("x", doc["e"][2].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("", doc["f"].as<const char*>());
+    TEST_ASSERT_EQUAL(0, doc.memoryReport().strings);
+}
+
+static void test_single_quoted_and_unquoted_keys() {
+    char input[] = "{'single':'it''s',unquoted:1,_under_score:'\\u0041',key_2:[true]}";
+    JsonDocument doc;
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      deserializeJsonInSitu(doc, input).code());
+
+    char valid[] = "{'single':'v\\'w',unquoted:1,_under_score:'\\u0041',key_2:[true]}";
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      deserializeJsonInSitu(doc, valid).code());
+    TEST_ASSERT_EQUAL_STRING("v'w", doc["single"].as<const char*>());
+    TEST_ASSERT_EQUAL(1, doc["unquoted"].as<int>());
+    TEST_ASSERT_EQUAL_STRING("A", doc["_under_score"].as<const char*>());
+    TEST_ASSERT_TRUE(doc["key_2"][0].as<bool>());
+    TEST_ASSERT_TRUE(inBuffer(doc.as<JsonObject>().begin()->key().c_str(), valid,
+                              sizeof(valid)));
+}
+
+// Parsing stops at the size, the bytes after it stay as they were, and the buffer
+// needs no terminator
+static void test_sized_buffer_with_trailing_bytes() {
+    char input[] = "[\"a\\nb\",{\"k\":\"v\"}]TRAILING\"\\n";
+    const size_t size = strlen("[\"a\\nb\",{\"k\":\"v\"}]");
+    JsonDocument doc;
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      deserializeJsonInSitu(doc, input, size).code());
+    TEST_ASSERT_EQUAL_STRING("a\nb", doc[0].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("v", doc[1]["k"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("TRAILING\"\\n", input + size);
+
+    char unterminated[3] = {'"', 'a', '"'};
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      deserializeJsonInSitu(doc, unterminated, sizeof(unterminated)).code());
+    TEST_ASSERT_EQUAL_STRING("a", doc.as<const char*>());
+
+    // Cut inside a string or an escape
+    char cut[] = "[\"abc\\u00e9\"]";
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput,
+                      deserializeJsonInSitu(doc, cut, 4).code());
+    char cutEscape[] = "[\"abc\\u00e9\"]";
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput,
+                      deserializeJsonInSitu(doc, cutEscape, 9).code());
+}
+
+// Runs the steps in a child process and returns true if it aborted
+template <typename TSteps>
+static bool aborts(TSteps steps) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Keep the assertion message out of the test output
+        freopen("/dev/null", "w", stderr);
+        steps();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+static void test_debug_check_fires_when_the_buffer_changes() {
+    // Untouched, the document can be cleared and destroyed
+    TEST_ASSERT_FALSE(aborts([] {
+        char input[] = "{\"a\":\"b\"}";
+        JsonDocument doc;
+        deserializeJsonInSitu(doc, input);
+        doc.clear();
+    }));
+
+    // Modified, then cleared or destroyed
+    TEST_ASSERT_TRUE(aborts([] {
+        char input[] = "{\"a\":\"b\"}";
+        JsonDocument doc;
+        deserializeJsonInSitu(doc, input);
+        input[1] = 'X';
+        doc.clear();
+    }));
+    TEST_ASSERT_TRUE(aborts([] {
+        char input[] = "{\"a\":\"b\"}";
+        {
+            JsonDocument doc;
+            deserializeJsonInSitu(doc, input);
+            strcpy(input, "{}");
+        }
+    }));
+
+    // Parsing the next message into the same buffer drops the old strings first
+    TEST_ASSERT_FALSE(aborts([] {
+        char input[32] = "{\"a\":\"b\"}";
+        JsonDocument doc;
+        deserializeJsonInSitu(doc, input);
+        strcpy(input, "{\"c\":\"d\"}");
+        deserializeJsonInSitu(doc, input);
+        TEST_ASSERT_EQUAL_STRING("d", doc["c"].as<const char*>());
+    }));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_escapes_shrink_in_place);
+    RUN_TEST(test_empty_strings);
+    RUN_TEST(test_single_quoted_and_unquoted_keys);
+    RUN_TEST(test_sized_buffer_with_trailing_bytes);
+    RUN_TEST(test_debug_check_fires_when_the_buffer_changes);
+    return UNITY_END();
+}
@@ -0,0 +1,148 @@
+// JsonDocument::memoryReport(): under each pool policy, the fields add up to what the
+// allocator has handed out and not taken back, through strings, 64-bit numbers,
+// packed arrays, both indexes, removals, shrinkToFit() and clear()
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+void setUp() {}
+void tearDown() {}
+
+// Keeps the size of every block it hands out
+class CountingAllocator : public Allocator {
+ public:
+    size_t live = 0;
+
+    void* allocate(size_t size) override {
+        void* p = malloc(size);
+        if (p) {
+            blocks_[p] = size;
+            live += size;
+        }
+        return p;
+    }
+
+    void deallocate(void* p) override {
+        live -= blocks_[p];
+        blocks_.erase(p);
+        free(p);
+    }
+
+    void* reallocate(void* p, size_t size) override {
+        size_t old = blocks_[p];
+        void* q = realloc(p, size);
+        if (q) {
+            blocks_.erase(p);
+            blocks_[q] = size;
+            live = live - old + size;
+        }
+        return q;
+    }
+
+ private:
+    std::map<void*, size_t> blocks_;
+};
+
+static void checkReport(const JsonDocument& doc, const CountingAllocator& allocator,
+                        const char* step) {
+    MemoryReport report = doc.memoryReport();
+    if (report.total() != allocator.live) {
+        char message[160];
+        snprintf(message, sizeof(message),
+                 "%s: %u variants + %u extensions + %u strings + %u free + %u overhead "
+                 "!= %u allocated",
+                 step, unsigned(report.variants), unsigned(report.extensions),
+                 unsigned(report.strings), unsigned(report.freeSlots),
+                 unsigned(report.overhead), unsigned(allocator.live));
+        TEST_FAIL_MESSAGE(message);
+    }
+}
+
+static void fillAndCheck(PoolPolicy policy) {
+    CountingAllocator allocator;
+    {
+        JsonDocument doc(policy, &allocator);
+        checkReport(doc, allocator, "empty");
+
+        // Strings, 64-bit numbers and nested values
+        doc["name"] = std::string("telemetry");
+        doc["big"] = 0x123456789ALL;
+        doc["ratio"] = 1.000000000001;
+        JsonObject nested = doc["nested"].to<JsonObject>();
+        for (int i = 0; i < 20; i++) nested[std::string("member_") + std::to_string(i)] = i;
+        checkReport(doc, allocator, "members");
+        TEST_ASSERT_NOT_EQUAL(0, doc.memoryReport().strings);
+        TEST_ASSERT_NOT_EQUAL(0, doc.memoryReport().variants);
+#if ARDUINOJSON_USE_LONG_LONG
+        TEST_ASSERT_NOT_EQUAL(0, doc.memoryReport().extensions);
+#endif
+
+        // The array index and the object index count as overhead
+        JsonArray array = doc["array"].to<JsonArray>();
+        for (int i = 0; i < 40; i++) array.add(i);
+        size_t overhead = doc.memoryReport().overhead;
+        TEST_ASSERT_TRUE(array.buildIndex());
+        checkReport(doc, allocator, "array index");
+        TEST_ASSERT_GREATER_THAN(overhead, doc.memoryReport().overhead);
+        overhead = doc.memoryReport().overhead;
+        TEST_ASSERT_TRUE(nested.buildIndex());
+        checkReport(doc, allocator, "object index");
+        TEST_ASSERT_GREATER_THAN(overhead, doc.memoryReport().overhead);
+
+        // A packed array is one string
+        JsonDocument packed(policy, &allocator);
+        deserializeJson(packed, "[0.5,1.5,2.5,3.5,4.5,5.5]");
+        TEST_ASSERT_FALSE(packed.as<JsonSpan<float>>().isNull());
+        TEST_ASSERT_TRUE(doc["packed"].set(packed.as<JsonVariantConst>()));
+        packed.clear();
+        packed.shrinkToFit();
+        TEST_ASSERT_EQUAL(0, packed.memoryReport().total());
+        checkReport(doc, allocator, "packed");
+
+        // Removed values become free slots until something takes them back
+        for (int i = 0; i < 10; i++) nested.remove(std::string("member_") + std::to_string(i));
+        array.remove(0);
+        doc.remove("big");
+        checkReport(doc, allocator, "removed");
+        TEST_ASSERT_NOT_EQUAL(0, doc.memoryReport().freeSlots);
+
+        doc.shrinkToFit();
+        checkReport(doc, allocator, "shrinkToFit");
+
+        doc.clear();
+        checkReport(doc, allocator, "clear");
+        TEST_ASSERT_EQUAL(0, doc.memoryReport().variants);
+        TEST_ASSERT_EQUAL(0, doc.memoryReport().strings);
+
+        // Parsing into a cleared document
+        deserializeJson(doc, "{\"a\":[1,2,{\"b\":\"text\"}],\"c\":12345678901234}");
+        checkReport(doc, allocator, "parsed");
+    }
+    TEST_ASSERT_EQUAL(0, allocator.live);
+}
+
+static void test_default_policy() {
+    fillAndCheck(PoolPolicy());
+}
+
+static void test_fixed_policy() {
+    fillAndCheck(PoolPolicy::fixed(4));
+    fillAndCheck(PoolPolicy::fixed(1));
+}
+
+static void test_geometric_policy() {
+    fillAndCheck(PoolPolicy::geometric(2));
+    fillAndCheck(PoolPolicy::geometric(ARDUINOJSON_POOL_CAPACITY));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_policy);
+    RUN_TEST(test_fixed_policy);
+    RUN_TEST(test_geometric_policy);
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+// mergePatch(): the examples of RFC 7396 appendix A, the paths it reports with '~' and
+// '/' escaped, null removing members, packed arrays compared and replaced without
+// unpacking, a change too deep for ARDUINOJSON_PATCH_PATH_SIZE reported at an
+// ancestor, and a failed allocation
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+struct Result {
+    bool ok;
+    std::string json;
+    std::vector<std::string> paths;
+};
+
+static Result apply(JsonDocument& target, const char* patchJson) {
+    JsonDocument patch;
+    TEST_ASSERT_FALSE(deserializeJson(patch, patchJson));
+    Result result;
+    result.ok = mergePatch(target, patch,
+                           [&](const char* path) { result.paths.push_back(path); });
+    serializeJson(target, result.json);
+    return result;
+}
+
+static Result apply(const char* targetJson, const char* patchJson) {
+    JsonDocument target;
+    TEST_ASSERT_FALSE(deserializeJson(target, targetJson));
+    return apply(target, patchJson);
+}
+
+static void test_rfc7396_examples() {
+    static const char* examples[][3] = {
+        {"{\"a\":\"b\"}", "{\"a\":\"c\"}", "{\"a\":\"c\"}"},
+        {"{\"a\":\"b\"}", "{\"b\":\"c\"}", "{\"a\":\"b\",\"b\":\"c\"}"},
+        {"{\"a\":\"b\"}", "{\"a\":null}", "{}"},
+        {"{\"a\":\"b\",\"b\":\"c\"}", "{\"a\":null}", "{\"b\":\"c\"}"},
+        {"{\"a\":[\"b\"]}", "{\"a\":\"c\"}", "{\"a\":\"c\"}"},
+        {"{\"a\":\"c\"}", "{\"a\":[\"b\"]}", "{\"a\":[\"b\"]}"},
+        {"{\"a\":{\"b\":\"c\"}}", "{\"a\":{\"b\":\"d\",\"c\":null}}", "{\"a\":{\"b\":\"d\"}}"},
+        {"{\"a\":[{\"b\":\"c\"}]}", "{\"a\":[1]}", "{\"a\":[1]}"},
+        {"[\"a\",\"b\"]", "[\"c\",\"d\"]", "[\"c\",\"d\"]"},
+        {"{\"a\":\"b\"}", "[\"c\"]", "[\"c\"]"},
+        {"{\"a\":\"foo\"}", "null", "null"},
+        {"{\"a\":\"foo\"}", "\"bar\"", "\"bar\""},
+        {"{\"e\":null}", "{\"a\":1}", "{\"e\":null,\"a\":1}"},
+        {"[1,2]", "{\"a\":\"b\",\"c\":null}", "{\"a\":\"b\"}"},
+        {"{}", "{\"a\":{\"bb\":{\"ccc\":null}}}", "{\"a\":{\"bb\":{}}}"},
+    };
+    for (auto& example : examples) {
+        Result result = apply(example[0], example[1]);
+        TEST_ASSERT_TRUE(result.ok);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(example[2], result.json.c_str(), example[1]);
+    }
+}
+
+static void test_reported_paths() {
+    Result result = apply("{\"a\":{\"b\":\"c\",\"x\":1}}", "{\"a\":{\"b\":\"d\",\"c\":null}}");
+    TEST_ASSERT_EQUAL(1, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("/a/b", result.paths[0].c_str());
+
+    // A new value is reported once, not member by member
+    result = apply("{}", "{\"a\":{\"bb\":{\"ccc\":null}}}");
+    TEST_ASSERT_EQUAL(1, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("/a", result.paths[0].c_str());
+
+    // The root replaced
+    result = apply("{\"a\":\"foo\"}", "\"bar\"");
+    TEST_ASSERT_EQUAL(1, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("", result.paths[0].c_str());
+
+    // Nothing changes, nothing is reported
+    result = apply("{\"a\":1,\"b\":[1,2]}", "{\"a\":1,\"b\":[1,2],\"c\":null}");
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL(0, result.paths.size());
+}
+
+// RFC 6901: '~' becomes "~0" and '/' becomes "~1"
+static void test_escaped_paths() {
+    Result result = apply("{\"m~n\":{\"x\":1}}", "{\"a/b\":1,\"m~n\":{\"x\":2},\"~/\":true}");
+    TEST_ASSERT_EQUAL(3, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("/a~1b", result.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("/m~0n/x", result.paths[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("/~0~1", result.paths[2].c_str());
+}
+
+static void test_null_removes() {
+    JsonDocument target;
+    deserializeJson(target, "{\"a\":1,\"b\":{\"c\":2,\"d\":3},\"e\":null}");
+    Result result = apply(target, "{\"a\":null,\"b\":{\"c\":null},\"e\":null,\"z\":null}");
+    TEST_ASSERT_EQUAL_STRING("{\"b\":{\"d\":3}}", result.json.c_str());
+    TEST_ASSERT_EQUAL(3, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("/a", result.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("/b/c", result.paths[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("/e", result.paths[2].c_str());
+    TEST_ASSERT_FALSE(target.containsKey("a"));
+    TEST_ASSERT_FALSE(target.containsKey("z"));
+
+    // Removing what isn't there reports nothing
+    result = apply(target, "{\"a\":null,\"b\":{\"x\":null}}");
+    TEST_ASSERT_EQUAL(0, result.paths.size());
+}
+
+// The same packed array is left alone, a different one replaces it and stays packed
+static void test_packed_arrays() {
+    JsonDocument target;
+    deserializeJson(target, "{\"s\":[0.5,1.5,2.5,3.5],\"i\":[1,2,3,4]}");
+    TEST_ASSERT_FALSE(target["s"].as<JsonSpan<float>>().isNull());
+    size_t memory = target.memoryReport().total();
+
+    Result result = apply(target, "{\"s\":[0.5,1.5,2.5,3.5],\"i\":[1,2,3,4]}");
+    TEST_ASSERT_EQUAL(0, result.paths.size());
+    TEST_ASSERT_EQUAL(memory, target.memoryReport().total());
+
+    result = apply(target, "{\"s\":[0.5,1.5,2.5,9.5,10.5],\"i\":[1,2,3,5]}");
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL(2, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("/s", result.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("/i", result.paths[1].c_str());
+    JsonSpan<float> s = target["s"].as<JsonSpan<float>>();
+    TEST_ASSERT_EQUAL(5, s.size());
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, s.data()[4]);
+    JsonSpan<int32_t> i = target["i"].as<JsonSpan<int32_t>>();
+    TEST_ASSERT_EQUAL(4, i.size());
+    TEST_ASSERT_EQUAL(5, i.data()[3]);
+
+    // Another type, or a regular array, replaces it
+    result = apply(target, "{\"s\":[1,2,3,4],\"i\":[1,\"two\"]}");
+    TEST_ASSERT_EQUAL(2, result.paths.size());
+    TEST_ASSERT_FALSE(target["s"].as<JsonSpan<int32_t>>().isNull());
+    TEST_ASSERT_EQUAL_STRING("{\"s\":[1,2,3,4],\"i\":[1,\"two\"]}", result.json.c_str());
+}
+
+// Levels of 21 characters: three fill the 63 a path can hold, the changes in the
+// fourth are reported once at the third, and a shorter sibling still gets its own path
+static void test_truncated_path() {
+    TEST_ASSERT_EQUAL(64, ARDUINOJSON_PATCH_PATH_SIZE);
+    std::string key(20, 'k');
+    std::string level3 = "/" + key + "/" + key + "/" + key;
+    std::string nested = "{\"" + key + "\":{\"" + key + "\":{\"" + key + "\":{\"" + key + "\":";
+
+    JsonDocument target;
+    deserializeJson(target, (nested + "1,\"y\":1},\"x\":1}}}").c_str());
+    Result result = apply(target, (nested + "2,\"y\":2},\"x\":2}}}").c_str());
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL(2, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING(level3.c_str(), result.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(("/" + key + "/" + key + "/x").c_str(), result.paths[1].c_str());
+    TEST_ASSERT_EQUAL(2, target[key][key][key][key].as<int>());
+    TEST_ASSERT_EQUAL(2, target[key][key][key]["y"].as<int>());
+
+    // Nothing changes down there, nothing is reported
+    result = apply(target, (nested + "2}}}}").c_str());
+    TEST_ASSERT_EQUAL(0, result.paths.size());
+
+    // A key longer than the whole path is reported at the root
+    std::string longKey(80, 'z');
+    result = apply("{}", ("{\"" + longKey + "\":1}").c_str());
+    TEST_ASSERT_EQUAL(1, result.paths.size());
+    TEST_ASSERT_EQUAL_STRING("", result.paths[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(("{\"" + longKey + "\":1}").c_str(), result.json.c_str());
+}
+
+// Refuses the allocations once the budget runs out
+struct BudgetAllocator : ArduinoJson::Allocator {
+    size_t budget = size_t(-1);
+
+    void* allocate(size_t size) override {
+        if (!budget) return nullptr;
+        budget--;
+        return malloc(size);
+    }
+    void deallocate(void* p) override { free(p); }
+    void* reallocate(void* p, size_t size) override {
+        if (!budget) return nullptr;
+        budget--;
+        return realloc(p, size);
+    }
+};
+
+static void test_failed_allocation() {
+    BudgetAllocator allocator;
+    JsonDocument target(&allocator);
+    deserializeJson(target, "{\"a\":1}");
+
+    // The new key has to be copied
+    std::string key(200, 'k');
+    std::string patch = "{\"a\":2,\"" + key + "\":\"value\"}";
+    allocator.budget = 0;
+    Result result = apply(target, patch.c_str());
+    TEST_ASSERT_FALSE(result.ok);
+    TEST_ASSERT_EQUAL(2, target["a"].as<int>());
+    TEST_ASSERT_FALSE(target.containsKey(key));
+
+    // Once there's memory again, the same patch goes through, but like set(), it
+    // keeps failing until clear() resets JsonDocument::overflowed()
+    allocator.budget = size_t(-1);
+    result = apply(target, patch.c_str());
+    TEST_ASSERT_FALSE(result.ok);
+    TEST_ASSERT_TRUE(target.overflowed());
+    TEST_ASSERT_EQUAL_STRING("value", target[key].as<const char*>());
+    target.clear();
+    result = apply(target, patch.c_str());
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL_STRING("value", target[key].as<const char*>());
+
+    // An unbound target
+    JsonDocument small;
+    deserializeJson(small, "{\"a\":1}");
+    TEST_ASSERT_FALSE(mergePatch(JsonVariant(), small));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rfc7396_examples);
+    RUN_TEST(test_reported_paths);
+    RUN_TEST(test_escaped_paths);
+    RUN_TEST(test_null_removes);
+    RUN_TEST(test_packed_arrays);
+    RUN_TEST(test_truncated_path);
+    RUN_TEST(test_failed_allocation);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+// Runs of MsgPack numbers read in bulk into a packed array, from a buffer, against
+// the element by element path that stream readers take, on 10k-element arrays
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+
+void setUp() {}
+void tearDown() {}
+
+// A reader that can't look ahead, so the deserializer gets one element at a time
+struct ByteSource {
+    const char* p;
+    const char* end;
+
+    int read() { return p < end ? (unsigned char)*p++ : -1; }
+    size_t readBytes(char* buffer, size_t n) {
+        size_t i = 0;
+        while (i < n && p < end) buffer[i++] = *p++;
+        return i;
+    }
+};
+
+static std::string arrayHeader(uint32_t n) {
+    std::string bytes = "\xdd";
+    for (int shift = 24; shift >= 0; shift -= 8) bytes += char(n >> shift);
+    return bytes;
+}
+
+// n elements with this code, each with the value's big-endian bytes
+template <typename T>
+static std::string numbers(uint8_t code, int n, T (*value)(int)) {
+    std::string bytes = arrayHeader(n);
+    for (int i = 0; i < n; i++) {
+        T v = value(i);
+        uint8_t raw[sizeof(T)];
+        memcpy(raw, &v, sizeof(T));
+        bytes += char(code);
+        for (int k = sizeof(T) - 1; k >= 0; k--) bytes += char(raw[k]);
+    }
+    return bytes;
+}
+
+static std::string fixints(int n) {
+    std::string bytes = arrayHeader(n);
+    for (int i = 0; i < n; i++) bytes += char(i % 128);
+    return bytes;
+}
+
+static float float32(int i) { return i * 0.25f + 0.1f; }
+static double float64(int i) { return i * 0.001 + 1e-9; }
+static int32_t int32(int i) { return i * 40000 - 7; }
+static int16_t int16(int i) { return int16_t(i * 3 - 15000); }
+
+template <typename TRead>
+static double usPerCall(int n, TRead read) {
+    using namespace std::chrono;
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < n; i++) read();
+    return duration<double, std::micro>(steady_clock::now() - t0).count() / n;
+}
+
+// Same packed array both ways; reports the two timings and the memory used
+template <typename T>
+static void compare(const char* name, const std::string& bytes, size_t n) {
+    JsonDocument bulk, oneByOne;
+    TEST_ASSERT_FALSE(deserializeMsgPack(bulk, bytes.data(), bytes.size()));
+    ByteSource source{bytes.data(), bytes.data() + bytes.size()};
+    TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(oneByOne, source).c_str());
+
+    JsonSpan<T> a = bulk.as<JsonSpan<T>>();
+    JsonSpan<T> b = oneByOne.as<JsonSpan<T>>();
+    TEST_ASSERT_EQUAL_MESSAGE(n, a.size(), name);
+    TEST_ASSERT_EQUAL_MESSAGE(n, b.size(), name);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(a.data(), b.data(), n * sizeof(T), name);
+
+    const int runs = 200;
+    double bulkUs = usPerCall(runs, [&] {
+        JsonDocument doc;
+        deserializeMsgPack(doc, bytes.data(), bytes.size());
+    });
+    double oneByOneUs = usPerCall(runs, [&] {
+        JsonDocument doc;
+        ByteSource s{bytes.data(), bytes.data() + bytes.size()};
+        deserializeMsgPack(doc, s);
+    });
+
+    char message[128];
+    snprintf(message, sizeof(message), "%s x%zu: one by one %.1f us, bulk %.1f us, %zu B used",
+             name, n, oneByOneUs, bulkUs, bulk.memoryReport().total());
+    TEST_MESSAGE(message);
+}
+
+static void test_float32() {
+    compare<float>("float32", numbers<float>(0xca, 10000, float32), 10000);
+}
+
+// 10k doubles are over the 64 KB a packed array can hold
+static void test_float64() {
+    compare<double>("float64", numbers<double>(0xcb, 8000, float64), 8000);
+}
+
+static void test_int32() {
+    compare<int32_t>("int32", numbers<int32_t>(0xd2, 10000, int32), 10000);
+}
+
+static void test_int16() {
+    compare<int32_t>("int16", numbers<int16_t>(0xd1, 10000, int16), 10000);
+}
+
+static void test_fixint() {
+    compare<int32_t>("fixint", fixints(10000), 10000);
+}
+
+// A run that changes code halfway is still one packed array
+static void test_mixed_codes() {
+    std::string bytes = arrayHeader(3000);
+    for (int i = 0; i < 3000; i++) {
+        if (i < 1000) {
+            bytes += char(i % 100);
+        } else {
+            int16_t v = int16(i);
+            bytes += "\xd1";
+            bytes += char(uint16_t(v) >> 8);
+            bytes += char(v);
+        }
+    }
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, bytes.data(), bytes.size()));
+    JsonSpan<int32_t> span = doc.as<JsonSpan<int32_t>>();
+    TEST_ASSERT_EQUAL(3000, span.size());
+    TEST_ASSERT_EQUAL(99, span.data()[999]);
+    TEST_ASSERT_EQUAL(int16(2999), span.data()[2999]);
+}
+
+// Refuses the blocks bigger than the limit
+struct CappedAllocator : ArduinoJson::Allocator {
+    size_t limit;
+    explicit CappedAllocator(size_t l) : limit(l) {}
+
+    void* allocate(size_t size) override { return size > limit ? nullptr : malloc(size); }
+    void deallocate(void* p) override { free(p); }
+    void* reallocate(void* p, size_t size) override {
+        return size > limit ? nullptr : realloc(p, size);
+    }
+};
+
+// From a bare pointer only a few elements are reserved up front, and the runs make
+// room for themselves; when there isn't any, the error comes back instead of the
+// elements going past the end
+static void test_runs_grow_the_array() {
+    std::string bytes = numbers<float>(0xca, 10000, float32);
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, (const char*)bytes.data()));
+    JsonSpan<float> span = doc.as<JsonSpan<float>>();
+    TEST_ASSERT_EQUAL(10000, span.size());
+    for (int i = 0; i < 10000; i++) TEST_ASSERT_EQUAL_FLOAT(float32(i), span.data()[i]);
+
+    bytes = fixints(10000);
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, (const char*)bytes.data()));
+    TEST_ASSERT_EQUAL(10000, doc.as<JsonSpan<int32_t>>().size());
+    TEST_ASSERT_EQUAL(9999 % 128, doc.as<JsonSpan<int32_t>>().data()[9999]);
+
+    CappedAllocator allocator(1024);
+    JsonDocument capped(&allocator);
+    bytes = numbers<float>(0xca, 10000, float32);
+    TEST_ASSERT_EQUAL(DeserializationError::NoMemory,
+                      deserializeMsgPack(capped, (const char*)bytes.data()).code());
+    bytes = fixints(10000);
+    TEST_ASSERT_EQUAL(DeserializationError::NoMemory,
+                      deserializeMsgPack(capped, (const char*)bytes.data()).code());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_float32);
+    RUN_TEST(test_float64);
+    RUN_TEST(test_int32);
+    RUN_TEST(test_int16);
+    RUN_TEST(test_fixint);
+    RUN_TEST(test_mixed_codes);
+    RUN_TEST(test_runs_grow_the_array);
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+// The telemetry frame as JSON and as MsgPack (as backend/app.py encodes it): bytes
+// and decode time, and the count in a MsgPack array header not being trusted
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+
+void setUp() {}
+void tearDown() {}
+
+// Remembers the biggest block asked for
+struct PeakAllocator : ArduinoJson::Allocator {
+    size_t largest = 0;
+
+    void* allocate(size_t size) override {
+        if (size > largest) largest = size;
+        return malloc(size);
+    }
+    void deallocate(void* p) override { free(p); }
+    void* reallocate(void* p, size_t size) override {
+        if (size > largest) largest = size;
+        return realloc(p, size);
+    }
+};
+
+static const int sparklineSize = 20;
+
+// The fields the display reads, as the stand-in server sends them. MsgPack gets
+// float32, as with use_single_float=True. serializeMsgPack() writes a whole float
+// as an integer, which Python doesn't, so the values all have a fraction.
+template <typename T>
+static void buildFrame(JsonDocument& doc) {
+    doc["type"] = "telemetry";
+    doc["btc_price"] = T(64164.89);
+    doc["btc_change_24h"] = T(0.26);
+    doc["profit_usd"] = T(1271.74);
+    doc["profit_today"] = T(71.74);
+    doc["mode"] = "standby";
+    JsonArray sparkline = doc["sparkline"].to<JsonArray>();
+    for (int i = 0; i < sparklineSize; i++) sparkline.add(T(64000.5 + i * 13.37));
+}
+
+template <typename TParse>
+static double nsPerCall(int n, TParse parse) {
+    using namespace std::chrono;
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < n; i++) parse();
+    return duration<double, std::nano>(steady_clock::now() - t0).count() / n;
+}
+
+static void test_msgpack_is_smaller_and_faster() {
+    JsonDocument source;
+    std::string json, msgpack;
+    buildFrame<double>(source);
+    serializeJson(source, json);
+    source.clear();
+    buildFrame<float>(source);
+    serializeMsgPack(source, msgpack);
+
+    JsonDocument fromJson, fromMsgPack;
+    TEST_ASSERT_FALSE(deserializeJson(fromJson, json));
+    TEST_ASSERT_FALSE(deserializeMsgPack(fromMsgPack, msgpack));
+    TEST_ASSERT_EQUAL_FLOAT(64164.89f, fromMsgPack["btc_price"].as<float>());
+    JsonSpan<float> spark = fromMsgPack["sparkline"].as<JsonSpan<float>>();
+    TEST_ASSERT_EQUAL(sparklineSize, spark.size());
+    TEST_ASSERT_EQUAL_FLOAT(64000.5f + 19 * 13.37f, spark.data()[19]);
+    TEST_ASSERT_LESS_THAN(json.size(), msgpack.size());
+
+    const int n = 20000;
+    double jsonNs = nsPerCall(n, [&] { deserializeJson(fromJson, json); });
+    double msgpackNs = nsPerCall(n, [&] { deserializeMsgPack(fromMsgPack, msgpack); });
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "JSON %zu B, %.0f ns, %zu B used; MsgPack %zu B, %.0f ns, %zu B used",
+             json.size(), jsonNs, fromJson.memoryReport().total(), msgpack.size(), msgpackNs,
+             fromMsgPack.memoryReport().total());
+    TEST_MESSAGE(message);
+}
+
+// An array16 header that claims 16000 float32 elements, followed by only 5
+static std::string shortArray() {
+    std::string bytes = "\xdc\x3e\x80";
+    for (int i = 0; i < 5; i++) bytes += std::string("\xca\x3f\x80\x00\x00", 5);
+    return bytes;
+}
+
+static void test_header_count_does_not_reserve_from_a_buffer() {
+    PeakAllocator allocator;
+    JsonDocument doc(&allocator);
+    std::string bytes = shortArray();
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput,
+                      deserializeMsgPack(doc, bytes.data(), bytes.size()).code());
+    // 64000 bytes before: the room now depends on the bytes left
+    TEST_ASSERT_LESS_THAN(1024, allocator.largest);
+}
+
+static void test_header_count_does_not_reserve_from_a_stream() {
+    PeakAllocator allocator;
+    JsonDocument doc(&allocator);
+    std::istringstream stream(shortArray());
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput,
+                      deserializeMsgPack(doc, stream).code());
+    TEST_ASSERT_LESS_THAN(1024, allocator.largest);
+}
+
+// A bare pointer doesn't know where the input ends: the room reserved for the array
+// must not come from that (it wrapped around to nothing and the elements overran it)
+static void test_array_from_a_bare_pointer() {
+    const int n = 100;
+    JsonDocument source;
+    JsonArray values = source.to<JsonArray>();
+    for (int i = 0; i < n; i++) values.add(float(i) / 4 + 0.1f);
+    std::string floats;
+    serializeMsgPack(source, floats);
+    values.clear();
+    for (int i = 0; i < n; i++) values.add(i % 100);  // Positive fixints
+    std::string ints;
+    serializeMsgPack(source, ints);
+
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, (const char*)floats.c_str()));
+    JsonSpan<float> span = doc.as<JsonSpan<float>>();
+    TEST_ASSERT_EQUAL(n, span.size());
+    for (int i = 0; i < n; i++) TEST_ASSERT_EQUAL_FLOAT(float(i) / 4 + 0.1f, span.data()[i]);
+
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, (const char*)ints.c_str()));
+    JsonSpan<int32_t> intSpan = doc.as<JsonSpan<int32_t>>();
+    TEST_ASSERT_EQUAL(n, intSpan.size());
+    for (int i = 0; i < n; i++) TEST_ASSERT_EQUAL(i, intSpan.data()[i]);
+}
+
+// The packed array grows past the room reserved up front, and past the last
+// power of two that fits in a packed array
+static void test_long_array_from_a_stream() {
+    const int n = 10000;
+    JsonDocument source;
+    JsonArray values = source.to<JsonArray>();
+    for (int i = 0; i < n; i++) values.add(float(i) / 4 + 0.1f);
+    std::string bytes;
+    serializeMsgPack(source, bytes);
+
+    JsonDocument doc;
+    std::istringstream stream(bytes);
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, stream));
+    JsonSpan<float> span = doc.as<JsonSpan<float>>();
+    TEST_ASSERT_EQUAL(n, span.size());
+    for (int i = 0; i < n; i++) TEST_ASSERT_EQUAL_FLOAT(float(i) / 4 + 0.1f, span.data()[i]);
+}
+
+// Over 64 KB of floats: regular slots, as from a buffer
+static void test_too_long_to_pack_from_a_stream() {
+    const int n = 20000;
+    JsonDocument source;
+    JsonArray values = source.to<JsonArray>();
+    for (int i = 0; i < n; i++) values.add(float(i) / 4 + 0.1f);
+    std::string bytes;
+    serializeMsgPack(source, bytes);
+
+    JsonDocument doc;
+    std::istringstream stream(bytes);
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, stream));
+    TEST_ASSERT_TRUE(doc.is<JsonArrayConst>());
+    TEST_ASSERT_EQUAL(n, doc.size());
+    TEST_ASSERT_EQUAL_FLOAT(float(n - 1) / 4 + 0.1f, doc[n - 1].as<float>());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_msgpack_is_smaller_and_faster);
+    RUN_TEST(test_header_count_does_not_reserve_from_a_buffer);
+    RUN_TEST(test_header_count_does_not_reserve_from_a_stream);
+    RUN_TEST(test_array_from_a_bare_pointer);
+    RUN_TEST(test_long_array_from_a_stream);
+    RUN_TEST(test_too_long_to_pack_from_a_stream);
+    return UNITY_END();
+}
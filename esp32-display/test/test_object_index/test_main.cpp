@@ -0,0 +1,138 @@
+// JsonKey and JsonObject::buildIndex(): lookups don't allocate, the index follows
+// edits, a key from a buffer is copied, and what a JsonKey lookup costs
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+void setUp() {}
+void tearDown() {}
+
+static constexpr JsonKey kPrice("btc_price");
+static constexpr JsonKey kMode("mode");
+static constexpr JsonKey kMissing("missing");
+
+static void fill(JsonObject object, int n) {
+    char key[24];
+    for (int i = 0; i < n; i++) {
+        snprintf(key, sizeof(key), "member_%02d", i);
+        object[key] = i;
+    }
+}
+
+static void test_length_and_hash_at_compile_time() {
+    static_assert(kPrice.size() == 9, "length of the literal");
+    static_assert(kPrice.hash() == JsonKey("btc_price").hash(), "same hash");
+    static_assert(kMode.hash() != kPrice.hash(), "different hash");
+
+    // Stops at the terminator, whatever the size of the buffer
+    char buffer[32] = "mode";
+    TEST_ASSERT_EQUAL(4, JsonKey(buffer).size());
+    TEST_ASSERT_EQUAL_UINT32(kMode.hash(), JsonKey(buffer).hash());
+    TEST_ASSERT_TRUE(JsonKey(nullptr).size() == 0);
+}
+
+static void test_reading_does_not_build_an_index() {
+    JsonDocument doc;
+    fill(doc.to<JsonObject>(), 12);
+    doc[kPrice] = 64000.5;
+    size_t before = doc.memoryReport().total();
+
+    const JsonDocument& view = doc;
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(64000.5f, view[kPrice].as<float>());
+        TEST_ASSERT_TRUE(view[kMissing].isNull());
+    }
+    TEST_ASSERT_EQUAL(before, doc.memoryReport().total());
+
+    TEST_ASSERT_TRUE(doc.as<JsonObject>().buildIndex());
+    TEST_ASSERT_GREATER_THAN(before, doc.memoryReport().total());
+    TEST_ASSERT_EQUAL_FLOAT(64000.5f, view[kPrice].as<float>());
+}
+
+static void test_indexed_object_follows_edits() {
+    JsonDocument doc;
+    JsonObject object = doc.to<JsonObject>();
+    fill(object, 20);
+    TEST_ASSERT_TRUE(object.buildIndex());
+    TEST_ASSERT_EQUAL(7, object[JsonKey("member_07")].as<int>());
+
+    // Members added after the index are found too
+    object[kMode] = "live";
+    TEST_ASSERT_EQUAL_STRING("live", object[kMode].as<const char*>());
+    TEST_ASSERT_EQUAL(19, object[JsonKey("member_19")].as<int>());
+
+    // Removing a member drops the index
+    object.remove("member_07");
+    TEST_ASSERT_TRUE(object[JsonKey("member_07")].isNull());
+    TEST_ASSERT_EQUAL(8, object[JsonKey("member_08")].as<int>());
+    TEST_ASSERT_EQUAL_STRING("live", object[kMode].as<const char*>());
+}
+
+static void test_key_from_a_buffer_is_copied() {
+    JsonDocument doc;
+    char buffer[16] = "first";
+    doc[JsonKey(buffer)] = 1;
+    strcpy(buffer, "xxxxx");
+    TEST_ASSERT_EQUAL(1, doc["first"].as<int>());
+    TEST_ASSERT_TRUE(doc["xxxxx"].isNull());
+}
+
+static void test_unbound_object() {
+    JsonObject object;
+    TEST_ASSERT_FALSE(object.buildIndex());
+}
+
+struct Telemetry {
+    long price;
+    int mode;
+};
+
+// ns per lookup of the last of the members, with a literal, a JsonKey before and
+// after buildIndex(), and a struct field for scale
+static void test_benchmark() {
+    using namespace std::chrono;
+    for (int n : {6, 12, 48}) {
+        JsonDocument doc;
+        JsonObject object = doc.to<JsonObject>();
+        fill(object, n - 1);
+        object["btc_price"] = 64000;
+        const int runs = 200000;
+
+        volatile Telemetry telemetry{64000, 1};
+        long sum = 0;
+        auto t0 = steady_clock::now();
+        for (int r = 0; r < runs; r++) sum += doc["btc_price"].as<long>();
+        auto t1 = steady_clock::now();
+        for (int r = 0; r < runs; r++) sum += doc[kPrice].as<long>();
+        auto t2 = steady_clock::now();
+        object.buildIndex();
+        for (int r = 0; r < runs; r++) sum += doc[kPrice].as<long>();
+        auto t3 = steady_clock::now();
+        for (int r = 0; r < runs; r++) sum += telemetry.price;
+        auto t4 = steady_clock::now();
+        TEST_ASSERT_EQUAL(4L * runs * 64000, sum);
+
+        double perLookup = 1e9 / runs;
+        char message[128];
+        snprintf(message, sizeof(message),
+                 "%d members: literal %.1f ns, JsonKey %.1f ns, indexed %.1f ns, field %.1f ns", n,
+                 duration<double>(t1 - t0).count() * perLookup,
+                 duration<double>(t2 - t1).count() * perLookup,
+                 duration<double>(t3 - t2).count() * perLookup,
+                 duration<double>(t4 - t3).count() * perLookup);
+        TEST_MESSAGE(message);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_length_and_hash_at_compile_time);
+    RUN_TEST(test_reading_does_not_build_an_index);
+    RUN_TEST(test_indexed_object_follows_edits);
+    RUN_TEST(test_key_from_a_buffer_is_copied);
+    RUN_TEST(test_unbound_object);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,235 @@
+// JsonOutputBuffer and serializeJson(JsonDocument&, JsonOutputBuffer&): output over
+// several blocks, clear() keeping them, one allocation from the size hint and none on
+// reuse, writeTo(), toIovec() and copyTo() across blocks, and a failed allocation
+// leaving the hint alone
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/uio.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Counts the allocations, and refuses them once the budget runs out
+struct CountingAllocator : ArduinoJson::Allocator {
+    size_t allocations = 0;
+    size_t budget = size_t(-1);
+
+    void* allocate(size_t size) override {
+        if (!budget) return nullptr;
+        budget--;
+        allocations++;
+        return malloc(size);
+    }
+    void deallocate(void* p) override { free(p); }
+    void* reallocate(void* p, size_t size) override { return realloc(p, size); }
+};
+
+// Takes at most `limit` bytes per call, like a socket with a full send buffer
+struct Destination {
+    std::string data;
+    size_t calls = 0;
+    size_t limit = size_t(-1);
+
+    size_t write(const uint8_t* s, size_t n) {
+        calls++;
+        if (n > limit) n = limit;
+        data.append(reinterpret_cast<const char*>(s), n);
+        return n;
+    }
+};
+
+static void fill(JsonDocument& doc, int n) {
+    doc.clear();
+    for (int i = 0; i < n; i++) doc.add("element " + std::to_string(i));
+}
+
+static std::string expected(JsonDocument& doc) {
+    std::string json;
+    serializeJson(doc, json);
+    return json;
+}
+
+static std::string contents(const JsonOutputBuffer& output) {
+    std::string data(output.size(), '\0');
+    TEST_ASSERT_EQUAL(output.size(), output.copyTo(&data[0], data.size()));
+    return data;
+}
+
+static void test_writes_across_blocks() {
+    CountingAllocator allocator;
+    JsonOutputBuffer output(16, &allocator);
+    TEST_ASSERT_EQUAL(0, output.size());
+    TEST_ASSERT_EQUAL(0, output.blockCount());
+
+    JsonDocument doc;
+    fill(doc, 10);
+    std::string json = expected(doc);
+    TEST_ASSERT_EQUAL(json.size(), serializeJson(doc, output));
+    TEST_ASSERT_EQUAL(json.size(), output.size());
+    TEST_ASSERT_EQUAL((json.size() + 15) / 16, output.blockCount());
+    TEST_ASSERT_EQUAL(output.blockCount(), allocator.allocations);
+    TEST_ASSERT_EQUAL(16 * output.blockCount(), output.capacity());
+    TEST_ASSERT_EQUAL_STRING(json.c_str(), contents(output).c_str());
+
+    // Writes that straddle blocks, one byte at a time and in bulk
+    output.clear();
+    for (char c : std::string("0123456789")) output.write(uint8_t(c));
+    output.write(reinterpret_cast<const uint8_t*>("abcdefghijklmnopqrstuvwxyz"), 26);
+    TEST_ASSERT_EQUAL_STRING("0123456789abcdefghijklmnopqrstuvwxyz", contents(output).c_str());
+    TEST_ASSERT_EQUAL(3, output.blockCount());
+}
+
+static void test_clear_keeps_the_blocks() {
+    CountingAllocator allocator;
+    JsonOutputBuffer output(16, &allocator);
+    std::string text(100, 'x');
+    output.write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    size_t allocations = allocator.allocations;
+    size_t capacity = output.capacity();
+
+    output.clear();
+    TEST_ASSERT_EQUAL(0, output.size());
+    TEST_ASSERT_EQUAL(0, output.blockCount());
+    TEST_ASSERT_EQUAL(capacity, output.capacity());
+
+    // Shorter, then as long again: the blocks are reused
+    output.write(reinterpret_cast<const uint8_t*>("short"), 5);
+    TEST_ASSERT_EQUAL(5, output.size());
+    TEST_ASSERT_EQUAL_STRING("short", contents(output).c_str());
+    output.clear();
+    output.write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    TEST_ASSERT_EQUAL(allocations, allocator.allocations);
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), contents(output).c_str());
+
+    output.release();
+    TEST_ASSERT_EQUAL(0, output.capacity());
+    TEST_ASSERT_EQUAL(0, output.size());
+}
+
+// The first serialization grows block by block, the second takes one block sized
+// from the hint, the ones after that allocate nothing
+static void test_reserve_from_the_hint() {
+    CountingAllocator allocator;
+    JsonOutputBuffer output(32, &allocator);
+    JsonDocument doc;
+    fill(doc, 50);
+    std::string json = expected(doc);
+    TEST_ASSERT_EQUAL(0, doc.serializedSizeHint());
+
+    serializeJson(doc, output);
+    TEST_ASSERT_EQUAL(json.size(), doc.serializedSizeHint());
+    TEST_ASSERT_GREATER_THAN(1, allocator.allocations);
+
+    allocator.allocations = 0;
+    TEST_ASSERT_EQUAL(json.size(), serializeJson(doc, output));
+    TEST_ASSERT_EQUAL(1, allocator.allocations);
+    TEST_ASSERT_EQUAL(1, output.blockCount());
+    TEST_ASSERT_EQUAL(json.size() + json.size() / 8, output.capacity());
+    TEST_ASSERT_EQUAL_STRING(json.c_str(), contents(output).c_str());
+
+    // A little longer still fits in the slack
+    allocator.allocations = 0;
+    doc[0] = "a longer first element";
+    for (int i = 0; i < 5; i++) {
+        serializeJson(doc, output);
+        TEST_ASSERT_EQUAL_STRING(expected(doc).c_str(), contents(output).c_str());
+    }
+    TEST_ASSERT_EQUAL(0, allocator.allocations);
+
+    // The reserved block works for MsgPack too
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+    serializeMsgPack(doc, output);
+    TEST_ASSERT_TRUE(msgpack == contents(output));
+}
+
+static void test_write_to_iovec_and_copy() {
+    JsonOutputBuffer output(10);
+    std::string text;
+    for (int i = 0; i < 45; i++) text += char('A' + i % 26);
+    output.write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    TEST_ASSERT_EQUAL(5, output.blockCount());
+
+    // One call per block
+    Destination destination;
+    TEST_ASSERT_EQUAL(45, output.writeTo(destination));
+    TEST_ASSERT_EQUAL(5, destination.calls);
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), destination.data.c_str());
+
+    // Stops at the first short write
+    Destination full;
+    full.limit = 4;
+    TEST_ASSERT_EQUAL(4, output.writeTo(full));
+    TEST_ASSERT_EQUAL(1, full.calls);
+
+    iovec iov[8];
+    TEST_ASSERT_EQUAL(5, output.toIovec(iov, 8));
+    std::string gathered;
+    for (int i = 0; i < 5; i++) gathered.append(static_cast<char*>(iov[i].iov_base), iov[i].iov_len);
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), gathered.c_str());
+    TEST_ASSERT_EQUAL(10, iov[0].iov_len);
+    TEST_ASSERT_EQUAL(5, iov[4].iov_len);
+    TEST_ASSERT_EQUAL(3, output.toIovec(iov, 3));
+
+    char copy[64];
+    memset(copy, '#', sizeof(copy));
+    TEST_ASSERT_EQUAL(45, output.copyTo(copy, sizeof(copy)));
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), copy);
+    // Cut short, without a terminator when there's no room for it
+    memset(copy, '#', sizeof(copy));
+    TEST_ASSERT_EQUAL(23, output.copyTo(copy, 23));
+    TEST_ASSERT_EQUAL_MEMORY(text.data(), copy, 23);
+    TEST_ASSERT_EQUAL('#', copy[23]);
+
+    // After clear(), the blocks kept don't show
+    output.clear();
+    output.write(reinterpret_cast<const uint8_t*>("tail"), 4);
+    Destination after;
+    TEST_ASSERT_EQUAL(4, output.writeTo(after));
+    TEST_ASSERT_EQUAL_STRING("tail", after.data.c_str());
+    TEST_ASSERT_EQUAL(1, output.toIovec(iov, 8));
+}
+
+// A serialization cut short by a failed allocation doesn't become the next hint
+static void test_failed_allocation_keeps_the_hint() {
+    CountingAllocator allocator;
+    JsonOutputBuffer output(16, &allocator);
+    JsonDocument doc;
+    fill(doc, 20);
+    std::string json = expected(doc);
+
+    allocator.budget = 2;
+    size_t n = serializeJson(doc, output);
+    TEST_ASSERT_EQUAL(32, n);
+    TEST_ASSERT_TRUE(output.overflowed());
+    TEST_ASSERT_EQUAL(0, doc.serializedSizeHint());
+
+    allocator.budget = size_t(-1);
+    TEST_ASSERT_EQUAL(json.size(), serializeJson(doc, output));
+    TEST_ASSERT_FALSE(output.overflowed());
+    TEST_ASSERT_EQUAL(json.size(), doc.serializedSizeHint());
+
+    // Then the reserved block can't be had: the hint stays
+    allocator.budget = 0;
+    TEST_ASSERT_LESS_THAN(json.size(), serializeJson(doc, output));
+    TEST_ASSERT_TRUE(output.overflowed());
+    TEST_ASSERT_EQUAL(json.size(), doc.serializedSizeHint());
+
+    allocator.budget = size_t(-1);
+    TEST_ASSERT_EQUAL(json.size(), serializeJson(doc, output));
+    TEST_ASSERT_EQUAL_STRING(json.c_str(), contents(output).c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_writes_across_blocks);
+    RUN_TEST(test_clear_keeps_the_blocks);
+    RUN_TEST(test_reserve_from_the_hint);
+    RUN_TEST(test_write_to_iovec_and_copy);
+    RUN_TEST(test_failed_allocation_keeps_the_hint);
+    return UNITY_END();
+}
@@ -0,0 +1,277 @@
+// Packed arrays: const reads, indexing and iteration are served from the packed
+// storage and leave it packed, a JsonArray unpacks them, and an unpack that runs out
+// of memory shows in overflowed()
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <string>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static const char* ints = "[1,2,3,4,5,6,7,8]";
+static const char* floats = "[0.5,1.5,2.5,3.5,4.5]";
+// Too many digits, or too large, for a float
+static const char* doubles = "[1.000000000001,1e300,-2.25,0.5]";
+
+static void test_const_reads_leave_it_packed() {
+    JsonDocument doc;
+    deserializeJson(doc, ints);
+    TEST_ASSERT_TRUE(doc.as<JsonSpan<int32_t>>().size() == 8);
+    size_t before = doc.memoryReport().total();
+
+    const JsonDocument& view = doc;
+    TEST_ASSERT_EQUAL(8, view.size());
+    TEST_ASSERT_TRUE(view.is<JsonArrayConst>());
+    TEST_ASSERT_FALSE(view.as<JsonArrayConst>().isNull());
+    TEST_ASSERT_EQUAL(1, view[0].as<int>());
+    TEST_ASSERT_EQUAL(8, view[7].as<int>());
+    TEST_ASSERT_TRUE(view[8].isNull());
+    TEST_ASSERT_EQUAL(1, view.nesting());
+
+    // Serializing, copying and comparing work on the packed form
+    std::string json;
+    serializeJson(view, json);
+    TEST_ASSERT_EQUAL_STRING(ints, json.c_str());
+    JsonDocument copy;
+    copy.set(view);
+    TEST_ASSERT_FALSE(copy.as<JsonSpan<int32_t>>().isNull());
+    TEST_ASSERT_TRUE(copy == view);
+
+    TEST_ASSERT_EQUAL(before, doc.memoryReport().total());
+    TEST_ASSERT_FALSE(doc.as<JsonSpan<int32_t>>().isNull());
+}
+
+static void test_is_matches_as() {
+    JsonDocument doc;
+    deserializeJson(doc, floats);
+    JsonVariantConst packed = doc.as<JsonVariantConst>();
+    TEST_ASSERT_TRUE(packed.is<JsonArrayConst>());
+    TEST_ASSERT_FALSE(packed.as<JsonArrayConst>().isNull());
+    TEST_ASSERT_TRUE(packed.is<JsonSpan<float>>());
+    TEST_ASSERT_FALSE(packed.is<JsonSpan<int32_t>>());
+
+    // A JsonArray is the explicit step that unpacks
+    JsonVariant variant = doc.as<JsonVariant>();
+    TEST_ASSERT_TRUE(variant.is<JsonArray>());
+    JsonArray array = variant.as<JsonArray>();
+    TEST_ASSERT_FALSE(array.isNull());
+    TEST_ASSERT_TRUE(packed.is<JsonArrayConst>());
+    TEST_ASSERT_TRUE(packed.as<JsonSpan<float>>().isNull());
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, packed[2].as<float>());
+    TEST_ASSERT_FALSE(doc.overflowed());
+}
+
+// What the review found: indexing through the proxies and JsonVariantConst, and a
+// JsonArrayConst over the member, all read the packed elements
+static void test_reads_through_a_member() {
+    JsonDocument doc;
+    deserializeJson(doc, "{\"a\":[0,10,20,30,40,50,60,70,80,90]}");
+    TEST_ASSERT_FALSE(doc["a"].as<JsonSpan<int32_t>>().isNull());
+    size_t before = doc.memoryReport().total();
+
+    TEST_ASSERT_EQUAL(10, doc["a"].size());
+    TEST_ASSERT_EQUAL(20, doc["a"][2].as<int>());
+    TEST_ASSERT_TRUE(doc["a"][2].is<int>());
+    TEST_ASSERT_FALSE(doc["a"][2].isNull());
+    TEST_ASSERT_FALSE(doc["a"][2].isUnbound());
+    TEST_ASSERT_TRUE(doc["a"][10].isUnbound());
+    TEST_ASSERT_TRUE(doc["a"][2] == 20);
+    TEST_ASSERT_EQUAL(90, doc["a"][9] | -1);
+    TEST_ASSERT_EQUAL(-1, doc["a"][10] | -1);
+    TEST_ASSERT_TRUE(doc["a"].is<JsonArrayConst>());
+    TEST_ASSERT_TRUE(doc["a"].is<JsonArray>());
+
+    const JsonDocument& cdoc = doc;
+    JsonArrayConst array = cdoc["a"].as<JsonArrayConst>();
+    TEST_ASSERT_FALSE(array.isNull());
+    TEST_ASSERT_TRUE(array);
+    TEST_ASSERT_EQUAL(10, array.size());
+    TEST_ASSERT_EQUAL(30, array[3].as<int>());
+    TEST_ASSERT_TRUE(array[10].isNull());
+
+    JsonVariantConst variant = cdoc["a"];
+    TEST_ASSERT_EQUAL(40, variant[4].as<int>());
+    TEST_ASSERT_EQUAL(40, variant[4].as<float>());
+    TEST_ASSERT_TRUE(variant[4].is<int32_t>());
+    TEST_ASSERT_FALSE(variant[4].is<JsonArrayConst>());
+    TEST_ASSERT_TRUE(variant[4]["x"].isNull());
+    TEST_ASSERT_TRUE(variant[4][0].isNull());
+
+    int expected = 0, count = 0;
+    for (JsonVariantConst element : array) {
+        TEST_ASSERT_EQUAL(expected, element.as<int>());
+        expected += 10;
+        count++;
+    }
+    TEST_ASSERT_EQUAL(10, count);
+
+    TEST_ASSERT_EQUAL(before, doc.memoryReport().total());
+    TEST_ASSERT_FALSE(doc["a"].as<JsonSpan<int32_t>>().isNull());
+}
+
+// Each element type reads back as stored, doubles included, without making room for
+// them in the document
+static void test_element_types() {
+    JsonDocument doc;
+    deserializeJson(doc, floats);
+    TEST_ASSERT_TRUE(doc.as<JsonSpan<float>>().size() == 5);
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, doc[3].as<float>());
+    TEST_ASSERT_TRUE(doc[3].is<float>());
+    TEST_ASSERT_FALSE(doc[3].is<int>());
+    TEST_ASSERT_EQUAL(3, doc[3].as<int>());
+
+    deserializeJson(doc, doubles);
+    TEST_ASSERT_TRUE(doc.as<JsonSpan<double>>().size() == 4);
+    size_t before = doc.memoryReport().total();
+    const JsonDocument& cdoc = doc;
+    TEST_ASSERT_TRUE(cdoc[0].as<double>() == 1.000000000001);
+    TEST_ASSERT_TRUE(cdoc[1].as<double>() == 1e300);
+    TEST_ASSERT_TRUE(cdoc[2].as<double>() == -2.25);
+    TEST_ASSERT_TRUE(cdoc[0].is<double>());
+    TEST_ASSERT_TRUE(cdoc[0] == 1.000000000001);
+    TEST_ASSERT_TRUE(cdoc[0].as<bool>());
+    std::vector<double> seen;
+    for (JsonVariantConst element : cdoc.as<JsonArrayConst>()) seen.push_back(element);
+    TEST_ASSERT_EQUAL(4, seen.size());
+    TEST_ASSERT_TRUE(seen[0] == 1.000000000001);
+    TEST_ASSERT_TRUE(seen[1] == 1e300);
+    TEST_ASSERT_EQUAL(before, doc.memoryReport().total());
+}
+
+// A reference to an element holds a copy of it, which copies along with it
+static void test_element_copies() {
+    JsonDocument doc;
+    deserializeJson(doc, ints);
+    const JsonDocument& cdoc = doc;
+    JsonVariantConst first = cdoc[0];
+    JsonVariantConst copy = first;
+    JsonVariantConst assigned;
+    assigned = cdoc[5];
+    TEST_ASSERT_EQUAL(1, copy.as<int>());
+    TEST_ASSERT_EQUAL(6, assigned.as<int>());
+    assigned = copy;
+    TEST_ASSERT_EQUAL(1, assigned.as<int>());
+
+    // Through the iterator too
+    JsonArrayConst array = cdoc.as<JsonArrayConst>();
+    JsonArrayConstIterator it = array.begin();
+    ++it;
+    TEST_ASSERT_EQUAL(2, it->as<int>());
+    JsonVariantConst second = *it;
+    ++it;
+    TEST_ASSERT_EQUAL(2, second.as<int>());
+    TEST_ASSERT_EQUAL(3, (*it).as<int>());
+    TEST_ASSERT_TRUE(it != array.end());
+
+    std::vector<JsonVariantConst> all;
+    for (JsonVariantConst element : array) all.push_back(element);
+    TEST_ASSERT_EQUAL(8, all.size());
+    TEST_ASSERT_EQUAL(1, all[0].as<int>());
+    TEST_ASSERT_EQUAL(8, all[7].as<int>());
+}
+
+// JsonArrayConst compares, serializes and copies the same packed or not
+static void test_array_const_against_slots() {
+    JsonDocument a, b;
+    deserializeJson(a, ints);
+    deserializeJson(b, ints);
+    b.as<JsonArray>();
+    const JsonDocument& packed = a;
+    JsonArrayConst lhs = packed.as<JsonArrayConst>();
+    JsonArrayConst rhs = b.as<JsonArrayConst>();
+    TEST_ASSERT_TRUE(lhs == rhs);
+    TEST_ASSERT_TRUE(rhs == lhs);
+    TEST_ASSERT_TRUE(lhs == lhs);
+    b.add(9);
+    TEST_ASSERT_FALSE(lhs == b.as<JsonArrayConst>());
+    TEST_ASSERT_FALSE(b.as<JsonArrayConst>() == lhs);
+    b.remove(8);
+    b[7] = 0;
+    TEST_ASSERT_FALSE(lhs == b.as<JsonArrayConst>());
+
+    std::string json;
+    serializeJson(lhs, json);
+    TEST_ASSERT_EQUAL_STRING(ints, json.c_str());
+    serializeJson(packed[3], json);
+    TEST_ASSERT_EQUAL_STRING("4", json.c_str());
+
+    // Copying into a JsonArray gives regular elements
+    JsonDocument copy;
+    TEST_ASSERT_TRUE(copy.to<JsonArray>().set(lhs));
+    TEST_ASSERT_TRUE(copy.as<JsonSpan<int32_t>>().isNull());
+    TEST_ASSERT_TRUE(copy.as<JsonArrayConst>() == lhs);
+    TEST_ASSERT_FALSE(a.as<JsonSpan<int32_t>>().isNull());
+}
+
+static void test_writes_unpack() {
+    JsonDocument doc;
+    deserializeJson(doc, ints);
+    doc.add(9);
+    TEST_ASSERT_EQUAL(9, doc.size());
+    TEST_ASSERT_EQUAL(9, doc[8].as<int>());
+
+    deserializeJson(doc, ints);
+    doc[0] = 10;
+    TEST_ASSERT_EQUAL(10, doc[0].as<int>());
+
+    deserializeJson(doc, ints);
+    doc.remove(0);
+    TEST_ASSERT_EQUAL(2, doc[0].as<int>());
+}
+
+static void test_packed_and_unpacked_compare_equal() {
+    JsonDocument a, b;
+    deserializeJson(a, ints);
+    deserializeJson(b, ints);
+    b.as<JsonArray>();
+    TEST_ASSERT_TRUE(a.as<JsonSpan<int32_t>>().size() == 8);
+    TEST_ASSERT_TRUE(b.is<JsonArrayConst>());
+
+    JsonVariantConst packed = a.as<JsonVariantConst>();
+    JsonVariantConst slots = b.as<JsonVariantConst>();
+    TEST_ASSERT_TRUE(packed == slots);
+    TEST_ASSERT_TRUE(slots == packed);
+
+    b[3] = 0;
+    TEST_ASSERT_TRUE(packed != slots);
+    TEST_ASSERT_TRUE(slots != packed);
+
+    JsonDocument c;
+    deserializeJson(c, floats);
+    TEST_ASSERT_TRUE(packed != c.as<JsonVariantConst>());
+}
+
+static void test_failed_unpack_overflows() {
+    // Room for the packed array, not for a slot per element
+    static uint8_t memory[1024];
+    ArenaAllocator arena(memory, sizeof(memory));
+    JsonDocument doc(PoolPolicy::fixed(4), &arena);
+    std::string json = "[";
+    for (int i = 0; i < 40; i++) json += std::to_string(i) + (i < 39 ? "," : "]");
+    TEST_ASSERT_FALSE(deserializeJson(doc, json));
+    TEST_ASSERT_FALSE(doc.overflowed());
+
+    TEST_ASSERT_TRUE(doc.as<JsonArray>().isNull());
+    TEST_ASSERT_TRUE(doc.overflowed());
+
+    // Still packed and readable
+    JsonSpan<int32_t> span = doc.as<JsonSpan<int32_t>>();
+    TEST_ASSERT_EQUAL(40, span.size());
+    TEST_ASSERT_EQUAL(39, span.data()[39]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_const_reads_leave_it_packed);
+    RUN_TEST(test_is_matches_as);
+    RUN_TEST(test_reads_through_a_member);
+    RUN_TEST(test_element_types);
+    RUN_TEST(test_element_copies);
+    RUN_TEST(test_array_const_against_slots);
+    RUN_TEST(test_writes_unpack);
+    RUN_TEST(test_packed_and_unpacked_compare_equal);
+    RUN_TEST(test_failed_unpack_overflows);
+    return UNITY_END();
+}
@@ -0,0 +1,179 @@
+// PageManager on the emulated panel: pages match a full screen reference, a slide
+// shows both pages in between, and what each transition costs in frames, strips,
+// renderer calls and panels drawn, with and without the pre-rendered page
+#include <host_tft.h>
+#include <unity.h>
+
+#include <page_manager.h>
+#include "../../src/page_manager.cpp"
+
+#include <stdio.h>
+
+static int rendererCalls;
+static int panelsDrawn;
+
+// Panels skipped when they are not in the strip, like the firmware pages. Labels
+// use the GLCD font, as the numbered fonts keep 32-bit pointers.
+static void panel(TFT_eSPI& gfx, int y, int h, uint16_t color, const char* label) {
+    if (!gfx.checkViewport(8, y, 224, h)) return;
+    panelsDrawn++;
+    gfx.fillRoundRect(8, y, 224, h, 10, color);
+    gfx.setTextColor(TFT_WHITE, color);
+    gfx.setTextDatum(TC_DATUM);
+    gfx.drawString(label, 120, y + h / 2 - 4, 1);
+}
+
+static void pageA(TFT_eSPI& gfx) {
+    rendererCalls++;
+    panel(gfx, 8, 90, TFT_NAVY, "Local Time");
+    panel(gfx, 106, 120, TFT_DARKGREEN, "Block Height");
+    panel(gfx, 234, 86, TFT_MAROON, "Bot Ready");
+}
+
+static void pageB(TFT_eSPI& gfx) {
+    rendererCalls++;
+    panel(gfx, 8, 150, TFT_PURPLE, "BTC / USD");
+    panel(gfx, 166, 154, TFT_OLIVE, "Profit");
+}
+
+struct Fixture {
+    HostPanel panel;
+    TFT_eSPI tft;
+    PageManager pages{tft};
+    TFT_eSprite refA{&tft}, refB{&tft};
+
+    explicit Fixture(bool psram) {
+        host::psram = psram;
+        tft.init();
+        TEST_ASSERT_TRUE(pages.begin());
+        pages.addPage(pageA, TFT_BLACK);
+        pages.addPage(pageB, TFT_DARKGREY);
+        reference(refA, pageA, TFT_BLACK);
+        reference(refB, pageB, TFT_DARKGREY);
+        host::psram = false;
+    }
+
+    void reference(TFT_eSprite& ref, PageRenderer render, uint16_t background) {
+        ref.setColorDepth(16);
+        ref.createSprite(HostPanel::width, HostPanel::height);
+        ref.fillSprite(background);
+        render(ref);
+    }
+
+    // Columns [x0, x1) of the screen show columns from sx of the reference
+    bool shows(TFT_eSprite& ref, int x0, int x1, int sx) {
+        for (int y = 0; y < HostPanel::height; y++)
+            for (int x = x0; x < x1; x++)
+                if (panel.pixel(x, y) != ref.readPixel(sx + x - x0, y)) return false;
+        return true;
+    }
+
+    // Runs update() with frames that take frameMs, until the transition ends. In
+    // between, the old page is on the left and the new one on the right, moved
+    // along by a slide and where they are for a wipe.
+    uint32_t run(uint32_t frameMs, bool slide) {
+        const int w = HostPanel::width;
+        uint32_t start = millis();
+        uint16_t frames = 0;
+        while (pages.busy()) {
+            pages.update(millis());
+            if (pages.frames() == frames) {
+                host::advance(1);
+                continue;
+            }
+            frames = pages.frames();
+            host::advance(frameMs);
+            bool split = false;
+            for (int pos = 0; pos <= w && !split; pos++)
+                split = shows(refA, 0, w - pos, slide ? pos : 0) &&
+                        shows(refB, w - pos, w, slide ? 0 : w - pos);
+            TEST_ASSERT_TRUE(split);
+        }
+        return millis() - start;
+    }
+};
+
+static void report(const char* name, Fixture& f, uint32_t ms, int calls, int panels) {
+    char message[160];
+    snprintf(message, sizeof(message),
+             "%s: %u frames in %u ms, %u strips, %d renderer calls, %d panels drawn", name,
+             f.pages.frames(), ms, f.panel.stats.windows, calls, panels);
+    TEST_MESSAGE(message);
+}
+
+static void test_show_matches_the_reference() {
+    Fixture f(false);
+    f.panel.clearStats();
+    rendererCalls = panelsDrawn = 0;
+    f.pages.show(0);
+    TEST_ASSERT_TRUE(f.shows(f.refA, 0, HostPanel::width, 0));
+    // One strip per 32 lines, each panel drawn in the strips it crosses only
+    TEST_ASSERT_EQUAL(10, f.panel.stats.windows);
+    TEST_ASSERT_EQUAL(10, rendererCalls);
+    TEST_ASSERT_EQUAL(4 + 5 + 3, panelsDrawn);
+    f.pages.show(1);
+    TEST_ASSERT_TRUE(f.shows(f.refB, 0, HostPanel::width, 0));
+}
+
+static void test_slide() {
+    Fixture f(false);
+    f.pages.show(0);
+    f.panel.clearStats();
+    rendererCalls = panelsDrawn = 0;
+    f.pages.next();
+    uint32_t ms = f.run(22, true);
+    TEST_ASSERT_TRUE(f.shows(f.refB, 0, HostPanel::width, 0));
+    TEST_ASSERT_EQUAL(1, f.pages.current());
+
+    // 22 ms frames in 25 ms slots over 100 ms: 4 frames, each one a full screen
+    TEST_ASSERT_EQUAL(4, f.pages.frames());
+    TEST_ASSERT_LESS_OR_EQUAL(150, ms);
+    TEST_ASSERT_EQUAL(4 * 10, f.panel.stats.windows);
+    // Both pages per strip, but the old one is gone from the last frame
+    TEST_ASSERT_EQUAL(3 * 20 + 10, rendererCalls);
+    report("slide", f, ms, rendererCalls, panelsDrawn);
+}
+
+static void test_wipe_sends_only_new_columns() {
+    Fixture f(false);
+    f.pages.show(0);
+    f.panel.clearStats();
+    rendererCalls = panelsDrawn = 0;
+    f.pages.go(1, PageEffect::WipeLeft);
+    uint32_t ms = f.run(5, false);
+    TEST_ASSERT_TRUE(f.shows(f.refB, 0, HostPanel::width, 0));
+    TEST_ASSERT_EQUAL(HostPanel::width * HostPanel::height, f.panel.stats.pixels);
+    TEST_ASSERT_EQUAL(f.pages.frames() * 10, f.panel.stats.windows);
+    report("wipe", f, ms, rendererCalls, panelsDrawn);
+}
+
+static void test_slide_from_the_prerendered_page() {
+    Fixture f(true);
+    f.pages.show(0);
+    // One strip of the next page per idle update
+    rendererCalls = 0;
+    for (int i = 0; i < 12; i++) f.pages.update(millis());
+    TEST_ASSERT_EQUAL(10, rendererCalls);
+
+    f.panel.clearStats();
+    rendererCalls = panelsDrawn = 0;
+    f.pages.next();
+    uint32_t ms = f.run(22, true);
+    TEST_ASSERT_TRUE(f.shows(f.refB, 0, HostPanel::width, 0));
+    TEST_ASSERT_EQUAL(4, f.pages.frames());
+    // The new page is copied, only the old one is rendered
+    TEST_ASSERT_EQUAL(3 * 10, rendererCalls);
+    report("slide, pre-rendered", f, ms, rendererCalls, panelsDrawn);
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_show_matches_the_reference);
+    RUN_TEST(test_slide);
+    RUN_TEST(test_wipe_sends_only_new_columns);
+    RUN_TEST(test_slide_from_the_prerendered_page);
+    return UNITY_END();
+}
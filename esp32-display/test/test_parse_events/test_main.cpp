@@ -0,0 +1,242 @@
+// parseJson() with a JsonHandler: the events, stopping, errors, and constant memory
+// on inputs far bigger than the ESP32 heap
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+void setUp() {}
+void tearDown() {}
+
+// Writes every event as text, e.g. {k:a[i:1,f:2.5]}
+struct Trace : JsonHandler<Trace> {
+    std::string out;
+
+    bool startObject() { out += '{'; return true; }
+    bool endObject() { out += '}'; return true; }
+    bool startArray() { out += '['; return true; }
+    bool endArray() { out += ']'; return true; }
+    bool key(JsonString k) { out += "k:" + std::string(k.c_str(), k.size()); return true; }
+    bool string(JsonString s) { out += "s:" + std::string(s.c_str(), s.size()) + ','; return true; }
+    bool number(JsonFloat x) { out += "f:" + std::to_string(x) + ','; return true; }
+    bool integer(JsonInteger x) { out += "i:" + std::to_string(x) + ','; return true; }
+    bool boolean(bool b) { out += b ? "t," : "F,"; return true; }
+    bool null() { out += "n,"; return true; }
+};
+
+// The same text from a document built by deserializeJson()
+static void trace(JsonVariantConst v, std::string& out) {
+    if (v.is<JsonObjectConst>()) {
+        out += '{';
+        for (JsonPairConst p : v.as<JsonObjectConst>()) {
+            out += "k:" + std::string(p.key().c_str());
+            trace(p.value(), out);
+        }
+        out += '}';
+    } else if (v.is<JsonArrayConst>()) {
+        out += '[';
+        for (JsonVariantConst e : v.as<JsonArrayConst>()) trace(e, out);
+        out += ']';
+    } else if (v.is<const char*>()) {
+        out += "s:" + std::string(v.as<const char*>()) + ',';
+    } else if (v.is<bool>()) {
+        out += v.as<bool>() ? "t," : "F,";
+    } else if (v.isNull()) {
+        out += "n,";
+    } else if (v.is<JsonInteger>()) {
+        out += "i:" + std::to_string(v.as<JsonInteger>()) + ',';
+    } else {
+        out += "f:" + std::to_string(v.as<JsonFloat>()) + ',';
+    }
+}
+
+static void test_events_in_document_order() {
+    Trace t;
+    DeserializationError err = parseJson(
+        "{\"a\":[1,-2,2.5,\"x\"],\"b\":{\"c\":true,\"d\":false,\"e\":null},\"f\":[]}", t);
+    TEST_ASSERT_TRUE(err == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("{k:a[i:1,i:-2,f:2.500000,s:x,]k:b{k:ct,k:dF,k:en,}k:f[]}",
+                             t.out.c_str());
+}
+
+// Integers too big for JsonInteger arrive as numbers instead of being truncated
+static void test_unsigned_overflow_goes_to_number() {
+    struct Numbers : JsonHandler<Numbers> {
+        int integers = 0, numbers = 0;
+        bool integer(JsonInteger) { integers++; return true; }
+        bool number(JsonFloat) { numbers++; return true; }
+    } n;
+    TEST_ASSERT_TRUE(parseJson("[9223372036854775807,18446744073709551615,1e3]", n) ==
+                     DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(1, n.integers);
+    TEST_ASSERT_EQUAL(2, n.numbers);
+}
+
+// A handler that only hides number() still gets the integers
+static void test_integers_default_to_number() {
+    struct Sum : JsonHandler<Sum> {
+        double sum = 0;
+        bool number(JsonFloat x) { sum += x; return true; }
+    } s;
+    TEST_ASSERT_TRUE(parseJson("[1,2,3.5,{\"x\":-1}]", s) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_DOUBLE(5.5, s.sum);
+}
+
+static void test_handler_can_stop() {
+    struct FirstTwo : JsonHandler<FirstTwo> {
+        int seen = 0;
+        bool integer(JsonInteger) { return ++seen < 2; }
+    } h;
+    // Stopping is not an error, even though the rest of the input is never read
+    TEST_ASSERT_TRUE(parseJson("[1,2,3,4", h) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(2, h.seen);
+}
+
+static void test_reports_errors() {
+    Trace t;
+    TEST_ASSERT_TRUE(parseJson("{\"a\":[1,2", t) == DeserializationError::IncompleteInput);
+    TEST_ASSERT_TRUE(parseJson("{\"a\" 1}", t) == DeserializationError::InvalidInput);
+    TEST_ASSERT_TRUE(parseJson("[[[1]]]", t, DeserializationOption::NestingLimit(2)) ==
+                     DeserializationError::TooDeep);
+
+    // Strings are limited by the fixed buffer instead of growing
+    std::string longString = "[\"" + std::string(ARDUINOJSON_EVENT_STRING_CAPACITY, 'x') + "\"]";
+    TEST_ASSERT_TRUE(parseJson(longString.c_str(), t) == DeserializationError::NoMemory);
+}
+
+static void randomValue(std::mt19937& rng, std::string& out, int depth) {
+    switch (depth > 3 ? rng() % 5 : rng() % 7) {
+        case 0: out += std::to_string(int(rng() % 2000000) - 1000000); break;
+        case 1: out += std::to_string(int(rng() % 100000) / 100.0); break;
+        case 2: out += "\"s" + std::to_string(rng() % 1000) + "\\n\\u00e9\""; break;
+        case 3: out += rng() % 2 ? "true" : "false"; break;
+        case 4: out += "null"; break;
+        case 5: {
+            out += '[';
+            for (int n = rng() % 6, i = 0; i < n; i++) {
+                if (i) out += ',';
+                randomValue(rng, out, depth + 1);
+            }
+            out += ']';
+            break;
+        }
+        default: {
+            out += '{';
+            for (int n = rng() % 6, i = 0; i < n; i++) {
+                if (i) out += ',';
+                out += "\"k" + std::to_string(i) + "\":";
+                randomValue(rng, out, depth + 1);
+            }
+            out += '}';
+        }
+    }
+}
+
+// Same values, same order as a JsonDocument
+static void test_matches_deserialize_json() {
+    std::mt19937 rng(28);
+    for (int i = 0; i < 500; i++) {
+        std::string json;
+        randomValue(rng, json, 0);
+
+        JsonDocument doc;
+        TEST_ASSERT_TRUE(deserializeJson(doc, json) == DeserializationError::Ok);
+        std::string expected;
+        trace(doc.as<JsonVariantConst>(), expected);
+
+        Trace t;
+        TEST_ASSERT_TRUE(parseJson(json.c_str(), t) == DeserializationError::Ok);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), t.out.c_str(), json.c_str());
+    }
+}
+
+// Shaped like the bar series from the backend: a running VWAP over them
+struct Vwap : JsonHandler<Vwap> {
+    enum { Other, Close, Volume } field = Other;
+    double close = 0, priceVolume = 0, volume = 0;
+    long bars = 0;
+
+    bool key(JsonString k) {
+        field = k == "c" ? Close : k == "v" ? Volume : Other;
+        return true;
+    }
+    bool number(JsonFloat x) {
+        if (field == Close) close = x;
+        if (field == Volume) {
+            priceVolume += close * x;
+            volume += x;
+            bars++;
+        }
+        field = Other;
+        return true;
+    }
+};
+
+static std::string bars(int count) {
+    std::string s = "{\"bars\":[";
+    for (int i = 0; i < count; i++) {
+        if (i) s += ',';
+        s += "{\"t\":\"2024-01-01T00:00:00Z\",\"o\":1.5,\"c\":" + std::to_string(100 + i % 7) +
+             ".25,\"v\":" + std::to_string(10 + i % 3) + ",\"x\":[true,false,null]}";
+    }
+    return s + "],\"next\":\"tok\"}";
+}
+
+static void test_multi_megabyte_input_without_allocating() {
+    std::string json = bars(60000);
+    TEST_ASSERT_GREATER_THAN(4000000, json.size());
+
+    size_t before = allocations;
+    Vwap h;
+    TEST_ASSERT_TRUE(parseJson(json.c_str(), h) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(0, allocations - before);
+    TEST_ASSERT_EQUAL(60000, h.bars);
+
+    // Weights 10, 11, 12 and closes 100.25..106.25 repeat every 21 bars
+    double pv = 0, v = 0;
+    for (int i = 0; i < 60000; i++) {
+        pv += (100.25 + i % 7) * (10 + i % 3);
+        v += 10 + i % 3;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, pv / v, h.priceVolume / h.volume);
+}
+
+// A stream is read one character at a time, with the same result
+static void test_stream_input() {
+    std::string json = bars(20000);
+    std::istringstream stream(json);
+    Vwap fromStream, fromString;
+    TEST_ASSERT_TRUE(parseJson(stream, fromStream) == DeserializationError::Ok);
+    TEST_ASSERT_TRUE(parseJson(json.c_str(), fromString) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(fromString.bars, fromStream.bars);
+    TEST_ASSERT_EQUAL_DOUBLE(fromString.priceVolume, fromStream.priceVolume);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_events_in_document_order);
+    RUN_TEST(test_unsigned_overflow_goes_to_number);
+    RUN_TEST(test_integers_default_to_number);
+    RUN_TEST(test_handler_can_stop);
+    RUN_TEST(test_reports_errors);
+    RUN_TEST(test_matches_deserialize_json);
+    RUN_TEST(test_multi_megabyte_input_without_allocating);
+    RUN_TEST(test_stream_input);
+    return UNITY_END();
+}
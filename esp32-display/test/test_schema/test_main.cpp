@@ -0,0 +1,226 @@
+// deserializeJson() with a JsonSchema: the telemetry message straight into a struct,
+// unknown keys, fields that overflow, nested objects, strings, count fields, and
+// no heap use at all
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <new>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+void setUp() {}
+void tearDown() {}
+
+struct Telemetry {
+    char type[12];
+    float btc_price;
+    float btc_change_24h;
+    double profit_usd;
+    int32_t profit_today;
+    char mode[8];
+    float sparkline[20];
+    uint8_t sparklineCount;
+    bool live;
+};
+
+static const JsonSchemaField telemetryFields[] = {
+    ARDUINOJSON_FIELD(Telemetry, type),
+    ARDUINOJSON_FIELD(Telemetry, btc_price),
+    ARDUINOJSON_FIELD(Telemetry, btc_change_24h),
+    ARDUINOJSON_FIELD(Telemetry, profit_usd),
+    ARDUINOJSON_FIELD(Telemetry, profit_today),
+    ARDUINOJSON_FIELD(Telemetry, mode),
+    ARDUINOJSON_ARRAY_FIELD(Telemetry, sparkline, sparklineCount),
+    ARDUINOJSON_NAMED_FIELD(Telemetry, live, "is_live"),
+};
+static const JsonSchema<Telemetry> telemetrySchema(telemetryFields);
+
+static DeserializationError::Code parse(Telemetry& t, const char* json) {
+    return deserializeJson(t, json, telemetrySchema).code();
+}
+
+static void test_telemetry_message() {
+    const char* json =
+        "{\"type\":\"telemetry\",\"btc_price\":64164.89,\"btc_change_24h\":-0.26,"
+        "\"profit_usd\":1234.5,\"profit_today\":-17,\"mode\":\"live\","
+        "\"sparkline\":[1,2.5,3],\"is_live\":true}";
+    Telemetry t = {};
+    allocations = 0;
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, parse(t, json));
+    TEST_ASSERT_EQUAL(0, allocations);
+
+    TEST_ASSERT_EQUAL_STRING("telemetry", t.type);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 64164.89f, t.btc_price);
+    TEST_ASSERT_EQUAL_FLOAT(-0.26f, t.btc_change_24h);
+    TEST_ASSERT_EQUAL_DOUBLE(1234.5, t.profit_usd);
+    TEST_ASSERT_EQUAL(-17, t.profit_today);
+    TEST_ASSERT_EQUAL_STRING("live", t.mode);
+    TEST_ASSERT_EQUAL(3, t.sparklineCount);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, t.sparkline[1]);
+    TEST_ASSERT_TRUE(t.live);
+
+    // Members may come in any order, missing ones and nulls are left alone
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      parse(t, " { \"mode\" : \"paper\", \"btc_price\": null } "));
+    TEST_ASSERT_EQUAL_STRING("paper", t.mode);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 64164.89f, t.btc_price);
+    TEST_ASSERT_EQUAL_STRING("telemetry", t.type);
+}
+
+static void test_empty_and_not_an_object() {
+    Telemetry t = {};
+    TEST_ASSERT_EQUAL(DeserializationError::EmptyInput, parse(t, ""));
+    TEST_ASSERT_EQUAL(DeserializationError::EmptyInput, parse(t, "  \r\n"));
+    TEST_ASSERT_EQUAL(DeserializationError::EmptyInput,
+                      deserializeJson(t, "{}", 0, telemetrySchema).code());
+    TEST_ASSERT_EQUAL(DeserializationError::EmptyInput,
+                      deserializeJson(t, std::string(), telemetrySchema).code());
+    std::istringstream stream(" ");
+    TEST_ASSERT_EQUAL(DeserializationError::EmptyInput,
+                      deserializeJson(t, stream, telemetrySchema).code());
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "[1,2]"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "42"));
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput, parse(t, "{\"mode\":"));
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, parse(t, "{}"));
+}
+
+static void test_unknown_keys() {
+    Telemetry t = {};
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"price\":1}"));
+    // Same length and first letter as a field
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"mods\":\"x\"}"));
+    // Longer than any field name, and than the key buffer
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      parse(t, "{\"a_key_much_longer_than_any_field_of_the_schema\":1}"));
+    // A field name under another key
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"live\":true}"));
+}
+
+static void test_field_overflow() {
+    Telemetry t = {};
+    // char[8] holds 7 characters
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, parse(t, "{\"mode\":\"1234567\"}"));
+    TEST_ASSERT_EQUAL_STRING("1234567", t.mode);
+    TEST_ASSERT_EQUAL(DeserializationError::NoMemory, parse(t, "{\"mode\":\"12345678\"}"));
+    TEST_ASSERT_EQUAL('\0', t.mode[sizeof(t.mode) - 1]);
+
+    // 20 elements fit, the 21st doesn't
+    std::string spark = "{\"sparkline\":[0";
+    for (int i = 1; i < 20; i++) spark += "," + std::to_string(i);
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, parse(t, (spark + "]}").c_str()));
+    TEST_ASSERT_EQUAL(20, t.sparklineCount);
+    TEST_ASSERT_EQUAL_FLOAT(19, t.sparkline[19]);
+    TEST_ASSERT_EQUAL(DeserializationError::NoMemory, parse(t, (spark + ",20]}").c_str()));
+
+    // Numbers out of range or not integers for integer fields
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      parse(t, "{\"profit_today\":3000000000}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"profit_today\":1.5}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"btc_price\":\"1\"}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"is_live\":1}"));
+}
+
+// Fields are scalars, strings or arrays of scalars: a nested object or array where a
+// value is expected is rejected, and nesting counts towards the limit
+static void test_nested_objects() {
+    Telemetry t = {};
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      parse(t, "{\"btc_price\":{\"usd\":1}}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"mode\":{}}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      parse(t, "{\"sparkline\":[{\"v\":1}]}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"sparkline\":[[1]]}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"btc_price\":[1]}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"sparkline\":1}"));
+
+    TEST_ASSERT_EQUAL(DeserializationError::TooDeep,
+                      deserializeJson(t, "{\"sparkline\":[1]}", telemetrySchema,
+                                      DeserializationOption::NestingLimit(1)).code());
+    TEST_ASSERT_EQUAL(DeserializationError::TooDeep,
+                      deserializeJson(t, "{}", telemetrySchema,
+                                      DeserializationOption::NestingLimit(0)).code());
+}
+
+static void test_strings() {
+    Telemetry t = {};
+    TEST_ASSERT_EQUAL(DeserializationError::Ok,
+                      parse(t, "{'type':'a\\tb\\\"c','mode':\"\\u00e9\\u20AC\"}"));
+    TEST_ASSERT_EQUAL_STRING("a\tb\"c", t.type);
+    TEST_ASSERT_EQUAL_STRING("\xC3\xA9\xE2\x82\xAC", t.mode);
+
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, parse(t, "{\"mode\":\"\"}"));
+    TEST_ASSERT_EQUAL_STRING("", t.mode);
+    // Escapes count once unescaped: 5 UTF-8 bytes and 2 letters fill char[8]
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, parse(t, "{\"mode\":\"\\u00e9\\u20ACab\"}"));
+    TEST_ASSERT_EQUAL(DeserializationError::NoMemory,
+                      parse(t, "{\"mode\":\"\\u00e9\\u20ACabc\"}"));
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput, parse(t, "{\"mode\":42}"));
+    TEST_ASSERT_EQUAL(DeserializationError::IncompleteInput, parse(t, "{\"mode\":\"live"));
+}
+
+static void test_count_fields() {
+    struct Counts {
+        int8_t a[4];
+        uint8_t aCount;
+        uint16_t b[300];
+        uint16_t bCount;
+        double c[2];
+        uint32_t cCount;
+        bool d[3];  // No count
+    };
+    static const JsonSchemaField fields[] = {
+        ARDUINOJSON_ARRAY_FIELD(Counts, a, aCount),
+        ARDUINOJSON_ARRAY_FIELD(Counts, b, bCount),
+        ARDUINOJSON_ARRAY_FIELD(Counts, c, cCount),
+        ARDUINOJSON_FIELD(Counts, d),
+    };
+    static const JsonSchema<Counts> schema(fields);
+
+    Counts c;
+    memset(&c, 0xAA, sizeof(c));
+    std::string b = "[0";
+    for (int i = 1; i < 300; i++) b += "," + std::to_string(i * 200);
+    std::string json = "{\"a\":[-128,127],\"b\":" + b + "],\"c\":[],\"d\":[true,false]}";
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, deserializeJson(c, json, schema).code());
+    TEST_ASSERT_EQUAL(2, c.aCount);
+    TEST_ASSERT_EQUAL(-128, c.a[0]);
+    TEST_ASSERT_EQUAL(127, c.a[1]);
+    TEST_ASSERT_EQUAL(300, c.bCount);
+    TEST_ASSERT_EQUAL(59800, c.b[299]);
+    TEST_ASSERT_EQUAL(0, c.cCount);
+    TEST_ASSERT_TRUE(c.d[0]);
+    TEST_ASSERT_FALSE(c.d[1]);
+
+    // A later message sets the count again
+    TEST_ASSERT_EQUAL(DeserializationError::Ok, deserializeJson(c, "{\"a\":[1]}", schema).code());
+    TEST_ASSERT_EQUAL(1, c.aCount);
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      deserializeJson(c, "{\"a\":[128]}", schema).code());
+    TEST_ASSERT_EQUAL(DeserializationError::InvalidInput,
+                      deserializeJson(c, "{\"b\":[-1]}", schema).code());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_telemetry_message);
+    RUN_TEST(test_empty_and_not_an_object);
+    RUN_TEST(test_unknown_keys);
+    RUN_TEST(test_field_overflow);
+    RUN_TEST(test_nested_objects);
+    RUN_TEST(test_strings);
+    RUN_TEST(test_count_fields);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+// Floats printed with ARDUINOJSON_SHORTEST_FLOAT must read back as the same value
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <math.h>
+#include <random>
+#include <stdlib.h>
+#include <string.h>
+
+void setUp() {}
+void tearDown() {}
+
+static const char* print(double value) {
+    static char buf[64];
+    JsonDocument doc;
+    doc.set(value);
+    buf[serializeJson(doc, buf, sizeof(buf) - 1)] = 0;
+    return buf;
+}
+
+static const char* print(float value) {
+    static char buf[64];
+    JsonDocument doc;
+    doc.set(value);
+    buf[serializeJson(doc, buf, sizeof(buf) - 1)] = 0;
+    return buf;
+}
+
+// A double that a float holds exactly is stored, and printed, as a float
+static bool readsBack(double d) {
+    const char* text = print(d);
+    if (float(d) == d) return strtof(text, nullptr) == float(d);
+    return strtod(text, nullptr) == d;
+}
+
+static void test_prints_shortest_form() {
+    TEST_ASSERT_EQUAL_STRING("0.1", print(0.1));
+    TEST_ASSERT_EQUAL_STRING("0.1", print(0.1f));
+    TEST_ASSERT_EQUAL_STRING("67123.45", print(67123.45));
+    TEST_ASSERT_EQUAL_STRING("1.5", print(1.5f));
+    TEST_ASSERT_EQUAL_STRING("-0.5", print(-0.5));
+    TEST_ASSERT_EQUAL_STRING("100", print(100.0));
+    TEST_ASSERT_EQUAL_STRING("0.001", print(0.001));
+    TEST_ASSERT_EQUAL_STRING("0", print(0.0));
+}
+
+static void test_extremes_round_trip() {
+    const double doubles[] = {5e-324, 2.2250738585072014e-308, 1.7976931348623157e308,
+                              1e-7, 1e7, 123456789.0, 9007199254740993.0, 0.3};
+    for (double d : doubles) TEST_ASSERT_TRUE_MESSAGE(readsBack(d), print(d));
+
+    const float floats[] = {1e-45f, 1.17549435e-38f, 3.4028235e38f, 16777217.0f, 0.3f};
+    for (float f : floats) TEST_ASSERT_EQUAL_FLOAT(f, strtof(print(f), nullptr));
+}
+
+// Every finite bit pattern is fair game, including subnormals
+static void test_random_doubles_round_trip() {
+    std::mt19937_64 rng(42);
+    int checked = 0;
+    while (checked < 200000) {
+        uint64_t bits = rng();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (!isfinite(d)) continue;
+        if (!readsBack(d)) TEST_FAIL_MESSAGE(print(d));
+        checked++;
+    }
+}
+
+static void test_powers_of_two_round_trip() {
+    for (int e = -1074; e <= 1023; e++) {
+        double d = ldexp(1.0, e);
+        TEST_ASSERT_TRUE_MESSAGE(readsBack(d), print(d));
+    }
+    for (int e = -149; e <= 127; e++) {
+        float f = ldexpf(1.0f, e);
+        TEST_ASSERT_EQUAL_FLOAT(f, strtof(print(f), nullptr));
+    }
+}
+
+static void test_random_floats_round_trip() {
+    std::mt19937 rng(7);
+    int checked = 0;
+    while (checked < 200000) {
+        uint32_t bits = rng();
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        if (!isfinite(f)) continue;
+        const char* text = print(f);
+        if (strtof(text, nullptr) != f) TEST_FAIL_MESSAGE(text);
+        checked++;
+    }
+}
+
+// Typical telemetry values: a few decimals in a small range
+static void test_decimal_values_round_trip() {
+    for (int i = -100000; i <= 100000; i += 7) {
+        double d = i / 100.0;
+        TEST_ASSERT_TRUE_MESSAGE(readsBack(d), print(d));
+        float f = i / 1000.0f;
+        TEST_ASSERT_EQUAL_FLOAT(f, strtof(print(f), nullptr));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_prints_shortest_form);
+    RUN_TEST(test_extremes_round_trip);
+    RUN_TEST(test_random_doubles_round_trip);
+    RUN_TEST(test_powers_of_two_round_trip);
+    RUN_TEST(test_random_floats_round_trip);
+    RUN_TEST(test_decimal_values_round_trip);
+    return UNITY_END();
+}
@@ -0,0 +1,212 @@
+// TFT_eSprite::scroll() at 1 and 4 bpp and the moveBits() it moves lines with: random
+// bit moves within and between lines, and random scrolls of whole sprites and of
+// partial scroll rects, odd and even shifts, checked against a pixel by pixel
+// reference, and the rotated 1 bpp pixel loop scrolling right
+#include <host_tft.h>
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static bool bitAt(const uint8_t* line, uint32_t b) { return line[b >> 3] & (0x80 >> (b & 7)); }
+
+static void setBit(uint8_t* line, uint32_t b, bool v) {
+    if (v) line[b >> 3] |= 0x80 >> (b & 7);
+    else   line[b >> 3] &= ~(0x80 >> (b & 7));
+}
+
+// Moves n bits from bit fb of from to bit tb of to, a copy of the source is taken
+// first so the lines may overlap
+static void referenceMove(uint8_t* to, uint32_t tb, const uint8_t* from, uint32_t fb, uint32_t n,
+                          size_t size) {
+    std::vector<uint8_t> copy(from, from + size);
+    for (uint32_t i = 0; i < n; i++) setBit(to, tb + i, bitAt(copy.data(), fb + i));
+}
+
+static void test_move_bits() {
+    srand(11);
+    const size_t size = 24;
+    uint8_t buffer[2 * size + 2], expected[2 * size + 2];
+    char message[96];
+    for (int i = 0; i < 100000; i++) {
+        for (uint8_t& b : buffer) b = rand();
+        memcpy(expected, buffer, sizeof(buffer));
+        // Guard bytes on either side must not be touched
+        uint8_t* a = buffer + 1;
+        uint8_t* b = (i & 1) ? a : buffer + 1 + size;
+        uint8_t* ea = expected + 1;
+        uint8_t* eb = (i & 1) ? ea : expected + 1 + size;
+        uint32_t n  = rand() % (8 * size + 1);
+        uint32_t tb = rand() % (8 * size - n + 1);
+        uint32_t fb = rand() % (8 * size - n + 1);
+        // The same bit within a byte takes the memmove path
+        uint32_t aligned = (fb & ~7u) | (tb & 7);
+        if (i % 4 == 0 && aligned <= 8 * size - n) fb = aligned;
+
+        moveBits(b, tb, a, fb, n);
+        referenceMove(eb, tb, ea, fb, n, size);
+        if (memcmp(buffer, expected, sizeof(buffer)) != 0) {
+            snprintf(message, sizeof(message), "%s line: %u bits from %u to %u",
+                     (i & 1) ? "same" : "other", unsigned(n), unsigned(fb), unsigned(tb));
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+}
+
+// Short moves at every bit offset, where the head and tail masks meet
+static void test_move_bits_within_a_byte() {
+    for (uint32_t tb = 0; tb < 16; tb++) {
+        for (uint32_t fb = 0; fb < 16; fb++) {
+            for (uint32_t n = 0; n <= 9; n++) {
+                uint8_t line[4] = {0xA5, 0x3C, 0x96, 0x0F}, expected[4];
+                memcpy(expected, line, sizeof(line));
+                moveBits(line, tb, line, fb, n);
+                referenceMove(expected, tb, expected, fb, n, sizeof(expected));
+                TEST_ASSERT_EQUAL_MEMORY(expected, line, sizeof(line));
+            }
+        }
+    }
+}
+
+// The sprite as pixel values
+typedef std::vector<std::vector<uint8_t>> Pixels;
+
+static Pixels read(TFT_eSprite& sprite) {
+    Pixels p(sprite.height(), std::vector<uint8_t>(sprite.width()));
+    for (int y = 0; y < sprite.height(); y++)
+        for (int x = 0; x < sprite.width(); x++) p[y][x] = sprite.readPixelValue(x, y);
+    return p;
+}
+
+static void fillRandom(TFT_eSprite& sprite, int bpp) {
+    for (int y = 0; y < sprite.height(); y++)
+        for (int x = 0; x < sprite.width(); x++) sprite.drawPixel(x, y, rand() % (1 << bpp));
+}
+
+// What scroll(dx, dy) should do to the rect
+static void referenceScroll(Pixels& p, int sx, int sy, int sw, int sh, int dx, int dy, uint8_t fill) {
+    Pixels old = p;
+    for (int y = sy; y < sy + sh; y++) {
+        for (int x = sx; x < sx + sw; x++) {
+            int fx = x - dx, fy = y - dy;
+            bool inside = fx >= sx && fx < sx + sw && fy >= sy && fy < sy + sh;
+            p[y][x] = inside ? old[fy][fx] : fill;
+        }
+    }
+}
+
+static void checkScrolls(int bpp, int rotation, int width, int height, int rounds) {
+    TFT_eSPI tft;
+    TFT_eSprite sprite(&tft);
+    sprite.setColorDepth(bpp);
+    TEST_ASSERT_NOT_NULL(sprite.createSprite(width, height));
+    sprite.setRotation(rotation);
+    char message[96];
+
+    for (int i = 0; i < rounds; i++) {
+        fillRandom(sprite, bpp);
+        int sx = 0, sy = 0, sw = sprite.width(), sh = sprite.height();
+        if (i % 3) {  // A partial scroll rect
+            sx = rand() % sw;
+            sy = rand() % sh;
+            sw = 1 + rand() % (sw - sx);
+            sh = 1 + rand() % (sh - sy);
+        }
+        uint8_t fill = rand() % (1 << bpp);
+        sprite.setScrollRect(sx, sy, sw, sh, fill);
+
+        int dx = rand() % (2 * sw + 1) - sw;
+        int dy = (i % 4 == 0) ? 0 : rand() % (2 * sh + 1) - sh;
+        if (i % 5 == 0) dx &= ~1;  // Even shifts keep 4 bpp pixels in the same nibble
+
+        Pixels expected = read(sprite);
+        referenceScroll(expected, sx, sy, sw, sh, dx, dy, fill);
+        sprite.scroll(dx, dy);
+        if (read(sprite) != expected) {
+            snprintf(message, sizeof(message), "%d bpp, rotation %d: rect %d,%d %dx%d by %d,%d",
+                     bpp, rotation, sx, sy, sw, sh, dx, dy);
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+    sprite.deleteSprite();
+}
+
+static void test_scroll_4bpp() {
+    srand(4);
+    checkScrolls(4, 0, 64, 20, 3000);
+    checkScrolls(4, 0, 37, 11, 3000);  // Odd width, the lines are padded to a byte
+}
+
+static void test_scroll_1bpp() {
+    srand(1);
+    checkScrolls(1, 0, 64, 20, 3000);
+    checkScrolls(1, 0, 37, 11, 3000);  // Lines padded to 40 bits
+}
+
+// Rotated 1 bpp sprites keep the pixel loop
+static void test_scroll_1bpp_rotated() {
+    srand(2);
+    for (int rotation = 1; rotation < 4; rotation++) checkScrolls(1, rotation, 40, 40, 1000);
+}
+
+// Scrolling right used to write one pixel past the rect and leave its first pixel
+static void test_rotated_scroll_right_stays_in_the_rect() {
+    TFT_eSPI tft;
+    TFT_eSprite sprite(&tft);
+    sprite.setColorDepth(1);
+    sprite.createSprite(16, 16);
+    sprite.setRotation(1);
+    sprite.fillSprite(0);
+    sprite.drawPixel(4, 5, 1);
+    sprite.drawPixel(11, 5, 1);  // The last pixel of the rect
+    sprite.drawPixel(12, 5, 1);  // Just outside it
+    sprite.setScrollRect(4, 4, 8, 4, 0);
+    sprite.scroll(1, 0);
+
+    TEST_ASSERT_EQUAL(0, sprite.readPixelValue(4, 5));   // Filled
+    TEST_ASSERT_EQUAL(1, sprite.readPixelValue(5, 5));   // Moved
+    TEST_ASSERT_EQUAL(0, sprite.readPixelValue(11, 5));  // Moved out
+    TEST_ASSERT_EQUAL(1, sprite.readPixelValue(12, 5));  // Left alone
+    TEST_ASSERT_EQUAL(0, sprite.readPixelValue(13, 5));
+    sprite.deleteSprite();
+}
+
+// A shift as large as the rect clears it, and no shift leaves it alone
+static void test_scroll_limits() {
+    for (int bpp : {1, 4}) {
+        TFT_eSPI tft;
+        TFT_eSprite sprite(&tft);
+        sprite.setColorDepth(bpp);
+        sprite.createSprite(24, 8);
+        fillRandom(sprite, bpp);
+        sprite.setScrollRect(2, 1, 20, 6, 1);
+        Pixels before = read(sprite);
+        sprite.scroll(0, 0);
+        TEST_ASSERT_TRUE(before == read(sprite));
+
+        for (int d : {20, -20, 25}) {
+            Pixels expected = read(sprite);
+            referenceScroll(expected, 2, 1, 20, 6, d, 0, 1);
+            sprite.scroll(d, 0);
+            TEST_ASSERT_TRUE(expected == read(sprite));
+        }
+        sprite.deleteSprite();
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_move_bits);
+    RUN_TEST(test_move_bits_within_a_byte);
+    RUN_TEST(test_scroll_4bpp);
+    RUN_TEST(test_scroll_1bpp);
+    RUN_TEST(test_scroll_1bpp_rotated);
+    RUN_TEST(test_rotated_scroll_right_stays_in_the_rect);
+    RUN_TEST(test_scroll_limits);
+    return UNITY_END();
+}
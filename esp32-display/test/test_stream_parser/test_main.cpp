@@ -0,0 +1,214 @@
+// JsonStreamParser fed in random pieces must give what deserializeJson() gives for
+// the whole input, and must hand back whatever follows a complete value
+#include <ArduinoJson.h>
+#include <unity.h>
+
+#include <random>
+#include <string>
+#include <string.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Writes every event as text
+struct Trace : JsonHandler<Trace> {
+    std::string out;
+    int stopAfter = -1;  // Stops on this event when not negative
+
+    bool event(const std::string& text) {
+        out += text;
+        return stopAfter < 0 || --stopAfter > 0;
+    }
+    bool startObject() { return event("{"); }
+    bool endObject() { return event("}"); }
+    bool startArray() { return event("["); }
+    bool endArray() { return event("]"); }
+    bool key(JsonString k) { return event("k:" + std::string(k.c_str(), k.size()) + ","); }
+    bool string(JsonString s) { return event("s:" + std::string(s.c_str(), s.size()) + ","); }
+    bool number(JsonFloat x) { return event("f:" + std::to_string(x) + ","); }
+    bool integer(JsonInteger x) { return event("i:" + std::to_string(x) + ","); }
+    bool boolean(bool b) { return event(b ? "t," : "F,"); }
+    bool null() { return event("n,"); }
+};
+
+static const char* samples[] = {
+    "{\"temp\":21.5,\"hum\":45,\"ok\":true,\"none\":null,\"arr\":[1,-2,3.5e3,"
+    "\"x\\ny\\u00e9\\ud83d\\ude00\",[],{}],\"nested\":{\"a\":{\"b\":[false,{\"c\":\"d\"}]}}}",
+    "[1,2,3]",
+    "  42",
+    "\"hello\"",
+    "{a:1,'b':'c'}",
+    "{\"a\":1,\"a\":null}",
+    "-0.5e-3",
+    "[{\"id\":18446744073709551615,\"v\":-9223372036854775808}]",
+    "[1,]",
+    "{\"a\" 1}",
+    "[tru]",
+    "{\"a\":1",
+    "[1 2]",
+    "\"\\x\"",
+    "}",
+    "[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]",
+};
+
+static void randomValue(std::mt19937& rng, std::string& out, int depth) {
+    switch (depth > 3 ? rng() % 5 : rng() % 7) {
+        case 0: out += std::to_string(int(rng() % 2000000) - 1000000); break;
+        case 1: out += std::to_string(int(rng() % 100000) / 100.0); break;
+        case 2: out += "\"s" + std::to_string(rng() % 1000) + "\\t\\u00e9\""; break;
+        case 3: out += rng() % 2 ? "true" : "false"; break;
+        case 4: out += "null"; break;
+        case 5:
+            out += '[';
+            for (int n = rng() % 6, i = 0; i < n; i++) {
+                if (i) out += ", ";
+                randomValue(rng, out, depth + 1);
+            }
+            out += ']';
+            break;
+        default:
+            out += '{';
+            for (int n = rng() % 6, i = 0; i < n; i++) {
+                if (i) out += ',';
+                out += "\"k" + std::to_string(i) + "\" : ";
+                randomValue(rng, out, depth + 1);
+            }
+            out += '}';
+    }
+}
+
+// Feeds the input in pieces of 1 to maxPiece bytes, then end()
+template <typename TParser>
+static DeserializationError feedInPieces(TParser& parser, const std::string& json,
+                                         std::mt19937& rng, size_t maxPiece) {
+    DeserializationError err = DeserializationError::IncompleteInput;
+    for (size_t i = 0; i < json.size() && err == DeserializationError::IncompleteInput;) {
+        size_t n = 1 + rng() % maxPiece;
+        if (n > json.size() - i) n = json.size() - i;
+        err = parser.feed(json.data() + i, n);
+        i += n;
+    }
+    if (err == DeserializationError::IncompleteInput) err = parser.end();
+    return err;
+}
+
+static void checkSplits(const std::string& json, std::mt19937& rng) {
+    JsonDocument expected;
+    DeserializationError expectedErr = deserializeJson(expected, json);
+    std::string expectedText;
+    serializeJson(expected, expectedText);
+
+    Trace expectedTrace;
+    parseJson(json.c_str(), expectedTrace);
+
+    for (size_t maxPiece : {1, 3, 8, 64}) {
+        JsonDocument doc;
+        JsonStreamParser<JsonDocument> parser(doc);
+        DeserializationError err = feedInPieces(parser, json, rng, maxPiece);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expectedErr.c_str(), err.c_str(), json.c_str());
+        if (!err) {
+            std::string text;
+            serializeJson(doc, text);
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(expectedText.c_str(), text.c_str(), json.c_str());
+        }
+
+        Trace trace;
+        JsonStreamParser<Trace> events(trace);
+        err = feedInPieces(events, json, rng, maxPiece);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expectedErr.c_str(), err.c_str(), json.c_str());
+        if (!err)
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(expectedTrace.out.c_str(), trace.out.c_str(),
+                                             json.c_str());
+    }
+}
+
+static void test_samples_split_anywhere() {
+    std::mt19937 rng(29);
+    for (const char* json : samples)
+        for (int i = 0; i < 50; i++) checkSplits(json, rng);
+}
+
+static void test_random_documents_split_anywhere() {
+    std::mt19937 rng(290);
+    for (int i = 0; i < 1000; i++) {
+        std::string json;
+        randomValue(rng, json, 0);
+        checkSplits(json, rng);
+    }
+}
+
+// Two messages in one piece: the second starts at consumed()
+static void test_two_values_in_one_piece() {
+    const char piece[] = "{\"a\":1} [true,2]";
+    JsonDocument doc;
+    JsonStreamParser<JsonDocument> parser(doc);
+
+    TEST_ASSERT_TRUE(parser.feed(piece, strlen(piece)) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(7, parser.consumed());
+    TEST_ASSERT_EQUAL(1, doc["a"].as<int>());
+
+    parser.reset();
+    const char* rest = piece + parser.consumed();
+    TEST_ASSERT_TRUE(parser.feed(rest, strlen(rest)) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(strlen(rest), parser.consumed());
+    TEST_ASSERT_TRUE(doc[0].as<bool>());
+    TEST_ASSERT_EQUAL(2, doc[1].as<int>());
+}
+
+// A number at the root ends at the first byte that can't be in it
+static void test_root_numbers_in_one_piece() {
+    Trace trace;
+    JsonStreamParser<Trace> parser(trace);
+    const char piece[] = "12 34";
+
+    TEST_ASSERT_TRUE(parser.feed(piece, 5) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(2, parser.consumed());
+
+    parser.reset();
+    TEST_ASSERT_TRUE(parser.feed(piece + 2, 3) == DeserializationError::IncompleteInput);
+    TEST_ASSERT_EQUAL(3, parser.consumed());
+    TEST_ASSERT_TRUE(parser.end() == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("i:12,i:34,", trace.out.c_str());
+}
+
+// A handler that stops leaves the rest of the piece unread
+static void test_stop_then_reset() {
+    Trace trace;
+    trace.stopAfter = 2;
+    JsonStreamParser<Trace> parser(trace);
+
+    TEST_ASSERT_TRUE(parser.feed("[1,2,3]", 7) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(2, parser.consumed());  // The ',' that ended the number is left
+    TEST_ASSERT_EQUAL_STRING("[i:1,", trace.out.c_str());
+
+    // The stop must not hide the errors of the next message
+    parser.reset();
+    trace.stopAfter = -1;
+    TEST_ASSERT_TRUE(parser.feed("[1,]", 4) == DeserializationError::InvalidInput);
+
+    parser.reset();
+    trace.out.clear();
+    TEST_ASSERT_TRUE(parser.feed("[\"ab\",{\"c\":", 11) == DeserializationError::IncompleteInput);
+    parser.reset();
+    trace.out.clear();
+    TEST_ASSERT_TRUE(parser.feed("{\"x\":\"y\"}", 9) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("{k:x,s:y,}", trace.out.c_str());
+}
+
+static void test_error_points_at_the_bad_byte() {
+    JsonDocument doc;
+    JsonStreamParser<JsonDocument> parser(doc);
+    TEST_ASSERT_TRUE(parser.feed("[1,2 x]", 7) == DeserializationError::InvalidInput);
+    TEST_ASSERT_EQUAL(5, parser.consumed());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_samples_split_anywhere);
+    RUN_TEST(test_random_documents_split_anywhere);
+    RUN_TEST(test_two_values_in_one_piece);
+    RUN_TEST(test_root_numbers_in_one_piece);
+    RUN_TEST(test_stop_then_reset);
+    RUN_TEST(test_error_points_at_the_bad_byte);
+    return UNITY_END();
+}
@@ -0,0 +1,159 @@
+// Ticker on the emulated panel: the scroll area and start line it sends, the band as
+// seen on screen after each step against the text rows it should show, and the
+// commands and bytes a step costs
+#include <host_tft.h>
+#include <unity.h>
+
+#include <ticker.h>
+#include "../../src/ticker.cpp"
+
+#include <stdio.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+// The firmware band, with the GLCD font, as the numbered fonts keep 32-bit pointers
+static const int16_t bandX = 16, bandY = 270, bandW = 208, bandH = 32, pitch = 10;
+static const uint16_t fg = TFT_WHITE, bg = TFT_NAVY;
+static const char* items[] = {"Bot: running", "BTC 64,164.89", "Profit +0.26%", "Mode: live"};
+static const int itemCount = 4;
+
+struct Fixture {
+    HostPanel panel;
+    TFT_eSPI tft;
+    Ticker ticker{tft};
+    TFT_eSprite rows{&tft};  // Every item, pitch lines each, as the band should show it
+
+    Fixture() {
+        tft.init();
+        tft.fillScreen(bg);
+        TEST_ASSERT_TRUE(ticker.begin(bandX, bandY, bandW, bandH, fg, bg, 1, pitch));
+        for (int i = 0; i < itemCount; i++) ticker.setItem(i, items[i]);
+
+        rows.setColorDepth(16);
+        TEST_ASSERT_NOT_NULL(rows.createSprite(bandW, pitch * itemCount));
+        rows.fillSprite(bg);
+        rows.setTextColor(fg);
+        rows.setTextDatum(TC_DATUM);
+        for (int i = 0; i < itemCount; i++) rows.drawString(items[i], bandW / 2, i * pitch, 1);
+    }
+
+    // The band on screen shows text rows top to top + bandH, the rest is untouched
+    void checkScreen(uint32_t top) {
+        for (int y = 0; y < HostPanel::height; y++) {
+            bool inBand = y >= bandY && y < bandY + bandH;
+            int row = (top + y - bandY) % (pitch * itemCount);
+            for (int x = 0; x < HostPanel::width; x++) {
+                bool text = inBand && x >= bandX && x < bandX + bandW;
+                uint16_t expect = text ? rows.readPixel(x - bandX, row) : bg;
+                if (panel.shown(x, y) != expect) {
+                    char message[80];
+                    snprintf(message, sizeof(message), "top %u: pixel %d,%d", top, x, y);
+                    TEST_FAIL_MESSAGE(message);
+                }
+            }
+        }
+    }
+
+    std::vector<HostPanel::Command> commands(uint8_t code) const {
+        std::vector<HostPanel::Command> found;
+        for (const HostPanel::Command& c : panel.log)
+            if (c.code == code) found.push_back(c);
+        return found;
+    }
+};
+
+static std::vector<uint8_t> words(std::initializer_list<uint16_t> values) {
+    std::vector<uint8_t> bytes;
+    for (uint16_t v : values) {
+        bytes.push_back(v >> 8);
+        bytes.push_back(v & 0xFF);
+    }
+    return bytes;
+}
+
+static void test_start_sets_the_scroll_area() {
+    Fixture f;
+    f.panel.logging = true;
+    f.ticker.start();
+
+    // VSCRDEF first, then the band drawn a line at a time, then the start line
+    TEST_ASSERT_EQUAL_HEX8(0x33, f.panel.log.front().code);
+    TEST_ASSERT_TRUE(words({bandY, bandH, HostPanel::height - bandY - bandH}) ==
+                     f.panel.log.front().params);
+    TEST_ASSERT_EQUAL_HEX8(0x37, f.panel.log.back().code);
+    TEST_ASSERT_TRUE(words({bandY}) == f.panel.log.back().params);
+    TEST_ASSERT_EQUAL(1, f.commands(0x33).size());
+    TEST_ASSERT_EQUAL(1, f.commands(0x37).size());
+    TEST_ASSERT_EQUAL(bandH, f.commands(0x2C).size());
+    f.checkScreen(0);
+
+    f.panel.clearStats();
+    f.ticker.stop();
+    TEST_ASSERT_EQUAL(2, f.panel.log.size());
+    TEST_ASSERT_TRUE(words({0, HostPanel::height, 0}) == f.commands(0x33)[0].params);
+    TEST_ASSERT_TRUE(words({0}) == f.commands(0x37)[0].params);
+    TEST_ASSERT_FALSE(f.ticker.running());
+}
+
+// Every step from the first item round to it again: one line of pixels and the new
+// start line, and the band shows the next row of text
+static void test_step_sends_one_line_and_the_start_line() {
+    Fixture f;
+    f.ticker.start();
+    f.panel.logging = true;
+    const uint32_t steps = pitch * itemCount + bandH;
+    uint32_t maxBytes = 0;
+    for (uint32_t top = 1; top <= steps; top++) {
+        f.panel.clearStats();
+        host::advance(f.ticker.stepMs);
+        TEST_ASSERT_TRUE(f.ticker.update(millis()));
+        TEST_ASSERT_FALSE(f.ticker.update(millis()));
+
+        // CASET, PASET and RAMWR for the line coming in, then VSCRSADD
+        TEST_ASSERT_EQUAL(4, f.panel.log.size());
+        TEST_ASSERT_EQUAL_HEX8(0x2A, f.panel.log[0].code);
+        TEST_ASSERT_TRUE(words({bandX, bandX + bandW - 1}) == f.panel.log[0].params);
+        uint16_t line = bandY + (top + bandH - 1) % bandH;
+        TEST_ASSERT_EQUAL_HEX8(0x2B, f.panel.log[1].code);
+        TEST_ASSERT_TRUE(words({line, line}) == f.panel.log[1].params);
+        TEST_ASSERT_EQUAL_HEX8(0x2C, f.panel.log[2].code);
+        TEST_ASSERT_EQUAL(bandW, f.panel.log[2].pixels);
+        TEST_ASSERT_EQUAL_HEX8(0x37, f.panel.log[3].code);
+        TEST_ASSERT_TRUE(words({uint16_t(bandY + top % bandH)}) == f.panel.log[3].params);
+        TEST_ASSERT_EQUAL(1, f.panel.stats.transactions);
+        f.checkScreen(top);
+        if (f.panel.stats.bytes() > maxBytes) maxBytes = f.panel.stats.bytes();
+    }
+
+    // Against redrawing the band each step
+    uint32_t redraw = 11 + 2 * bandW * bandH;
+    TEST_ASSERT_EQUAL(4 + 10 + 2 * bandW, maxBytes);
+    char message[120];
+    snprintf(message, sizeof(message), "per step %u bytes in 4 commands (%u to redraw the band)",
+             maxBytes, redraw);
+    TEST_MESSAGE(message);
+}
+
+// A slow loop skips steps instead of sending several at once
+static void test_late_update_skips_steps() {
+    Fixture f;
+    f.ticker.start();
+    host::advance(5 * f.ticker.stepMs);
+    TEST_ASSERT_TRUE(f.ticker.update(millis()));
+    TEST_ASSERT_FALSE(f.ticker.update(millis()));
+    host::advance(f.ticker.stepMs - 1);
+    TEST_ASSERT_FALSE(f.ticker.update(millis()));
+    host::advance(1);
+    TEST_ASSERT_TRUE(f.ticker.update(millis()));
+    f.checkScreen(2);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_start_sets_the_scroll_area);
+    RUN_TEST(test_step_sends_one_line_and_the_start_line);
+    RUN_TEST(test_late_update_skips_steps);
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+// TFT_eSPI_TouchSampler fed synthetic XPT2046 streams: idle noise, a noisy press, a
+// drag, pressure sag and dropouts, release, and a full event queue
+#include <Arduino.h>
+#include <unity.h>
+
+#include <Extensions/Touch_Sampler.h>
+#include <Extensions/Touch_Sampler.cpp>
+
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static const uint16_t threshold = 600;
+
+struct Sample {
+    uint16_t x, y, z;
+};
+
+// Feeds the samples 5 ms apart from time t, reading the queue after each one like
+// the display loop does, returns the events that came out
+static std::vector<touch_event_t> feed(TFT_eSPI_TouchSampler& sampler,
+                                       const std::vector<Sample>& samples, uint32_t& t) {
+    std::vector<touch_event_t> events;
+    touch_event_t e;
+    for (const Sample& s : samples) {
+        sampler.addSample(s.x, s.y, s.z, t);
+        t += 5;
+        while (sampler.getEvent(&e)) events.push_back(e);
+    }
+    TEST_ASSERT_EQUAL(0, sampler.overruns());
+    return events;
+}
+
+static std::vector<Sample> press(uint16_t x, uint16_t y, int n, uint16_t z = 1200) {
+    return std::vector<Sample>(n, Sample{x, y, z});
+}
+
+static void test_idle_and_bounces_make_no_events() {
+    TFT_eSPI_TouchSampler sampler;
+    sampler.setThreshold(threshold);
+    uint32_t t = 0;
+    std::vector<Sample> noise;
+    for (int i = 0; i < 50; i++)
+        noise.push_back({uint16_t(i * 80), uint16_t(4000 - i * 80), uint16_t(i % 7 * 60)});
+    // Over the threshold for less than the settle period and the median window
+    for (int i = 0; i < 4; i++) {
+        noise.push_back({2000, 2000, 900});
+        noise.push_back({2000, 2000, 0});
+    }
+    TEST_ASSERT_EQUAL(0, feed(sampler, noise, t).size());
+    TEST_ASSERT_FALSE(sampler.isPressed());
+    TEST_ASSERT_FALSE(sampler.isActive());
+}
+
+static void test_press_filters_a_spike() {
+    TFT_eSPI_TouchSampler sampler;
+    sampler.setThreshold(threshold);
+    uint32_t t = 1000;
+    std::vector<Sample> samples = {
+        {3900, 100, 700},  // Settling, position not used
+        {3900, 100, 900},
+        {1000, 2000, 1200},
+        {3950, 50, 1200},  // Spike
+        {1004, 1996, 1200},
+    };
+    std::vector<touch_event_t> events = feed(sampler, samples, t);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(TOUCH_EVENT_DOWN, events[0].type);
+    TEST_ASSERT_EQUAL(1004, events[0].x);
+    TEST_ASSERT_EQUAL(1996, events[0].y);
+    TEST_ASSERT_EQUAL(1020, events[0].time);
+
+    // Noise inside the deadband makes no move
+    events = feed(sampler, {{1006, 1994, 1200}, {1001, 2001, 1200}, {1003, 1998, 1200}}, t);
+    TEST_ASSERT_EQUAL(0, events.size());
+    uint16_t x, y;
+    TEST_ASSERT_TRUE(sampler.getPosition(&x, &y));
+    TEST_ASSERT_UINT16_WITHIN(8, 1002, x);
+    TEST_ASSERT_UINT16_WITHIN(8, 1998, y);
+}
+
+static void test_drag_moves_in_order() {
+    TFT_eSPI_TouchSampler sampler;
+    sampler.setThreshold(threshold);
+    uint32_t t = 0;
+    std::vector<Sample> samples = press(500, 1500, 5);
+    for (int i = 1; i <= 40; i++) samples.push_back({uint16_t(500 + i * 60), 1500, 1200});
+    std::vector<touch_event_t> events = feed(sampler, samples, t);
+
+    TEST_ASSERT_EQUAL(TOUCH_EVENT_DOWN, events[0].type);
+    TEST_ASSERT_GREATER_THAN(10, events.size());
+    for (size_t i = 1; i < events.size(); i++) {
+        TEST_ASSERT_EQUAL(TOUCH_EVENT_MOVE, events[i].type);
+        TEST_ASSERT_GREATER_OR_EQUAL(events[i - 1].x + TOUCH_MOVE_DEADBAND, events[i].x);
+        TEST_ASSERT_GREATER_THAN(events[i - 1].time, events[i].time);
+        TEST_ASSERT_EQUAL(1500, events[i].y);
+    }
+    // The filter lags the finger, but not by more than a few samples
+    TEST_ASSERT_UINT16_WITHIN(4 * 60, 500 + 40 * 60, events.back().x);
+}
+
+static void test_sag_and_dropout_do_not_release() {
+    TFT_eSPI_TouchSampler sampler;
+    sampler.setThreshold(threshold);
+    uint32_t t = 0;
+    TEST_ASSERT_EQUAL(1, feed(sampler, press(2000, 2000, 5), t).size());
+
+    // Under the threshold but over half of it, then a single sample at 0
+    std::vector<Sample> samples = press(2000, 2000, 10, 350);
+    samples.push_back({0, 0, 0});
+    samples.push_back({2000, 2000, 1100});
+    TEST_ASSERT_EQUAL(0, feed(sampler, samples, t).size());
+    TEST_ASSERT_TRUE(sampler.isPressed());
+
+    // Two samples under half the threshold end it, at the last position
+    std::vector<touch_event_t> events = feed(sampler, {{0, 0, 250}, {0, 0, 0}}, t);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(TOUCH_EVENT_UP, events[0].type);
+    TEST_ASSERT_EQUAL(2000, events[0].x);
+    TEST_ASSERT_EQUAL(2000, events[0].y);
+    TEST_ASSERT_FALSE(sampler.isPressed());
+    uint16_t x, y;
+    TEST_ASSERT_FALSE(sampler.getPosition(&x, &y));
+}
+
+static void test_full_queue_drops_and_counts() {
+    TFT_eSPI_TouchSampler sampler;
+    sampler.setThreshold(threshold);
+    uint32_t t = 0;
+    // Ten taps without reading the queue: 20 events into TOUCH_EVENT_QUEUE - 1 places
+    for (int i = 0; i < 10; i++) {
+        std::vector<Sample> tap = press(100 + i * 300, 100, 5);
+        tap.push_back({0, 0, 0});
+        tap.push_back({0, 0, 0});
+        for (const Sample& s : tap) {
+            sampler.addSample(s.x, s.y, s.z, t);
+            t += 5;
+        }
+    }
+    TEST_ASSERT_EQUAL(TOUCH_EVENT_QUEUE - 1, sampler.eventsAvailable());
+    TEST_ASSERT_EQUAL(20 - (TOUCH_EVENT_QUEUE - 1), sampler.overruns());
+
+    // The oldest events are kept, in order
+    touch_event_t e;
+    for (int i = 0; i < TOUCH_EVENT_QUEUE - 1; i++) {
+        TEST_ASSERT_TRUE(sampler.getEvent(&e));
+        TEST_ASSERT_EQUAL(i % 2 ? TOUCH_EVENT_UP : TOUCH_EVENT_DOWN, e.type);
+        TEST_ASSERT_EQUAL(100 + i / 2 * 300, e.x);
+    }
+    TEST_ASSERT_FALSE(sampler.getEvent(&e));
+    TEST_ASSERT_EQUAL(0, sampler.eventsAvailable());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_and_bounces_make_no_events);
+    RUN_TEST(test_press_filters_a_spike);
+    RUN_TEST(test_drag_moves_in_order);
+    RUN_TEST(test_sag_and_dropout_do_not_release);
+    RUN_TEST(test_full_queue_drops_and_counts);
+    return UNITY_END();
+}
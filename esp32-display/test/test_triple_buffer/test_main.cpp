@@ -0,0 +1,117 @@
+// TripleBuffer between two host threads, standing in for the network and display
+// tasks: every snapshot the reader takes is whole, they only move forward, read()
+// holds still while the writer keeps publishing, and the last one always gets through
+#include <triple_buffer.h>
+#include <unity.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+
+void setUp() {}
+void tearDown() {}
+
+// About the size of the display model, written a word at a time so a torn copy shows
+struct Snapshot {
+    static const int words = 64;
+    uint32_t seq;
+    uint32_t data[words];
+
+    void fill(uint32_t n) {
+        seq = n;
+        for (int i = 0; i < words; i++) data[i] = n * 2654435761u + i;
+    }
+    bool whole() const {
+        for (int i = 0; i < words; i++)
+            if (data[i] != seq * 2654435761u + i) return false;
+        return true;
+    }
+};
+
+static void test_reader_takes_only_the_latest() {
+    TripleBuffer<Snapshot> buffer;
+    TEST_ASSERT_FALSE(buffer.update());
+
+    for (uint32_t n = 1; n <= 3; n++) {
+        buffer.write().fill(n);
+        buffer.publish();
+    }
+    TEST_ASSERT_TRUE(buffer.update());
+    TEST_ASSERT_EQUAL(3, buffer.read().seq);
+    TEST_ASSERT_FALSE(buffer.update());
+    TEST_ASSERT_EQUAL(3, buffer.read().seq);
+
+    // The writer never gets the reader's buffer back
+    for (uint32_t n = 4; n <= 10; n++) {
+        TEST_ASSERT_NOT_EQUAL(&buffer.read(), &buffer.write());
+        buffer.write().fill(n);
+        buffer.publish();
+    }
+    TEST_ASSERT_EQUAL(3, buffer.read().seq);
+    TEST_ASSERT_TRUE(buffer.update());
+    TEST_ASSERT_EQUAL(10, buffer.read().seq);
+}
+
+// Runs until the reader has taken enough snapshots to have met the writer at every
+// point of a publish. Both yield now and then like tasks do, so the two interleave on
+// a single core too.
+static void test_threads() {
+    const uint32_t wanted = 20000;
+    TripleBuffer<Snapshot> buffer;
+    std::atomic<bool> stop{false};
+    uint32_t published = 0;
+
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            buffer.write().fill(++published);
+            buffer.publish();
+            if (published % 16 == 0) std::this_thread::yield();
+        }
+        // One more after the reader is done looking
+        buffer.write().fill(++published);
+        buffer.publish();
+    });
+
+    uint32_t taken = 0, torn = 0, backwards = 0, moved = 0, last = 0;
+    while (taken < wanted) {
+        if (!buffer.update()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const Snapshot& s = buffer.read();
+        taken++;
+        torn += !s.whole();
+        backwards += s.seq <= last;
+        last = s.seq;
+        // Still the same while the writer goes on publishing
+        for (int spin = 0; spin < 16; spin++) {
+            if (spin % 4 == 0) std::this_thread::yield();
+            moved += s.seq != last || !s.whole();
+        }
+    }
+    stop = true;
+    writer.join();
+
+    // The last snapshot published is the one the reader gets next
+    TEST_ASSERT_TRUE(buffer.update());
+    TEST_ASSERT_EQUAL(published, buffer.read().seq);
+    TEST_ASSERT_TRUE(buffer.read().whole());
+    TEST_ASSERT_FALSE(buffer.update());
+
+    TEST_ASSERT_EQUAL(0, torn);
+    TEST_ASSERT_EQUAL(0, backwards);
+    TEST_ASSERT_EQUAL(0, moved);
+
+    char message[120];
+    snprintf(message, sizeof(message), "%u snapshots published, %u taken by the reader",
+             published, taken);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_reader_takes_only_the_latest);
+    RUN_TEST(test_threads);
+    return UNITY_END();
+}